@@ -0,0 +1,52 @@
+#ifndef HQC_DISPATCH_API_H
+#define HQC_DISPATCH_API_H
+
+#ifndef DISPATCH_SECURITY_LEVEL
+  #define DISPATCH_SECURITY_LEVEL 128
+#endif
+
+// Both backends implement the same (salted ciphertext) revision of HQC, so the
+// sizes below and the wire format don't depend on which one is selected.
+#if DISPATCH_SECURITY_LEVEL == 128
+  #define CRYPTO_ALGNAME "HQC-128-dispatch"
+  #define DISPATCH_NAMESPACE(s) hqc128_dispatch##s
+  #define CRYPTO_SECRETKEYBYTES 2289
+  #define CRYPTO_PUBLICKEYBYTES 2249
+  #define CRYPTO_CIPHERTEXTBYTES 4497
+  #define CRYPTO_BYTES 64
+#elif DISPATCH_SECURITY_LEVEL == 192
+  #define CRYPTO_ALGNAME "HQC-192-dispatch"
+  #define DISPATCH_NAMESPACE(s) hqc192_dispatch##s
+  #define CRYPTO_SECRETKEYBYTES 4562
+  #define CRYPTO_PUBLICKEYBYTES 4522
+  #define CRYPTO_CIPHERTEXTBYTES 9042
+  #define CRYPTO_BYTES 64
+#elif DISPATCH_SECURITY_LEVEL == 256
+  #define CRYPTO_ALGNAME "HQC-256-dispatch"
+  #define DISPATCH_NAMESPACE(s) hqc256_dispatch##s
+  #define CRYPTO_SECRETKEYBYTES 7285
+  #define CRYPTO_PUBLICKEYBYTES 7245
+  #define CRYPTO_CIPHERTEXTBYTES 14485
+  #define CRYPTO_BYTES 64
+#else
+  #error "Unsupported DISPATCH_SECURITY_LEVEL (use 128, 192, or 256)"
+#endif
+
+// Secret and public key seeds, the compact form of a secret key
+#define CRYPTO_KEYPAIRCOINBYTES 80
+
+// Name of the backend selected at load time ("avx2" or "portable")
+#define CRYPTO_BACKEND crypto_kem_backend
+
+#define crypto_kem_backend DISPATCH_NAMESPACE(_backend)
+const char* crypto_kem_backend(void);
+#define crypto_kem_keypair DISPATCH_NAMESPACE(_keypair)
+int crypto_kem_keypair(unsigned char* pk, unsigned char* sk);
+#define crypto_kem_keypair_derand DISPATCH_NAMESPACE(_keypair_derand)
+int crypto_kem_keypair_derand(unsigned char* pk, unsigned char* sk, const unsigned char* seeds);
+#define crypto_kem_enc DISPATCH_NAMESPACE(_enc)
+int crypto_kem_enc(unsigned char* ct, unsigned char* ss, const unsigned char* pk);
+#define crypto_kem_dec DISPATCH_NAMESPACE(_dec)
+int crypto_kem_dec(unsigned char* ss, const unsigned char* ct, const unsigned char* sk);
+
+#endif
@@ -0,0 +1,98 @@
+#include "api.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Symbols exported by the Optimized_Implementation (avx2) and Additional_Implementation (portable) builds */
+#define BACKEND_(level, impl, s) hqc##level##_##impl##s
+#define BACKEND(level, impl, s) BACKEND_(level, impl, s)
+
+#define BACKEND_DECLARE(impl) \
+    int BACKEND(DISPATCH_SECURITY_LEVEL, impl, _keypair)(unsigned char *pk, unsigned char *sk); \
+    int BACKEND(DISPATCH_SECURITY_LEVEL, impl, _keypair_derand)(unsigned char *pk, unsigned char *sk, const unsigned char *seeds); \
+    int BACKEND(DISPATCH_SECURITY_LEVEL, impl, _enc)(unsigned char *ct, unsigned char *ss, const unsigned char *pk); \
+    int BACKEND(DISPATCH_SECURITY_LEVEL, impl, _dec)(unsigned char *ss, const unsigned char *ct, const unsigned char *sk);
+
+BACKEND_DECLARE(avx2)
+BACKEND_DECLARE(portable)
+
+typedef struct {
+    const char *name;
+    int (*supported)(void);
+    int (*keypair)(unsigned char *pk, unsigned char *sk);
+    int (*keypair_derand)(unsigned char *pk, unsigned char *sk, const unsigned char *seeds);
+    int (*enc)(unsigned char *ct, unsigned char *ss, const unsigned char *pk);
+    int (*dec)(unsigned char *ss, const unsigned char *ct, const unsigned char *sk);
+} backend_t;
+
+/* The avx2 build is compiled with -mavx -mavx2 -mbmi -mpclmul */
+static int supports_avx2(void)
+{
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi") && __builtin_cpu_supports("pclmul");
+}
+
+static int supports_all(void)
+{
+    return 1;
+}
+
+/* Fastest first, the last entry must run everywhere */
+static const backend_t backends[] = {
+    { "avx2", supports_avx2,
+      BACKEND(DISPATCH_SECURITY_LEVEL, avx2, _keypair),
+      BACKEND(DISPATCH_SECURITY_LEVEL, avx2, _keypair_derand),
+      BACKEND(DISPATCH_SECURITY_LEVEL, avx2, _enc),
+      BACKEND(DISPATCH_SECURITY_LEVEL, avx2, _dec) },
+    { "portable", supports_all,
+      BACKEND(DISPATCH_SECURITY_LEVEL, portable, _keypair),
+      BACKEND(DISPATCH_SECURITY_LEVEL, portable, _keypair_derand),
+      BACKEND(DISPATCH_SECURITY_LEVEL, portable, _enc),
+      BACKEND(DISPATCH_SECURITY_LEVEL, portable, _dec) },
+};
+
+#define BACKENDS_LEN (sizeof(backends) / sizeof(*backends))
+
+static const backend_t *selected = &backends[BACKENDS_LEN - 1];
+
+/* Pick the fastest supported backend at load time. KEM_BACKEND=<name> in the
+ * environment forces a specific one (if the CPU supports it), which is how the
+ * portable path is benchmarked on machines that have AVX2. Unknown or
+ * unsupported names fall back to the last (portable) entry. */
+__attribute__((constructor)) static void select_backend(void)
+{
+    const char *forced = getenv("KEM_BACKEND");
+
+    __builtin_cpu_init();
+    for (size_t i = 0; i < BACKENDS_LEN; i++) {
+        if (!backends[i].supported())
+            continue;
+        if (forced != NULL && strcmp(forced, backends[i].name) != 0)
+            continue;
+        selected = &backends[i];
+        return;
+    }
+}
+
+const char* crypto_kem_backend(void)
+{
+    return selected->name;
+}
+
+int crypto_kem_keypair(unsigned char *pk, unsigned char *sk)
+{
+    return selected->keypair(pk, sk);
+}
+
+int crypto_kem_keypair_derand(unsigned char *pk, unsigned char *sk, const unsigned char *seeds)
+{
+    return selected->keypair_derand(pk, sk, seeds);
+}
+
+int crypto_kem_enc(unsigned char *ct, unsigned char *ss, const unsigned char *pk)
+{
+    return selected->enc(ct, ss, pk);
+}
+
+int crypto_kem_dec(unsigned char *ss, const unsigned char *ct, const unsigned char *sk)
+{
+    return selected->dec(ss, ct, sk);
+}
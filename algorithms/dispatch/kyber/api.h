@@ -0,0 +1,50 @@
+#ifndef KYBER_DISPATCH_API_H
+#define KYBER_DISPATCH_API_H
+
+#ifndef DISPATCH_SECURITY_LEVEL
+  #define DISPATCH_SECURITY_LEVEL 768
+#endif
+
+#if DISPATCH_SECURITY_LEVEL == 512
+  #define CRYPTO_ALGNAME "Kyber512-dispatch"
+  #define DISPATCH_NAMESPACE(s) kyber512_dispatch##s
+  #define CRYPTO_SECRETKEYBYTES 1632
+  #define CRYPTO_PUBLICKEYBYTES 800
+  #define CRYPTO_CIPHERTEXTBYTES 768
+  #define CRYPTO_BYTES 32
+#elif DISPATCH_SECURITY_LEVEL == 768
+  #define CRYPTO_ALGNAME "Kyber768-dispatch"
+  #define DISPATCH_NAMESPACE(s) kyber768_dispatch##s
+  #define CRYPTO_SECRETKEYBYTES 2400
+  #define CRYPTO_PUBLICKEYBYTES 1184
+  #define CRYPTO_CIPHERTEXTBYTES 1088
+  #define CRYPTO_BYTES 32
+#elif DISPATCH_SECURITY_LEVEL == 1024
+  #define CRYPTO_ALGNAME "Kyber1024-dispatch"
+  #define DISPATCH_NAMESPACE(s) kyber1024_dispatch##s
+  #define CRYPTO_SECRETKEYBYTES 3168
+  #define CRYPTO_PUBLICKEYBYTES 1568
+  #define CRYPTO_CIPHERTEXTBYTES 1568
+  #define CRYPTO_BYTES 32
+#else
+  #error "Unsupported DISPATCH_SECURITY_LEVEL (use 512, 768, or 1024)"
+#endif
+
+// Keygen coins d || z, the compact form of a secret key (same for every backend)
+#define CRYPTO_KEYPAIRCOINBYTES 64
+
+// Name of the backend selected at load time ("avx2" or "ref")
+#define CRYPTO_BACKEND crypto_kem_backend
+
+#define crypto_kem_backend DISPATCH_NAMESPACE(_backend)
+const char* crypto_kem_backend(void);
+#define crypto_kem_keypair DISPATCH_NAMESPACE(_keypair)
+int crypto_kem_keypair(unsigned char* pk, unsigned char* sk);
+#define crypto_kem_keypair_derand DISPATCH_NAMESPACE(_keypair_derand)
+int crypto_kem_keypair_derand(unsigned char* pk, unsigned char* sk, const unsigned char* coins);
+#define crypto_kem_enc DISPATCH_NAMESPACE(_enc)
+int crypto_kem_enc(unsigned char* ct, unsigned char* ss, const unsigned char* pk);
+#define crypto_kem_dec DISPATCH_NAMESPACE(_dec)
+int crypto_kem_dec(unsigned char* ss, const unsigned char* ct, const unsigned char* sk);
+
+#endif
@@ -1,78 +1,204 @@
 #include "api.h"
-#include <openssl/ec.h>
+#include <openssl/bn.h>
+#include <openssl/core_names.h>
+#include <openssl/crypto.h>
 #include <openssl/evp.h>
-#include <openssl/rand.h>
+#include <openssl/param_build.h>
 #include <string.h>
 #include <stdlib.h>
 
+/*
+ * Per-thread OpenSSL objects that a TLS stack would also keep around: the
+ * keygen context and a parameters-only key for the curve (so the group is set
+ * up once), the import context for private keys, and the last private key we
+ * decapsulated with, together with its derive context. Peer public keys are not
+ * cached: a server sees a new one per handshake, so every encapsulation decodes
+ * and validates its point. They are never freed, which is at most one set per thread.
+ */
+typedef struct {
+    EVP_PKEY_CTX *keygen;
+    EVP_PKEY *group;
+    EVP_PKEY_CTX *import;
+
+    unsigned char sk[CRYPTO_SECRETKEYBYTES];
+    EVP_PKEY *priv;
+    EVP_PKEY_CTX *derive;
+} ecdh_cache_t;
+
+static __thread ecdh_cache_t cache;
+
+/* Set up the curve, keygen and import contexts on first use */
+static int cache_init(void)
+{
+    if (cache.keygen != NULL)
+        return 0;
+
+    EVP_PKEY_CTX *keygen = EVP_PKEY_CTX_new_from_name(NULL, "EC", NULL);
+    EVP_PKEY_CTX *import = EVP_PKEY_CTX_new_from_name(NULL, "EC", NULL);
+    EVP_PKEY *group = NULL;
+    if (keygen == NULL || import == NULL
+        || EVP_PKEY_paramgen_init(keygen) <= 0
+        || EVP_PKEY_CTX_set_group_name(keygen, CURVE_NAME) <= 0
+        || EVP_PKEY_paramgen(keygen, &group) <= 0
+        || EVP_PKEY_keygen_init(keygen) <= 0
+        || EVP_PKEY_CTX_set_group_name(keygen, CURVE_NAME) <= 0
+        || EVP_PKEY_fromdata_init(import) <= 0) {
+        EVP_PKEY_CTX_free(keygen);
+        EVP_PKEY_CTX_free(import);
+        EVP_PKEY_free(group);
+        return -1;
+    }
+
+    cache.keygen = keygen;
+    cache.group = group;
+    cache.import = import;
+    return 0;
+}
+
+/* Make pkey the cached private key, with a derive context bound to it */
+static int cache_set_private(EVP_PKEY *pkey, const unsigned char *sk)
+{
+    EVP_PKEY_CTX *derive = EVP_PKEY_CTX_new_from_pkey(NULL, pkey, NULL);
+    if (derive == NULL || EVP_PKEY_derive_init(derive) <= 0) {
+        EVP_PKEY_CTX_free(derive);
+        EVP_PKEY_free(pkey);
+        return -1;
+    }
+
+    EVP_PKEY_CTX_free(cache.derive);
+    EVP_PKEY_free(cache.priv);
+    cache.derive = derive;
+    cache.priv = pkey;
+    memcpy(cache.sk, sk, CRYPTO_SECRETKEYBYTES);
+    return 0;
+}
+
+/*
+ * Import an uncompressed public point (this checks that it is on the curve).
+ * Copying the cached curve is several times cheaper than EVP_PKEY_fromdata,
+ * which looks the group up by name again.
+ */
+static EVP_PKEY *import_public(const unsigned char *pk)
+{
+    EVP_PKEY *pkey = EVP_PKEY_dup(cache.group);
+
+    if (pkey == NULL || EVP_PKEY_set1_encoded_public_key(pkey, pk, CRYPTO_PUBLICKEYBYTES) <= 0) {
+        EVP_PKEY_free(pkey);
+        return NULL;
+    }
+    return pkey;
+}
+
+/* Import a big-endian private scalar */
+static EVP_PKEY *import_private(const unsigned char *sk)
+{
+    EVP_PKEY *pkey = NULL;
+    OSSL_PARAM_BLD *bld = OSSL_PARAM_BLD_new();
+    BIGNUM *priv = BN_bin2bn(sk, CRYPTO_SECRETKEYBYTES, NULL);
+    OSSL_PARAM *params = NULL;
+
+    if (bld != NULL && priv != NULL
+        && OSSL_PARAM_BLD_push_utf8_string(bld, OSSL_PKEY_PARAM_GROUP_NAME, CURVE_NAME, 0)
+        && OSSL_PARAM_BLD_push_BN(bld, OSSL_PKEY_PARAM_PRIV_KEY, priv)
+        && (params = OSSL_PARAM_BLD_to_param(bld)) != NULL)
+        EVP_PKEY_fromdata(cache.import, &pkey, EVP_PKEY_KEYPAIR, params);
+
+    OSSL_PARAM_free(params);
+    OSSL_PARAM_BLD_free(bld);
+    BN_clear_free(priv);
+    return pkey;
+}
+
+/* Derive into ss, truncating the x-coordinate to CRYPTO_BYTES like ECDH_compute_key did */
+static int derive(EVP_PKEY_CTX *ctx, EVP_PKEY *peer, unsigned char *ss)
+{
+    unsigned char secret[CRYPTO_SECRETKEYBYTES];
+    size_t secret_len = sizeof(secret);
+
+    /* Peers come from import_public, which already rejected points off the curve */
+    if (EVP_PKEY_derive_set_peer_ex(ctx, peer, 0) <= 0
+        || EVP_PKEY_derive(ctx, secret, &secret_len) <= 0)
+        return -1;
+
+    memcpy(ss, secret, CRYPTO_BYTES);
+    OPENSSL_cleanse(secret, sizeof(secret));
+    return 0;
+}
+
 /* Generate keypair */
 int crypto_kem_keypair(unsigned char *pk, unsigned char *sk)
 {
-    /* Generate keypair */
-    EC_GROUP *group = EC_GROUP_new_by_curve_name(CURVE_NAME);
-    EC_KEY *keypair = EC_KEY_new();
-    EC_KEY_set_group(keypair, group);
-    EC_KEY_generate_key(keypair);
+    EVP_PKEY *keypair = NULL;
+    BIGNUM *priv = NULL;
+    size_t pk_len;
 
-    /* Export public key to buffer */
-    EC_POINT *pub = EC_KEY_get0_public_key(keypair);
-    EC_POINT_point2oct(group, pub, POINT_CONVERSION_UNCOMPRESSED, pk, CRYPTO_PUBLICKEYBYTES, NULL);
+    if (cache_init() != 0 || EVP_PKEY_keygen(cache.keygen, &keypair) <= 0)
+        return -1;
 
-    /* Export private key to buffer */
-    BIGNUM *priv = EC_KEY_get0_private_key(keypair);
-    BN_bn2binpad(priv, sk, CRYPTO_SECRETKEYBYTES);
+    /* Export public key (uncompressed) and private key to buffers */
+    if (EVP_PKEY_get_octet_string_param(keypair, OSSL_PKEY_PARAM_PUB_KEY, pk, CRYPTO_PUBLICKEYBYTES, &pk_len) <= 0
+        || EVP_PKEY_get_bn_param(keypair, OSSL_PKEY_PARAM_PRIV_KEY, &priv) <= 0
+        || BN_bn2binpad(priv, sk, CRYPTO_SECRETKEYBYTES) < 0) {
+        BN_clear_free(priv);
+        EVP_PKEY_free(keypair);
+        return -1;
+    }
+    BN_clear_free(priv);
 
-    EC_KEY_free(keypair);
-    return 0;
+    /* The owner of a fresh keypair is the one who decapsulates with it next */
+    return cache_set_private(keypair, sk);
 }
 
 /* Encapsulate */
 int crypto_kem_enc(unsigned char *ct, unsigned char *ss, const unsigned char *pk)
 {
-    /* Generate ephemeral keypair */
-    EC_GROUP *group = EC_GROUP_new_by_curve_name(CURVE_NAME);
-    EC_KEY *eph_keypair = EC_KEY_new();
-    EC_KEY_set_group(eph_keypair, group);
-    EC_KEY_generate_key(eph_keypair);
+    EVP_PKEY *eph_keypair = NULL;
+    EVP_PKEY_CTX *ctx = NULL;
+    size_t ct_len;
+    int result = -1;
 
-    /* Import peer public key */
-    EC_POINT *peer_pub = EC_POINT_new(group);
-    EC_POINT_oct2point(group, peer_pub, pk, CRYPTO_PUBLICKEYBYTES, NULL);
+    if (cache_init() != 0)
+        return -1;
 
-    /* Compute shared secret from the ephemeral private key and the peer's public key */
-    ECDH_compute_key(ss, CRYPTO_BYTES, peer_pub, eph_keypair, NULL);
+    /* Import peer public key */
+    EVP_PKEY *peer = import_public(pk);
+    if (peer == NULL)
+        return -1;
 
-    /* Export ephemeral public key to buffer to be sent to peer */
-    EC_POINT *eph_pub = EC_KEY_get0_public_key(eph_keypair);
-    EC_POINT_point2oct(group, eph_pub, POINT_CONVERSION_UNCOMPRESSED, ct, CRYPTO_CIPHERTEXTBYTES, NULL);
+    /* Generate ephemeral keypair and compute the shared secret with the peer's public key */
+    if (EVP_PKEY_keygen(cache.keygen, &eph_keypair) > 0
+        && (ctx = EVP_PKEY_CTX_new_from_pkey(NULL, eph_keypair, NULL)) != NULL
+        && EVP_PKEY_derive_init(ctx) > 0
+        && derive(ctx, peer, ss) == 0
+        /* Export ephemeral public key to buffer to be sent to peer */
+        && EVP_PKEY_get_octet_string_param(eph_keypair, OSSL_PKEY_PARAM_PUB_KEY, ct, CRYPTO_CIPHERTEXTBYTES, &ct_len) > 0)
+        result = 0;
 
-    EC_POINT_free(peer_pub);
-    EC_KEY_free(eph_keypair);
-    EC_GROUP_free(group);
-    return 0;
+    EVP_PKEY_CTX_free(ctx);
+    EVP_PKEY_free(eph_keypair);
+    EVP_PKEY_free(peer);
+    return result;
 }
 
 /* Decapsulate */
 int crypto_kem_dec(unsigned char *ss, const unsigned char *ct, const unsigned char *sk)
 {
-    /* Import private key from buffer */
-    EC_GROUP *group = EC_GROUP_new_by_curve_name(CURVE_NAME);
-    EC_KEY *keypair = EC_KEY_new();
-    EC_KEY_set_group(keypair, group);
+    if (cache_init() != 0)
+        return -1;
 
-    BIGNUM *priv = BN_bin2bn(sk, CRYPTO_SECRETKEYBYTES, NULL);
-    EC_KEY_set_private_key(keypair, priv);
+    /* Import private key from buffer, unless it is the one we used last time */
+    if (cache.priv == NULL || CRYPTO_memcmp(cache.sk, sk, CRYPTO_SECRETKEYBYTES) != 0) {
+        EVP_PKEY *priv = import_private(sk);
+        if (priv == NULL || cache_set_private(priv, sk) != 0)
+            return -1;
+    }
 
-    /* Import peer public key */
-    EC_POINT *peer_pub = EC_POINT_new(group);
-    EC_POINT_oct2point(group, peer_pub, ct, CRYPTO_CIPHERTEXTBYTES, NULL);
-
-    /* Compute shared secret from private key and peer's public key */
-    ECDH_compute_key(ss, CRYPTO_BYTES, peer_pub, keypair, NULL);
+    /* Import peer public key and compute the shared secret with the cached derive context */
+    EVP_PKEY *peer = import_public(ct);
+    if (peer == NULL)
+        return -1;
 
-    EC_POINT_free(peer_pub);
-    EC_KEY_free(keypair);
-    EC_GROUP_free(group);
-    BN_free(priv);
-    return 0;
-}
\ No newline at end of file
+    int result = derive(cache.derive, peer, ss);
+    EVP_PKEY_free(peer);
+    return result;
+}
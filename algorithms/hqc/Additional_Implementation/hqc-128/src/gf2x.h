@@ -7,7 +7,9 @@
  */
 
 #include <stdint.h>
+#include "parameters.h"
 
+#define vect_mul HQC_NAMESPACE(_vect_mul)
 void vect_mul(uint64_t *o, const uint64_t *v1, const uint64_t *v2);
 
 #endif
@@ -24,24 +24,24 @@
  * The secret key is composed of the <b>seed</b> used to generate vectors <b>x</b> and  <b>y</b>.
  * As a technicality, the public key is appended to the secret key in order to respect NIST API.
  *
+ * Both seeds are taken from seeds (sk_seed || pk_seed), so the keys are a deterministic function of them.
+ *
  * @param[out] pk String containing the public key
  * @param[out] sk String containing the secret key
+ * @param[in] seeds String containing the secret key seed and the public key seed
  */
-void hqc_pke_keygen(unsigned char* pk, unsigned char* sk) {
+void hqc_pke_keygen(unsigned char* pk, unsigned char* sk, const uint8_t* seeds) {
     seedexpander_state sk_seedexpander;
     seedexpander_state pk_seedexpander;
-    uint8_t sk_seed[SEED_BYTES] = {0};
-    uint8_t pk_seed[SEED_BYTES] = {0};
+    const uint8_t* sk_seed = seeds;
+    const uint8_t* pk_seed = seeds + SEED_BYTES;
     uint64_t x[VEC_N_SIZE_64] = {0};
     uint64_t y[VEC_N_SIZE_64] = {0};
     uint64_t h[VEC_N_SIZE_64] = {0};
     uint64_t s[VEC_N_SIZE_64] = {0};
 
     // Create seed_expanders for public key and secret key
-    shake_prng(sk_seed, SEED_BYTES);
     seedexpander_init(&sk_seedexpander, sk_seed, SEED_BYTES);
-
-    shake_prng(pk_seed, SEED_BYTES);
     seedexpander_init(&pk_seedexpander, pk_seed, SEED_BYTES);
 
     // Compute secret key
@@ -11,10 +11,10 @@
 #include <stdio.h>
 
 
-void base_mul(uint64_t *c, uint64_t a, uint64_t b);
-void karatsuba_add2(uint64_t *o, uint64_t *tmp1, uint64_t* tmp2, uint64_t size_l, uint64_t size_h);
-void karatsuba_add1(uint64_t *alh, uint64_t *blh, const uint64_t *a, const uint64_t *b, uint64_t size_l, uint64_t size_h);
-void karatsuba(uint64_t *o, const uint64_t *a, const uint64_t *b, uint64_t size, uint64_t *stack);
+static void base_mul(uint64_t *c, uint64_t a, uint64_t b);
+static void karatsuba_add2(uint64_t *o, uint64_t *tmp1, uint64_t* tmp2, uint64_t size_l, uint64_t size_h);
+static void karatsuba_add1(uint64_t *alh, uint64_t *blh, const uint64_t *a, const uint64_t *b, uint64_t size_l, uint64_t size_h);
+static void karatsuba(uint64_t *o, const uint64_t *a, const uint64_t *b, uint64_t size, uint64_t *stack);
 static void reduce(uint64_t *o, const uint64_t *a);
 
 
@@ -28,7 +28,7 @@ static void reduce(uint64_t *o, const uint64_t *a);
  * @param[in] a The first value a
  * @param[in] b The second value b
  */
-void base_mul(uint64_t *c, uint64_t a, uint64_t b) {
+static void base_mul(uint64_t *c, uint64_t a, uint64_t b) {
    uint64_t h = 0;
    uint64_t l = 0;
    uint64_t g;
@@ -101,7 +101,7 @@ void base_mul(uint64_t *c, uint64_t a, uint64_t b) {
 
 
 
-void karatsuba_add1(uint64_t *alh, uint64_t *blh, const uint64_t *a, const uint64_t *b, uint64_t size_l, uint64_t size_h) {
+static void karatsuba_add1(uint64_t *alh, uint64_t *blh, const uint64_t *a, const uint64_t *b, uint64_t size_l, uint64_t size_h) {
    for (uint64_t i = 0; i < size_h; i++) {
       alh[i] = a[i] ^ a[i + size_l];
       blh[i] = b[i] ^ b[i + size_l];
@@ -115,7 +115,7 @@ void karatsuba_add1(uint64_t *alh, uint64_t *blh, const uint64_t *a, const uint6
 
 
 
-void karatsuba_add2(uint64_t *o, uint64_t *tmp1, uint64_t* tmp2, uint64_t size_l, uint64_t size_h) {
+static void karatsuba_add2(uint64_t *o, uint64_t *tmp1, uint64_t* tmp2, uint64_t size_l, uint64_t size_h) {
    for (uint64_t i = 0; i < (2 * size_l) ; i++) {
       tmp1[i] = tmp1[i] ^ o[i];
    }
@@ -140,7 +140,7 @@ void karatsuba_add2(uint64_t *o, uint64_t *tmp1, uint64_t* tmp2, uint64_t size_l
  * \param[in] size Length of polynomial
  * \param[in] stack Length of polynomial
  */
-void karatsuba(uint64_t *o, const uint64_t *a, const uint64_t *b, uint64_t size, uint64_t *stack) {
+static void karatsuba(uint64_t *o, const uint64_t *a, const uint64_t *b, uint64_t size, uint64_t *stack) {
    uint64_t size_l, size_h;
    const uint64_t *ah, *bh;
 
@@ -7,9 +7,13 @@
  */
 
 #include <stdint.h>
+#include "parameters.h"
 
-void hqc_pke_keygen(unsigned char* pk, unsigned char* sk);
+#define hqc_pke_keygen HQC_NAMESPACE(_hqc_pke_keygen)
+void hqc_pke_keygen(unsigned char* pk, unsigned char* sk, const uint8_t* seeds);
+#define hqc_pke_encrypt HQC_NAMESPACE(_hqc_pke_encrypt)
 void hqc_pke_encrypt(uint64_t *u, uint64_t *v, const uint64_t *m, const unsigned char *theta, const unsigned char *pk);
+#define hqc_pke_decrypt HQC_NAMESPACE(_hqc_pke_decrypt)
 void hqc_pke_decrypt(uint64_t *m, const uint64_t *u, const uint64_t *v, const unsigned char *sk);
 
 #endif
\ No newline at end of file
@@ -8,6 +8,7 @@
 #include "parameters.h"
 #include "parsing.h"
 #include "shake_ds.h"
+#include "shake_prng.h"
 #include "fips202.h"
 #include "vector.h"
 #include <stdint.h>
@@ -30,11 +31,33 @@
  * @returns 0 if keygen is successful
  */
 int crypto_kem_keypair(unsigned char *pk, unsigned char *sk) {
+    uint8_t seeds[2 * SEED_BYTES];
+
+    // sk_seed, then pk_seed, drawn separately as before so the KATs are unchanged
+    shake_prng(seeds, SEED_BYTES);
+    shake_prng(seeds + SEED_BYTES, SEED_BYTES);
+    return crypto_kem_keypair_derand(pk, sk, seeds);
+}
+
+
+
+/**
+ * @brief Keygen of the HQC_KEM IND_CAA2 scheme from given seeds
+ *
+ * The keys only depend on the secret key seed and the public key seed, so those two seeds
+ * (CRYPTO_KEYPAIRCOINBYTES bytes) are a compact form of the secret key that this function expands again.
+ *
+ * @param[out] pk String containing the public key
+ * @param[out] sk String containing the secret key
+ * @param[in] seeds String containing sk_seed || pk_seed
+ * @returns 0 if keygen is successful
+ */
+int crypto_kem_keypair_derand(unsigned char *pk, unsigned char *sk, const unsigned char *seeds) {
     #ifdef VERBOSE
         printf("\n\n\n\n### KEYGEN ###");
     #endif
 
-    hqc_pke_keygen(pk, sk);
+    hqc_pke_keygen(pk, sk, seeds);
     return 0;
 }
 
@@ -59,13 +82,19 @@ int crypto_kem_enc(unsigned char *ct, unsigned char *ss, const unsigned char *pk
     uint64_t v[VEC_N1N2_SIZE_64] = {0};
     uint8_t d[SHAKE256_512_BYTES] = {0};
     uint8_t mc[VEC_K_SIZE_BYTES + VEC_N_SIZE_BYTES + VEC_N1N2_SIZE_BYTES] = {0};
+    uint64_t salt[SALT_SIZE_64] = {0};
+    uint8_t tmp[VEC_K_SIZE_BYTES + SEED_BYTES + SALT_SIZE_BYTES] = {0};
     shake256incctx shake256state;
 
     // Computing m
-    vect_set_random_from_prng(m);
+    vect_set_random_from_prng(m, VEC_K_SIZE_64);
 
     // Computing theta
-    shake256_512_ds(&shake256state, theta, (uint8_t*) m, VEC_K_SIZE_BYTES, G_FCT_DOMAIN);
+    vect_set_random_from_prng(salt, SALT_SIZE_64);
+    memcpy(tmp, m, VEC_K_SIZE_BYTES);
+    memcpy(tmp + VEC_K_SIZE_BYTES, pk, SEED_BYTES);
+    memcpy(tmp + VEC_K_SIZE_BYTES + SEED_BYTES, salt, SALT_SIZE_BYTES);
+    shake256_512_ds(&shake256state, theta, tmp, VEC_K_SIZE_BYTES + SEED_BYTES + SALT_SIZE_BYTES, G_FCT_DOMAIN);
 
     // Encrypting m
     hqc_pke_encrypt(u, v, m, theta, pk);
@@ -80,7 +109,7 @@ int crypto_kem_enc(unsigned char *ct, unsigned char *ss, const unsigned char *pk
     shake256_512_ds(&shake256state, ss, mc, VEC_K_SIZE_BYTES + VEC_N_SIZE_BYTES + VEC_N1N2_SIZE_BYTES, K_FCT_DOMAIN);
 
     // Computing ciphertext
-    hqc_ciphertext_to_string(ct, u, v, d);
+    hqc_ciphertext_to_string(ct, u, v, d, salt);
 
     #ifdef VERBOSE
         printf("\n\npk: "); for(int i = 0 ; i < PUBLIC_KEY_BYTES ; ++i) printf("%02x", pk[i]);
@@ -120,10 +149,12 @@ int crypto_kem_dec(unsigned char *ss, const unsigned char *ct, const unsigned ch
     uint64_t v2[VEC_N1N2_SIZE_64] = {0};
     uint8_t d2[SHAKE256_512_BYTES] = {0};
     uint8_t mc[VEC_K_SIZE_BYTES + VEC_N_SIZE_BYTES + VEC_N1N2_SIZE_BYTES] = {0};
+    uint64_t salt[SALT_SIZE_64] = {0};
+    uint8_t tmp[VEC_K_SIZE_BYTES + SEED_BYTES + SALT_SIZE_BYTES] = {0};
     shake256incctx shake256state;
 
     // Retrieving u, v and d from ciphertext
-    hqc_ciphertext_from_string(u, v , d, ct);
+    hqc_ciphertext_from_string(u, v , d, salt, ct);
 
     // Retrieving pk from sk
     memcpy(pk, sk + SEED_BYTES, PUBLIC_KEY_BYTES);
@@ -132,7 +163,10 @@ int crypto_kem_dec(unsigned char *ss, const unsigned char *ct, const unsigned ch
     hqc_pke_decrypt(m, u, v, sk);
 
     // Computing theta
-    shake256_512_ds(&shake256state, theta, (uint8_t*) m, VEC_K_SIZE_BYTES, G_FCT_DOMAIN);
+    memcpy(tmp, m, VEC_K_SIZE_BYTES);
+    memcpy(tmp + VEC_K_SIZE_BYTES, pk, SEED_BYTES);
+    memcpy(tmp + VEC_K_SIZE_BYTES + SEED_BYTES, salt, SALT_SIZE_BYTES);
+    shake256_512_ds(&shake256state, theta, tmp, VEC_K_SIZE_BYTES + SEED_BYTES + SALT_SIZE_BYTES, G_FCT_DOMAIN);
 
     // Encrypting m'
     hqc_pke_encrypt(u2, v2, m, theta, pk);
@@ -55,6 +55,8 @@
   #define RED_MASK                              A mask fot the higher bits of a vector
   #define SHAKE256_512_BYTES                    Define the size of SHAKE-256 output in bytes
   #define SEED_BYTES                            Define the size of the seed in bytes
+  #define SALT_SIZE_BYTES                       Define the size of a salt in bytes
+  #define SALT_SIZE_64                          Define the size of a salt in 64 bits words
 */
 
 #define PARAM_N                               35851
@@ -97,5 +99,7 @@
 #define RED_MASK                              BITMASK(PARAM_N, 64)
 #define SHAKE256_512_BYTES                    64
 #define SEED_BYTES                            40
+#define SALT_SIZE_BYTES                       16
+#define SALT_SIZE_64                          2
 
 #endif
\ No newline at end of file
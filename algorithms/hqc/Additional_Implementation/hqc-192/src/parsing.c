@@ -101,10 +101,11 @@ void hqc_public_key_from_string(uint64_t *h, uint64_t *s, const uint8_t *pk) {
  * @param[in] v uint8_t representation of vector v
  * @param[in] d String containing the hash d
  */
-void hqc_ciphertext_to_string(uint8_t *ct, const uint64_t *u, const uint64_t *v, const uint8_t *d) {
+void hqc_ciphertext_to_string(uint8_t *ct, const uint64_t *u, const uint64_t *v, const uint8_t *d, const uint64_t *salt) {
     memcpy(ct, u, VEC_N_SIZE_BYTES);
     memcpy(ct + VEC_N_SIZE_BYTES, v, VEC_N1N2_SIZE_BYTES);
     memcpy(ct + VEC_N_SIZE_BYTES + VEC_N1N2_SIZE_BYTES, d, SHAKE256_512_BYTES);
+    memcpy(ct + VEC_N_SIZE_BYTES + VEC_N1N2_SIZE_BYTES + SHAKE256_512_BYTES, salt, SALT_SIZE_BYTES);
 }
 
 
@@ -119,8 +120,9 @@ void hqc_ciphertext_to_string(uint8_t *ct, const uint64_t *u, const uint64_t *v,
  * @param[out] d String containing the hash d
  * @param[in] ct String containing the ciphertext
  */
-void hqc_ciphertext_from_string(uint64_t *u, uint64_t *v, uint8_t *d, const uint8_t *ct) {
+void hqc_ciphertext_from_string(uint64_t *u, uint64_t *v, uint8_t *d, uint64_t *salt, const uint8_t *ct) {
     memcpy(u, ct, VEC_N_SIZE_BYTES);
     memcpy(v, ct + VEC_N_SIZE_BYTES, VEC_N1N2_SIZE_BYTES);
     memcpy(d, ct + VEC_N_SIZE_BYTES + VEC_N1N2_SIZE_BYTES, SHAKE256_512_BYTES);
+    memcpy(salt, ct + VEC_N_SIZE_BYTES + VEC_N1N2_SIZE_BYTES + SHAKE256_512_BYTES, SALT_SIZE_BYTES);
 }
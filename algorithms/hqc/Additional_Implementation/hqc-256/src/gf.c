@@ -9,8 +9,8 @@
 #include <stdio.h>
 
 static uint16_t gf_reduce(uint64_t x, size_t deg_x);
-void gf_carryless_mul(uint8_t *c, uint8_t a, uint8_t b);
-uint16_t trailing_zero_bits_count(uint16_t a);
+static void gf_carryless_mul(uint8_t *c, uint8_t a, uint8_t b);
+static uint16_t trailing_zero_bits_count(uint16_t a);
 
 /**
  * @brief Generates exp and log lookup tables of GF(2^m).
@@ -50,7 +50,7 @@ void gf_generate(uint16_t *exp, uint16_t *log, const int16_t m) {
  * @returns The number of trailing zero bits in a.
  * @param[in] a An operand
  */
-uint16_t trailing_zero_bits_count(uint16_t a) {
+static uint16_t trailing_zero_bits_count(uint16_t a) {
     uint16_t tmp = 0;
     uint16_t mask = 0xFFFF;
     for (int i = 0; i < 14; ++i) {
@@ -109,7 +109,7 @@ static uint16_t gf_reduce(uint64_t x, size_t deg_x) {
  * @param[in] a The first polynomial
  * @param[in] b The second polynomial
  */
-void gf_carryless_mul(uint8_t *c, uint8_t a, uint8_t b) {
+static void gf_carryless_mul(uint8_t *c, uint8_t a, uint8_t b) {
   uint16_t       h = 0, l = 0, g, u[4];
   u[0] = 0;
   u[1] = b & ((1UL << 7) - 1UL);
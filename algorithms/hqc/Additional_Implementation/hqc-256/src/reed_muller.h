@@ -10,7 +10,9 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#define reed_muller_encode HQC_NAMESPACE(_reed_muller_encode)
 void reed_muller_encode(uint64_t* cdw, const uint64_t* msg);
+#define reed_muller_decode HQC_NAMESPACE(_reed_muller_decode)
 void reed_muller_decode(uint64_t* msg, const uint64_t* cdw);
 
 #endif
@@ -10,56 +10,54 @@
 #include <string.h>
 #include <stdio.h>
 
+static inline uint32_t compare_u32(const uint32_t v1, const uint32_t v2);
+
 
 /**
- * @brief Generates a vector of a given Hamming weight
+ * @brief Constant-time comparison of two integers v1 and v2
+ *
+ * Returns 1 if v1 is equal to v2 and 0 otherwise
+ * https://gist.github.com/sneves/10845247
  *
- * This function generates uniformly at random a binary vector of a Hamming weight equal to the parameter <b>weight</b>.
- * To generate the vector we have to sample uniformly at random values in the interval [0, PARAM_N -1]. Suppose the PARAM_N is equal to \f$ 70853 \f$, to select a position \f$ r\f$ the function works as follow:
- *  1. It makes a call to the seedexpander function to obtain a random number \f$ x\f$ in \f$ [0, 2^{24}[ \f$.
- *  2. Let \f$ t = \lfloor {2^{24} \over 70853} \rfloor \times  70853\f$
- *  3. If \f$ x \geq t\f$, go to 1
- *  4. It return \f$ r = x \mod 70853\f$
+ * @param[in] v1 
+ * @param[in] v2 
+ */
+static inline uint32_t compare_u32(const uint32_t v1, const uint32_t v2) {
+    return 1 ^ (((v1 - v2)|(v2 - v1)) >> 31);
+}
+
+
+
+/**
+ * @brief Generates a vector of a given Hamming weight
  *
- * The parameter \f$ t \f$ is precomputed and it's denoted by UTILS_REJECTION_THRESHOLD (see the file parameters.h).
+ * Implementation of Algorithm 5 in https://eprint.iacr.org/2021/1631.pdf
  *
+ * @param[in] ctx Pointer to the context of the seed expander
  * @param[in] v Pointer to an array
  * @param[in] weight Integer that is the Hamming weight
- * @param[in] ctx Pointer to the context of the seed expander
  */
 void vect_set_random_fixed_weight(seedexpander_state *ctx, uint64_t *v, uint16_t weight) {
+    uint32_t rand_u32[PARAM_OMEGA_R] = {0};
     uint32_t support[PARAM_OMEGA_R] = {0};
     uint32_t index_tab [PARAM_OMEGA_R] = {0};
     uint64_t bit_tab [PARAM_OMEGA_R] = {0};
-    size_t random_bytes_size = 3 * weight;
-    uint8_t rand_bytes[3 * PARAM_OMEGA_R] = {0}; // weight is expected to be <= PARAM_OMEGA_R
-    uint8_t inc;
-    size_t i, j;
-
-    i = 0;
-    j = random_bytes_size;
-    while (i < weight) {
-        do {
-            if (j == random_bytes_size) {
-                seedexpander(ctx, rand_bytes, random_bytes_size);
-                j = 0;
-            }
-
-            support[i]  = ((uint32_t) rand_bytes[j++]) << 16;
-            support[i] |= ((uint32_t) rand_bytes[j++]) << 8;
-            support[i] |= rand_bytes[j++];
-
-        } while (support[i] >= UTILS_REJECTION_THRESHOLD);
-
-        support[i] = support[i] % PARAM_N;
-
-        inc = 1;
-        for (size_t k = 0; k < i; k++) {
-            if (support[k] == support[i]) {
-                inc = 0;
-            }
+
+    seedexpander(ctx, (uint8_t *)&rand_u32, 4 * weight);
+
+    for (size_t i = 0; i < weight; ++i) {
+        support[i] = i + rand_u32[i] % (PARAM_N - i);
+    }
+
+    for (int32_t i = (weight - 1); i -- > 0;) {
+        uint32_t found = 0;
+
+        for (size_t j = i + 1; j < weight; ++j) {
+            found |= compare_u32(support[j], support[i]);
         }
-        i += inc;
+
+        uint32_t mask = -found;
+        support[i] = (mask & i) ^ (~mask & support[i]);
     }
 
     for (size_t i = 0; i < weight; i++) {
@@ -109,12 +107,13 @@ void vect_set_random(seedexpander_state *ctx, uint64_t *v) {
  * This function generates a random binary vector. It uses the the prng function.
  *
  * @param[in] v Pointer to an array
+ * @param[in] size_v Size of v
  */
-void vect_set_random_from_prng(uint64_t *v) {
-    uint8_t rand_bytes [VEC_K_SIZE_BYTES] = {0};
+void vect_set_random_from_prng(uint64_t *v, uint32_t size_v) {
+    uint8_t rand_bytes [32] = {0}; // set to the maximum possible size - 256 bits
 
-    shake_prng(rand_bytes, VEC_K_SIZE_BYTES);
-    memcpy(v, rand_bytes, VEC_K_SIZE_BYTES);
+    shake_prng(rand_bytes, size_v << 3);
+    memcpy(v, rand_bytes, size_v << 3);
 }
 
 
@@ -4,6 +4,8 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#define FIPS202_NAMESPACE(s) hqc128_avx2_fips202##s
+
 #define SHAKE128_RATE 168
 #define SHAKE256_RATE 136
 #define SHA3_256_RATE 136
@@ -46,45 +48,71 @@ typedef struct {
     uint64_t ctx[26];
 } sha3_512incctx;
 
+#define shake128_absorb FIPS202_NAMESPACE(_shake128_absorb)
 void shake128_absorb(shake128ctx *state, const uint8_t *input, size_t inlen);
 
+#define shake128_squeezeblocks FIPS202_NAMESPACE(_shake128_squeezeblocks)
 void shake128_squeezeblocks(uint8_t *output, size_t nblocks, shake128ctx *state);
 
+#define shake128_inc_init FIPS202_NAMESPACE(_shake128_inc_init)
 void shake128_inc_init(shake128incctx *state);
+#define shake128_inc_absorb FIPS202_NAMESPACE(_shake128_inc_absorb)
 void shake128_inc_absorb(shake128incctx *state, const uint8_t *input, size_t inlen);
+#define shake128_inc_finalize FIPS202_NAMESPACE(_shake128_inc_finalize)
 void shake128_inc_finalize(shake128incctx *state);
+#define shake128_inc_squeeze FIPS202_NAMESPACE(_shake128_inc_squeeze)
 void shake128_inc_squeeze(uint8_t *output, size_t outlen, shake128incctx *state);
 
+#define shake256_absorb FIPS202_NAMESPACE(_shake256_absorb)
 void shake256_absorb(shake256ctx *state, const uint8_t *input, size_t inlen);
+#define shake256_squeezeblocks FIPS202_NAMESPACE(_shake256_squeezeblocks)
 void shake256_squeezeblocks(uint8_t *output, size_t nblocks, shake256ctx *state);
 
+#define shake256_inc_init FIPS202_NAMESPACE(_shake256_inc_init)
 void shake256_inc_init(shake256incctx *state);
+#define shake256_inc_absorb FIPS202_NAMESPACE(_shake256_inc_absorb)
 void shake256_inc_absorb(shake256incctx *state, const uint8_t *input, size_t inlen);
+#define shake256_inc_finalize FIPS202_NAMESPACE(_shake256_inc_finalize)
 void shake256_inc_finalize(shake256incctx *state);
+#define shake256_inc_squeeze FIPS202_NAMESPACE(_shake256_inc_squeeze)
 void shake256_inc_squeeze(uint8_t *output, size_t outlen, shake256incctx *state);
 
+#define shake128 FIPS202_NAMESPACE(_shake128)
 void shake128(uint8_t *output, size_t outlen,
               const uint8_t *input, size_t inlen);
 
+#define shake256 FIPS202_NAMESPACE(_shake256)
 void shake256(uint8_t *output, size_t outlen,
               const uint8_t *input, size_t inlen);
 
+#define sha3_256_inc_init FIPS202_NAMESPACE(_sha3_256_inc_init)
 void sha3_256_inc_init(sha3_256incctx *state);
+#define sha3_256_inc_absorb FIPS202_NAMESPACE(_sha3_256_inc_absorb)
 void sha3_256_inc_absorb(sha3_256incctx *state, const uint8_t *input, size_t inlen);
+#define sha3_256_inc_finalize FIPS202_NAMESPACE(_sha3_256_inc_finalize)
 void sha3_256_inc_finalize(uint8_t *output, sha3_256incctx *state);
 
+#define sha3_256 FIPS202_NAMESPACE(_sha3_256)
 void sha3_256(uint8_t *output, const uint8_t *input, size_t inlen);
 
+#define sha3_384_inc_init FIPS202_NAMESPACE(_sha3_384_inc_init)
 void sha3_384_inc_init(sha3_384incctx *state);
+#define sha3_384_inc_absorb FIPS202_NAMESPACE(_sha3_384_inc_absorb)
 void sha3_384_inc_absorb(sha3_384incctx *state, const uint8_t *input, size_t inlen);
+#define sha3_384_inc_finalize FIPS202_NAMESPACE(_sha3_384_inc_finalize)
 void sha3_384_inc_finalize(uint8_t *output, sha3_384incctx *state);
 
+#define sha3_384 FIPS202_NAMESPACE(_sha3_384)
 void sha3_384(uint8_t *output, const uint8_t *input, size_t inlen);
 
+#define sha3_512_inc_init FIPS202_NAMESPACE(_sha3_512_inc_init)
 void sha3_512_inc_init(sha3_512incctx *state);
+#define sha3_512_inc_absorb FIPS202_NAMESPACE(_sha3_512_inc_absorb)
 void sha3_512_inc_absorb(sha3_512incctx *state, const uint8_t *input, size_t inlen);
+#define sha3_512_inc_finalize FIPS202_NAMESPACE(_sha3_512_inc_finalize)
 void sha3_512_inc_finalize(uint8_t *output, sha3_512incctx *state);
 
+#define sha3_512 FIPS202_NAMESPACE(_sha3_512)
 void sha3_512(uint8_t *output, const uint8_t *input, size_t inlen);
 
 #endif
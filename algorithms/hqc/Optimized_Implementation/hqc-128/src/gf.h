@@ -9,6 +9,7 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <immintrin.h>
+#include "parameters.h"
 
 #define _mm256_set_m128i(v0, v1)  _mm256_insertf128_si256(_mm256_castsi128_si256(v1), (v0), 1)
 
@@ -54,12 +55,18 @@ static const __m256i red[7] = {
 };
 
 
+#define gf_generate HQC_NAMESPACE(_gf_generate)
 void gf_generate(uint16_t *exp, uint16_t *log, const int16_t m);
 
+#define gf_mul HQC_NAMESPACE(_gf_mul)
 uint16_t gf_mul(uint16_t a, uint16_t b);
+#define gf_mul_vect HQC_NAMESPACE(_gf_mul_vect)
 __m256i gf_mul_vect(__m256i a, __m256i b);
+#define gf_square HQC_NAMESPACE(_gf_square)
 uint16_t gf_square(uint16_t a);
+#define gf_inverse HQC_NAMESPACE(_gf_inverse)
 uint16_t gf_inverse(uint16_t a);
+#define gf_mod HQC_NAMESPACE(_gf_mod)
 uint16_t gf_mod(uint16_t i);
 
 #endif
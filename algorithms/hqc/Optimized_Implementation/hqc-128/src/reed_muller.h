@@ -10,7 +10,11 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#define reed_muller_encode HQC_NAMESPACE(_reed_muller_encode)
 void reed_muller_encode(uint64_t* cdw, const uint64_t* msg);
+#define reed_muller_decode HQC_NAMESPACE(_reed_muller_decode)
 void reed_muller_decode(uint64_t* msg, const uint64_t* cdw);
+#define reed_muller_decode_blocks HQC_NAMESPACE(_reed_muller_decode_blocks)
+void reed_muller_decode_blocks(uint64_t* msg, const uint64_t* cdw, size_t first, size_t last);
 
 #endif
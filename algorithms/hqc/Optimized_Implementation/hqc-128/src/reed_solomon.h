@@ -11,9 +11,12 @@
 #include <stdint.h>
 
 
+#define reed_solomon_encode HQC_NAMESPACE(_reed_solomon_encode)
 void reed_solomon_encode(uint64_t *cdw, const uint64_t *msg);
+#define reed_solomon_decode HQC_NAMESPACE(_reed_solomon_decode)
 void reed_solomon_decode(uint64_t *msg, uint64_t *cdw);
 
+#define compute_generator_poly HQC_NAMESPACE(_compute_generator_poly)
 void compute_generator_poly(uint16_t *poly);
 
 #endif
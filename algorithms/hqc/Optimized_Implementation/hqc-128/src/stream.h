@@ -0,0 +1,36 @@
+#ifndef STREAM_H
+#define STREAM_H
+
+/**
+ * @file stream.h
+ * @brief Streaming decapsulation of the HQC_KEM IND_CCA2 scheme
+ *
+ * The ciphertext is passed in chunks as it arrives. The secret key is expanded before the first byte, u.y is
+ * computed as soon as u is complete and every Reed-Muller block of v - u.y is decoded once its bytes of v are in,
+ * so only the Reed-Solomon decoding and the re-encryption are left for the last byte. The result is the same as
+ * that of crypto_kem_dec on the whole ciphertext.
+ */
+
+#include "parameters.h"
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct {
+    size_t len;                     /*!< Bytes of ciphertext received */
+    size_t blocks;                  /*!< Reed-Muller blocks decoded */
+    const uint8_t *sk;
+    uint64_t y[VEC_N_256_SIZE_64];  /*!< Secret vector y */
+    uint64_t uy[VEC_N_256_SIZE_64]; /*!< u.y, once u is complete */
+    uint64_t em[VEC_N1N2_SIZE_64];  /*!< v - u.y, block by block */
+    uint64_t rm[VEC_N1_SIZE_64];    /*!< Reed-Muller decoded blocks, the Reed-Solomon code word */
+    uint8_t ct[CIPHERTEXT_BYTES];
+} crypto_kem_dec_state;
+
+#define crypto_kem_dec_init HQC_NAMESPACE(_dec_init)
+int crypto_kem_dec_init(crypto_kem_dec_state *state, const unsigned char *sk);
+#define crypto_kem_dec_update HQC_NAMESPACE(_dec_update)
+int crypto_kem_dec_update(crypto_kem_dec_state *state, const unsigned char *ct, size_t ctlen);
+#define crypto_kem_dec_final HQC_NAMESPACE(_dec_final)
+int crypto_kem_dec_final(unsigned char *ss, crypto_kem_dec_state *state);
+
+#endif
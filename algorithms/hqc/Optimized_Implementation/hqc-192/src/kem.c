@@ -8,6 +8,7 @@
 #include "parameters.h"
 #include "parsing.h"
 #include "shake_ds.h"
+#include "shake_prng.h"
 #include "fips202.h"
 #include "vector.h"
 #include <stdint.h>
@@ -31,11 +32,33 @@
  * @returns 0 if keygen is successful
  */
 int crypto_kem_keypair(unsigned char *pk, unsigned char *sk) {
+    uint8_t seeds[2 * SEED_BYTES];
+
+    // sk_seed, then pk_seed, drawn separately as before so the KATs are unchanged
+    shake_prng(seeds, SEED_BYTES);
+    shake_prng(seeds + SEED_BYTES, SEED_BYTES);
+    return crypto_kem_keypair_derand(pk, sk, seeds);
+}
+
+
+
+/**
+ * @brief Keygen of the HQC_KEM IND_CAA2 scheme from given seeds
+ *
+ * The keys only depend on the secret key seed and the public key seed, so those two seeds
+ * (CRYPTO_KEYPAIRCOINBYTES bytes) are a compact form of the secret key that this function expands again.
+ *
+ * @param[out] pk String containing the public key
+ * @param[out] sk String containing the secret key
+ * @param[in] seeds String containing sk_seed || pk_seed
+ * @returns 0 if keygen is successful
+ */
+int crypto_kem_keypair_derand(unsigned char *pk, unsigned char *sk, const unsigned char *seeds) {
     #ifdef VERBOSE
         printf("\n\n\n\n### KEYGEN ###");
     #endif
 
-    hqc_pke_keygen(pk, sk);
+    hqc_pke_keygen(pk, sk, seeds);
     return 0;
 }
 
@@ -56,7 +79,7 @@ int crypto_kem_enc(unsigned char *ct, unsigned char *ss, const unsigned char *pk
 
     uint8_t theta[SHAKE256_512_BYTES] = {0};
     uint64_t m[VEC_K_SIZE_64] = {0};
-    static uint64_t u[VEC_N_256_SIZE_64] = {0};
+    static __thread uint64_t u[VEC_N_256_SIZE_64] = {0};
     uint64_t v[VEC_N1N2_256_SIZE_64] = {0};
     uint8_t d[SHAKE256_512_BYTES] = {0};
     uint8_t mc[VEC_K_SIZE_BYTES + VEC_N_SIZE_BYTES + VEC_N1N2_SIZE_BYTES] = {0};
@@ -33,10 +33,10 @@ typedef union {
 // copy bit 0 into all bits of a 64 bit value
 #define BIT0MASK(x) (int64_t)(-((x) & 1))
 
-void encode(codeword *word, int32_t message);
-void expand_and_sum(expandedCodeword *dst, codeword src[]);
-void hadamard(expandedCodeword *src, expandedCodeword *dst);
-int32_t find_peaks(expandedCodeword *transform);
+static void encode(codeword *word, int32_t message);
+static void expand_and_sum(expandedCodeword *dst, codeword src[]);
+static void hadamard(expandedCodeword *src, expandedCodeword *dst);
+static int32_t find_peaks(expandedCodeword *transform);
 
 
 
@@ -57,7 +57,7 @@ int32_t find_peaks(expandedCodeword *transform);
  * @param[out] word An RM(1,7) codeword
  * @param[in] message A message to encode
  */
-inline void encode(codeword *word, int32_t message) {
+static inline void encode(codeword *word, int32_t message) {
     int32_t first_word;
     first_word = BIT0MASK(message >> 7);
     first_word ^= BIT0MASK(message >> 0) & 0xaaaaaaaa;
@@ -89,7 +89,7 @@ inline void encode(codeword *word, int32_t message) {
  * @param[out] dst Structure that contain the expanded codeword
  * @param[in] src Structure that contain the codeword
  */
-inline void expand_and_sum(expandedCodeword *dst, codeword src[]) {
+static inline void expand_and_sum(expandedCodeword *dst, codeword src[]) {
     // start converting the first copy
     for (size_t part = 0; part < 8; part++) {
         for (size_t i = 0; i < 16; ++i) {
@@ -117,7 +117,7 @@ inline void expand_and_sum(expandedCodeword *dst, codeword src[]) {
  * @param[out] src Structure that contain the expanded codeword
  * @param[out] dst Structure that contain the expanded codeword
  */
-inline void hadamard(expandedCodeword *src, expandedCodeword *dst) {
+static inline void hadamard(expandedCodeword *src, expandedCodeword *dst) {
     // the passes move data:
     // src -> dst -> src -> dst -> src -> dst -> src -> dst
     // using p1 and p2 alternately
@@ -162,7 +162,7 @@ inline void hadamard(expandedCodeword *src, expandedCodeword *dst) {
  *
  * @param[in] transform Structure that contain the expanded codeword
  */
-inline int32_t find_peaks(expandedCodeword *transform) {
+static inline int32_t find_peaks(expandedCodeword *transform) {
     __m256i bitmap, abs_rows[8], bound, active_row, max_abs_rows;
     vector peak_mask;
     // compute absolute value of transform
@@ -289,10 +289,27 @@ void reed_muller_encode(uint64_t *cdw, const uint64_t *msg) {
  * @param[in] cdw Array of size VEC_N1N2_SIZE_64 storing the received word
  */
 void reed_muller_decode(uint64_t *msg, const uint64_t *cdw) {
+    reed_muller_decode_blocks(msg, cdw, 0, VEC_N1_SIZE_BYTES);
+}
+
+
+
+/**
+ * @brief Decodes the blocks first to last (excluded) of the received word
+ *
+ * Each block is PARAM_N2 bits of the received word and decodes to one byte of the message, so blocks can be
+ * decoded as they are received.
+ *
+ * @param[out] msg Array of size VEC_N1_SIZE_64 receiving bytes first to last of the decoded message
+ * @param[in] cdw Array of size VEC_N1N2_SIZE_64 storing the received word, of which blocks first to last are read
+ * @param[in] first First block to decode
+ * @param[in] last Block after the last one to decode
+ */
+void reed_muller_decode_blocks(uint64_t *msg, const uint64_t *cdw, size_t first, size_t last) {
     uint8_t *message_array = (uint8_t *) msg;
     codeword *codeArray = (codeword *) cdw;
     expandedCodeword expanded;
-    for (size_t i = 0; i < VEC_N1_SIZE_BYTES; i++) {
+    for (size_t i = first; i < last; i++) {
         // collect the codewords
         expand_and_sum(&expanded, &codeArray[i * MULTIPLICITY]);
         // apply hadamard transform
@@ -9,12 +9,17 @@
 #include <stdint.h>
 #include "fips202.h"
 #include "domains.h"
+#include "parameters.h"
 
 typedef shake256incctx seedexpander_state;
 
+#define shake_prng_init HQC_NAMESPACE(_shake_prng_init)
 void shake_prng_init(uint8_t *entropy_input, uint8_t *personalization_string, uint32_t enlen, uint32_t perlen);
+#define shake_prng HQC_NAMESPACE(_shake_prng)
 void shake_prng(uint8_t *output, uint32_t outlen);
+#define seedexpander_init HQC_NAMESPACE(_seedexpander_init)
 void seedexpander_init(seedexpander_state *state, const uint8_t *seed, uint32_t seedlen);
+#define seedexpander HQC_NAMESPACE(_seedexpander)
 void seedexpander(seedexpander_state *state, uint8_t *output, uint32_t outlen);
 
 #endif
@@ -0,0 +1,176 @@
+/**
+ * @file stream.c
+ * @brief Implementation of stream.h
+ */
+
+#include "stream.h"
+#include "api.h"
+#include "hqc.h"
+#include "parameters.h"
+#include "parsing.h"
+#include "gf2x.h"
+#include "reed_muller.h"
+#include "reed_solomon.h"
+#include "shake_ds.h"
+#include "vector.h"
+#include <stdint.h>
+#include <string.h>
+#include <immintrin.h>
+
+// Bytes of one Reed-Muller block, PARAM_N2 bits, of v
+#define VEC_N2_SIZE_BYTES               (PARAM_N2 / 8)
+
+
+
+/**
+ * @brief Starts a streaming decapsulation, before any byte of the ciphertext has arrived
+ *
+ * Expands the secret vector y from the secret key seed, which crypto_kem_dec does after receiving the ciphertext.
+ *
+ * @param[out] state Decapsulation state
+ * @param[in] sk String containing the secret key, which has to stay valid until crypto_kem_dec_final
+ * @returns 0
+ */
+int crypto_kem_dec_init(crypto_kem_dec_state *state, const unsigned char *sk) {
+    static __thread __m256i x_256[VEC_N_256_SIZE_64 >> 2] = {0};
+    static __thread __m256i y_256[VEC_N_256_SIZE_64 >> 2] = {0};
+    uint8_t pk[PUBLIC_KEY_BYTES] = {0};
+
+    memset(y_256, 0, (VEC_N_256_SIZE_64 >> 2) * sizeof(__m256i));
+    hqc_secret_key_from_string(x_256, y_256, pk, sk);
+    memcpy(state->y, y_256, VEC_N_256_SIZE_64 * 8);
+
+    state->len = 0;
+    state->blocks = 0;
+    state->sk = sk;
+    return 0;
+}
+
+
+
+/**
+ * @brief Takes the next chunk of the ciphertext
+ *
+ * Once u is complete, computes u.y while v is still arriving. Then, for every Reed-Muller block of v the chunk
+ * completes, adds the matching block of u.y and decodes it, as code_decode does for the whole word.
+ *
+ * @param[in,out] state Decapsulation state
+ * @param[in] ct Chunk of the ciphertext
+ * @param[in] ctlen Length of the chunk in bytes
+ * @returns 0 on success, -1 if the chunk runs past the ciphertext
+ */
+int crypto_kem_dec_update(crypto_kem_dec_state *state, const unsigned char *ct, size_t ctlen) {
+    static __thread __m256i u_256[VEC_N_256_SIZE_64 >> 2] = {0};
+    static __thread __m256i y_256[VEC_N_256_SIZE_64 >> 2] = {0};
+    static __thread __m256i tmp_256[VEC_N_256_SIZE_64 >> 2];
+    size_t before = state->len;
+    size_t blocks;
+
+    if (ctlen > CIPHERTEXT_BYTES - state->len) {
+        return -1;
+    }
+
+    memcpy(state->ct + state->len, ct, ctlen);
+    state->len += ctlen;
+
+    // Compute u.y
+    if (before < VEC_N_SIZE_BYTES && state->len >= VEC_N_SIZE_BYTES) {
+        memset(u_256, 0, (VEC_N_256_SIZE_64 >> 2) * sizeof(__m256i));
+        memcpy(u_256, state->ct, VEC_N_SIZE_BYTES);
+        memcpy(y_256, state->y, VEC_N_256_SIZE_64 * 8);
+        vect_mul(tmp_256, y_256, u_256);
+        memcpy(state->uy, tmp_256, VEC_N_256_SIZE_64 * 8);
+    }
+
+    // Decode the blocks of v - u.y that are complete
+    if (state->len < VEC_N_SIZE_BYTES) {
+        return 0;
+    }
+    blocks = (state->len - VEC_N_SIZE_BYTES) / VEC_N2_SIZE_BYTES;
+    if (blocks > PARAM_N1) {
+        blocks = PARAM_N1;
+    }
+    if (blocks > state->blocks) {
+        size_t first = state->blocks * (VEC_N2_SIZE_BYTES / 8);
+        size_t last = blocks * (VEC_N2_SIZE_BYTES / 8);
+
+        memcpy(state->em + first, state->ct + VEC_N_SIZE_BYTES + first * 8, (last - first) * 8);
+        vect_add(state->em + first, state->em + first, state->uy + first, last - first);
+        reed_muller_decode_blocks(state->rm, state->em, state->blocks, blocks);
+        state->blocks = blocks;
+    }
+
+    return 0;
+}
+
+
+
+/**
+ * @brief Finishes a streaming decapsulation once the whole ciphertext was passed to crypto_kem_dec_update
+ *
+ * The same as crypto_kem_dec from the Reed-Solomon decoding on.
+ *
+ * @param[out] ss String containing the shared secret
+ * @param[in,out] state Decapsulation state
+ * @returns 0 if decapsulation is successful, -1 otherwise or if the ciphertext is incomplete
+ */
+int crypto_kem_dec_final(unsigned char *ss, crypto_kem_dec_state *state) {
+    uint8_t result;
+    uint64_t u[VEC_N_256_SIZE_64] = {0};
+    uint64_t v[VEC_N1N2_256_SIZE_64] = {0};
+    uint8_t d[SHAKE256_512_BYTES] = {0};
+    uint8_t pk[PUBLIC_KEY_BYTES] = {0};
+    uint64_t m[VEC_K_SIZE_64] = {0};
+    uint8_t theta[SHAKE256_512_BYTES] = {0};
+    uint64_t u2[VEC_N_256_SIZE_64] = {0};
+    uint64_t v2[VEC_N1N2_256_SIZE_64] = {0};
+    uint8_t d2[SHAKE256_512_BYTES] = {0};
+    uint8_t mc[VEC_K_SIZE_BYTES + VEC_N_SIZE_BYTES + VEC_N1N2_SIZE_BYTES] = {0};
+    uint64_t salt[SALT_SIZE_64] = {0};
+    uint8_t tmp[VEC_K_SIZE_BYTES + SEED_BYTES + SALT_SIZE_BYTES] = {0};
+    shake256incctx shake256state;
+
+    if (state->len != CIPHERTEXT_BYTES) {
+        return -1;
+    }
+
+    // Retrieving u, v and d from ciphertext
+    hqc_ciphertext_from_string(u, v, d, salt, state->ct);
+
+    // Retrieving pk from sk
+    memcpy(pk, state->sk + SEED_BYTES, PUBLIC_KEY_BYTES);
+
+    // Decrypting, all Reed-Muller blocks are decoded by now
+    reed_solomon_decode(m, state->rm);
+
+    // Computing theta
+    memcpy(tmp, m, VEC_K_SIZE_BYTES);
+    memcpy(tmp + VEC_K_SIZE_BYTES, pk, SEED_BYTES);
+    memcpy(tmp + VEC_K_SIZE_BYTES + SEED_BYTES, salt, SALT_SIZE_BYTES);
+    shake256_512_ds(&shake256state, theta, tmp, VEC_K_SIZE_BYTES + SEED_BYTES + SALT_SIZE_BYTES, G_FCT_DOMAIN);
+
+    // Encrypting m'
+    hqc_pke_encrypt(u2, v2, m, theta, pk);
+
+    // Computing d'
+    shake256_512_ds(&shake256state, d2, (uint8_t *) m, VEC_K_SIZE_BYTES, H_FCT_DOMAIN);
+
+    // Computing shared secret, m comes first so the ciphertext can't be absorbed before this point
+    memcpy(mc, m, VEC_K_SIZE_BYTES);
+    memcpy(mc + VEC_K_SIZE_BYTES, u, VEC_N_SIZE_BYTES);
+    memcpy(mc + VEC_K_SIZE_BYTES + VEC_N_SIZE_BYTES, v, VEC_N1N2_SIZE_BYTES);
+    shake256_512_ds(&shake256state, ss, mc, VEC_K_SIZE_BYTES + VEC_N_SIZE_BYTES + VEC_N1N2_SIZE_BYTES, K_FCT_DOMAIN);
+
+    // Abort if c != c' or d != d'
+    result = vect_compare((uint8_t *) u, (uint8_t *) u2, VEC_N_SIZE_BYTES);
+    result |= vect_compare((uint8_t *) v, (uint8_t *) v2, VEC_N1N2_SIZE_BYTES);
+    result |= vect_compare(d, d2, SHAKE256_512_BYTES);
+
+    result = (uint8_t) (-((int16_t) result) >> 15);
+
+    for (size_t i = 0 ; i < SHARED_SECRET_BYTES ; i++) {
+        ss[i] &= ~result;
+    }
+
+    return -(result & 1);
+}
@@ -9,18 +9,27 @@
 #include "shake_prng.h"
 #include <stdint.h>
 #include <immintrin.h>
+#include "parameters.h"
 
 #define LOOP_SIZE CEIL_DIVIDE(PARAM_N, 256)
 
+#define vect_set_random_fixed_weight HQC_NAMESPACE(_vect_set_random_fixed_weight)
 void vect_set_random_fixed_weight(seedexpander_state *ctx, __m256i *v256, uint16_t weight);
+#define vect_set_random HQC_NAMESPACE(_vect_set_random)
 void vect_set_random(seedexpander_state *ctx, uint64_t *v);
+#define vect_set_random_from_prng HQC_NAMESPACE(_vect_set_random_from_prng)
 void vect_set_random_from_prng(uint64_t *v, uint32_t size_v);
 
+#define vect_add HQC_NAMESPACE(_vect_add)
 void vect_add(uint64_t *o, const uint64_t *v1, const uint64_t *v2, uint32_t size);
+#define vect_compare HQC_NAMESPACE(_vect_compare)
 uint8_t vect_compare(const uint8_t *v1, const uint8_t *v2, uint32_t size);
+#define vect_resize HQC_NAMESPACE(_vect_resize)
 void vect_resize(uint64_t *o, uint32_t size_o, const uint64_t *v, uint32_t size_v);
 
+#define vect_print HQC_NAMESPACE(_vect_print)
 void vect_print(const uint64_t *v, const uint32_t size);
+#define vect_print_sparse HQC_NAMESPACE(_vect_print_sparse)
 void vect_print_sparse(const uint32_t *v, const uint16_t weight);
 
 #endif
@@ -10,7 +10,9 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#define code_encode HQC_NAMESPACE(_code_encode)
 void code_encode(uint64_t *codeword, const uint64_t *message);
+#define code_decode HQC_NAMESPACE(_code_decode)
 void code_decode(uint64_t *message, const uint64_t *vector);
 
 #endif
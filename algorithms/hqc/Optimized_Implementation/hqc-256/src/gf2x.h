@@ -8,7 +8,9 @@
 
 #include <stdint.h>
 #include <immintrin.h>
+#include "parameters.h"
 
+#define vect_mul HQC_NAMESPACE(_vect_mul)
 void vect_mul(__m256i *o, const __m256i *v1, const __m256i *v2);
 
 #endif
@@ -25,19 +25,22 @@
  * The secret key is composed of the <b>seed</b> used to generate vectors <b>x</b> and  <b>y</b>.
  * As a technicality, the public key is appended to the secret key in order to respect NIST API.
  *
+ * Both seeds are taken from seeds (sk_seed || pk_seed), so the keys are a deterministic function of them.
+ *
  * @param[out] pk String containing the public key
  * @param[out] sk String containing the secret key
+ * @param[in] seeds String containing the secret key seed and the public key seed
  */
-void hqc_pke_keygen(unsigned char* pk, unsigned char* sk) {
+void hqc_pke_keygen(unsigned char* pk, unsigned char* sk, const uint8_t* seeds) {
     seedexpander_state sk_seedexpander;
     seedexpander_state pk_seedexpander;
-    uint8_t sk_seed[SEED_BYTES] = {0};
-    uint8_t pk_seed[SEED_BYTES] = {0};
-    static __m256i h_256[VEC_N_256_SIZE_64 >> 2];
-    static __m256i y_256[VEC_N_256_SIZE_64 >> 2];   
-    static __m256i x_256[VEC_N_256_SIZE_64 >> 2];
-    static uint64_t s[VEC_N_256_SIZE_64];
-    static __m256i tmp_256[VEC_N_256_SIZE_64 >> 2];
+    const uint8_t* sk_seed = seeds;
+    const uint8_t* pk_seed = seeds + SEED_BYTES;
+    static __thread __m256i h_256[VEC_N_256_SIZE_64 >> 2];
+    static __thread __m256i y_256[VEC_N_256_SIZE_64 >> 2];   
+    static __thread __m256i x_256[VEC_N_256_SIZE_64 >> 2];
+    static __thread uint64_t s[VEC_N_256_SIZE_64];
+    static __thread __m256i tmp_256[VEC_N_256_SIZE_64 >> 2];
 
     #ifdef __STDC_LIB_EXT1__
         memset_s(x_256, 0, (VEC_N_256_SIZE_64 >> 2) * sizeof(__m256i));
@@ -51,10 +54,7 @@ void hqc_pke_keygen(unsigned char* pk, unsigned char* sk) {
 
 
     // Create seed_expanders for public key and secret key
-    shake_prng(sk_seed, SEED_BYTES);
     seedexpander_init(&sk_seedexpander, sk_seed, SEED_BYTES);
-
-    shake_prng(pk_seed, SEED_BYTES);
     seedexpander_init(&pk_seedexpander, pk_seed, SEED_BYTES);
 
     // Compute secret key
@@ -99,17 +99,17 @@ void hqc_pke_keygen(unsigned char* pk, unsigned char* sk) {
  */
 void hqc_pke_encrypt(uint64_t *u, uint64_t *v, uint64_t *m, unsigned char *theta, const unsigned char *pk) {
     seedexpander_state seedexpander;
-    static __m256i h_256[VEC_N_256_SIZE_64 >> 2];
-    static __m256i s_256[VEC_N_256_SIZE_64 >> 2];
-    static __m256i r2_256[VEC_N_256_SIZE_64 >> 2];
+    static __thread __m256i h_256[VEC_N_256_SIZE_64 >> 2];
+    static __thread __m256i s_256[VEC_N_256_SIZE_64 >> 2];
+    static __thread __m256i r2_256[VEC_N_256_SIZE_64 >> 2];
 
-    static __m256i r1_256[VEC_N_256_SIZE_64 >> 2];
-    static __m256i e_256[VEC_N_256_SIZE_64 >> 2];
+    static __thread __m256i r1_256[VEC_N_256_SIZE_64 >> 2];
+    static __thread __m256i e_256[VEC_N_256_SIZE_64 >> 2];
 
-    static __m256i tmp1_256[VEC_N_256_SIZE_64 >> 2];
-    static __m256i tmp2_256[VEC_N_256_SIZE_64 >> 2];
-    static __m256i tmp3_256[VEC_N_256_SIZE_64 >> 2];
-    static uint64_t tmp4[VEC_N_256_SIZE_64];
+    static __thread __m256i tmp1_256[VEC_N_256_SIZE_64 >> 2];
+    static __thread __m256i tmp2_256[VEC_N_256_SIZE_64 >> 2];
+    static __thread __m256i tmp3_256[VEC_N_256_SIZE_64 >> 2];
+    static __thread uint64_t tmp4[VEC_N_256_SIZE_64];
 
     #ifdef __STDC_LIB_EXT1__
         memset_s(r2_256, 0, (VEC_N_256_SIZE_64 >> 2) * sizeof(__m256i));
@@ -174,12 +174,12 @@ void hqc_pke_encrypt(uint64_t *u, uint64_t *v, uint64_t *m, unsigned char *theta
  * @param[in] sk String containing the secret key
  */
 void hqc_pke_decrypt(uint64_t *m, const __m256i *u_256, const uint64_t *v, const uint8_t *sk) {
-    static __m256i x_256[VEC_N_256_SIZE_64 >> 2] = {0};
-    static __m256i y_256[VEC_N_256_SIZE_64 >> 2] = {0};
+    static __thread __m256i x_256[VEC_N_256_SIZE_64 >> 2] = {0};
+    static __thread __m256i y_256[VEC_N_256_SIZE_64 >> 2] = {0};
     uint8_t pk[PUBLIC_KEY_BYTES] = {0};
-    static uint64_t tmp1[VEC_N_256_SIZE_64] = {0};
-    static uint64_t tmp2[VEC_N_256_SIZE_64] = {0};
-    static __m256i tmp3_256[VEC_N_256_SIZE_64 >> 2];
+    static __thread uint64_t tmp1[VEC_N_256_SIZE_64] = {0};
+    static __thread uint64_t tmp2[VEC_N_256_SIZE_64] = {0};
+    static __thread __m256i tmp3_256[VEC_N_256_SIZE_64 >> 2];
 
     #ifdef __STDC_LIB_EXT1__
         memset_s(y_256, 0, (VEC_N_256_SIZE_64 >> 2) * sizeof(__m256i));
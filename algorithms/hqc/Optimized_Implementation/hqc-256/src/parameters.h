@@ -6,8 +6,6 @@
  * @brief Parameters of the HQC_KEM IND-CCA2 scheme
  */
 
-#include "api.h"
-
 #define CEIL_DIVIDE(a, b)  (((a)/(b)) + ((a) % (b) == 0 ? 0 : 1)) /*!< Divide a by b and ceil the result*/
 #define BITMASK(a, size) ((1UL << (a % size)) - 1) /*!< Create a mask*/
 
@@ -110,4 +108,7 @@
 #define SALT_SIZE_BYTES                       16
 #define SALT_SIZE_64                          2
 
-#endif
\ No newline at end of file
+// Last, as api.h includes stream.h, which needs the parameters above
+#include "api.h"
+
+#endif
@@ -5,14 +5,50 @@
  */
 
 #include "shake_prng.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <sys/random.h>
+
+#define PRNG_OS_SEED_BYTES 48
+
+/* Each thread owns its PRNG state; generation 0 means the state was never seeded */
+static __thread shake256incctx shake_prng_state;
+static __thread uint64_t shake_prng_generation;
+
+/* Bumped in the child after fork() so states inherited from the parent are reseeded */
+static uint64_t shake_prng_fork_generation = 1;
+static pthread_once_t shake_prng_atfork_once = PTHREAD_ONCE_INIT;
+
+static void shake_prng_atfork_child(void) {
+    shake_prng_fork_generation++;
+}
+
+static void shake_prng_register_atfork(void) {
+    pthread_atfork(NULL, NULL, shake_prng_atfork_child);
+}
 
-shake256incctx shake_prng_state;
+
+
+/**
+ * @brief Seeds the calling thread's PRNG from the operating system
+ *
+ * Called lazily by shake_prng() the first time a thread draws randomness,
+ * and again after a fork() so that parent and child never share a stream.
+ */
+static void shake_prng_init_from_os(void) {
+    uint8_t entropy_input[PRNG_OS_SEED_BYTES];
+    if (getentropy(entropy_input, PRNG_OS_SEED_BYTES) != 0) {
+        abort();
+    }
+    shake_prng_init(entropy_input, NULL, PRNG_OS_SEED_BYTES, 0);
+}
 
 
 /**
  * @brief SHAKE-256 with incremental API and domain separation
  *
  * Derived from function SHAKE_256 in fips202.c
+ * Seeds the calling thread's state only, so KAT runs stay deterministic per thread.
  *
  * @param[in] entropy_input Pointer to input entropy bytes
  * @param[in] personalization_string Pointer to the personalization string
@@ -21,11 +57,13 @@ shake256incctx shake_prng_state;
  */
 void shake_prng_init(uint8_t *entropy_input, uint8_t *personalization_string, uint32_t enlen, uint32_t perlen) {
     uint8_t domain = PRNG_DOMAIN;
+    pthread_once(&shake_prng_atfork_once, shake_prng_register_atfork);
     shake256_inc_init(&shake_prng_state);
     shake256_inc_absorb(&shake_prng_state, entropy_input, enlen);
     shake256_inc_absorb(&shake_prng_state, personalization_string, perlen);
     shake256_inc_absorb(&shake_prng_state, &domain, 1);
     shake256_inc_finalize(&shake_prng_state);
+    shake_prng_generation = shake_prng_fork_generation;
 }
 
 
@@ -34,11 +72,22 @@ void shake_prng_init(uint8_t *entropy_input, uint8_t *personalization_string, ui
  * @brief A SHAKE-256 based PRNG
  *
  * Derived from function SHAKE_256 in fips202.c
+ * Seeds the calling thread's state from the OS if shake_prng_init() was not called,
+ * except in VERBOSE builds.
  *
  * @param[out] output Pointer to output
  * @param[in] outlen length of output in bytes
  */
 void shake_prng(uint8_t *output, uint32_t outlen) {
+    if (shake_prng_generation != shake_prng_fork_generation) {
+#ifdef VERBOSE
+        /* Verbose builds keep the all-zero state, as the submission did, so
+           their output reproduces the shipped intermediate values */
+        shake_prng_generation = shake_prng_fork_generation;
+#else
+        shake_prng_init_from_os();
+#endif
+    }
     shake256_inc_squeeze(output, outlen, &shake_prng_state);
 }
 
@@ -8,6 +8,7 @@
 #include "parameters.h"
 #include "parsing.h"
 #include "shake_ds.h"
+#include "shake_prng.h"
 #include "fips202.h"
 #include "vector.h"
 #include <stdint.h>
@@ -30,11 +31,33 @@
  * @returns 0 if keygen is successful
  */
 int crypto_kem_keypair(unsigned char *pk, unsigned char *sk) {
+    uint8_t seeds[2 * SEED_BYTES];
+
+    // sk_seed, then pk_seed, drawn separately as before so the KATs are unchanged
+    shake_prng(seeds, SEED_BYTES);
+    shake_prng(seeds + SEED_BYTES, SEED_BYTES);
+    return crypto_kem_keypair_derand(pk, sk, seeds);
+}
+
+
+
+/**
+ * @brief Keygen of the HQC_KEM IND_CAA2 scheme from given seeds
+ *
+ * The keys only depend on the secret key seed and the public key seed, so those two seeds
+ * (CRYPTO_KEYPAIRCOINBYTES bytes) are a compact form of the secret key that this function expands again.
+ *
+ * @param[out] pk String containing the public key
+ * @param[out] sk String containing the secret key
+ * @param[in] seeds String containing sk_seed || pk_seed
+ * @returns 0 if keygen is successful
+ */
+int crypto_kem_keypair_derand(unsigned char *pk, unsigned char *sk, const unsigned char *seeds) {
     #ifdef VERBOSE
         printf("\n\n\n\n### KEYGEN ###");
     #endif
 
-    hqc_pke_keygen(pk, sk);
+    hqc_pke_keygen(pk, sk, seeds);
     return 0;
 }
 
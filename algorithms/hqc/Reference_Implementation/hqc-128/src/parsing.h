@@ -7,14 +7,21 @@
  */
 
 #include <stdint.h>
+#include "parameters.h"
 
+#define hqc_secret_key_to_string HQC_NAMESPACE(_hqc_secret_key_to_string)
 void hqc_secret_key_to_string(uint8_t *sk, const uint8_t *sk_seed, const uint8_t *pk);
+#define hqc_secret_key_from_string HQC_NAMESPACE(_hqc_secret_key_from_string)
 void hqc_secret_key_from_string(uint64_t *x, uint64_t *y, uint8_t *pk, const uint8_t *sk);
 
+#define hqc_public_key_to_string HQC_NAMESPACE(_hqc_public_key_to_string)
 void hqc_public_key_to_string(uint8_t *pk, const uint8_t *pk_seed, const uint64_t *s);
+#define hqc_public_key_from_string HQC_NAMESPACE(_hqc_public_key_from_string)
 void hqc_public_key_from_string(uint64_t *h, uint64_t *s, const uint8_t *pk);
 
+#define hqc_ciphertext_to_string HQC_NAMESPACE(_hqc_ciphertext_to_string)
 void hqc_ciphertext_to_string(uint8_t *ct, const uint64_t *u, const uint64_t *v, const uint8_t *d, const uint64_t *salt);
+#define hqc_ciphertext_from_string HQC_NAMESPACE(_hqc_ciphertext_from_string)
 void hqc_ciphertext_from_string(uint64_t *u, uint64_t *v, uint8_t *d, uint64_t *salt, const uint8_t *ct);
 
 #endif
@@ -24,10 +24,10 @@ typedef int16_t expandedCodeword[128];
 #define BIT0MASK(x) (int32_t)(-((x) & 1))
 
 
-void encode(codeword *word, int32_t message);
-void hadamard(expandedCodeword *src, expandedCodeword *dst);
-void expand_and_sum(expandedCodeword *dest, codeword src[]);
-int32_t find_peaks(expandedCodeword *transform);
+static void encode(codeword *word, int32_t message);
+static void hadamard(expandedCodeword *src, expandedCodeword *dst);
+static void expand_and_sum(expandedCodeword *dest, codeword src[]);
+static int32_t find_peaks(expandedCodeword *transform);
 
 
 
@@ -48,7 +48,7 @@ int32_t find_peaks(expandedCodeword *transform);
  * @param[out] word An RM(1,7) codeword
  * @param[in] message A message
  */
-void encode(codeword *word, int32_t message) {
+static void encode(codeword *word, int32_t message) {
     int32_t first_word;
 
     first_word = BIT0MASK(message >> 7);
@@ -81,7 +81,7 @@ void encode(codeword *word, int32_t message) {
  * @param[out] src Structure that contain the expanded codeword
  * @param[out] dst Structure that contain the expanded codeword
  */
-void hadamard(expandedCodeword *src, expandedCodeword *dst) {
+static void hadamard(expandedCodeword *src, expandedCodeword *dst) {
     // the passes move data:
     // src -> dst -> src -> dst -> src -> dst -> src -> dst
     // using p1 and p2 alternately
@@ -114,7 +114,7 @@ void hadamard(expandedCodeword *src, expandedCodeword *dst) {
  * @param[out] dest Structure that contain the expanded codeword
  * @param[in] src Structure that contain the codeword
  */
-void expand_and_sum(expandedCodeword *dest, codeword src[]) {
+static void expand_and_sum(expandedCodeword *dest, codeword src[]) {
     // start with the first copy
     for (int32_t part = 0; part < 4; part++) {
         for (int32_t bit = 0; bit < 32; bit++) {
@@ -142,7 +142,7 @@ void expand_and_sum(expandedCodeword *dest, codeword src[]) {
  * in the lowest 7 bits it taken
  * @param[in] transform Structure that contain the expanded codeword
  */
-int32_t find_peaks(expandedCodeword *transform) {
+static int32_t find_peaks(expandedCodeword *transform) {
     int32_t peak_abs_value = 0;
     int32_t peak_value = 0;
     int32_t peak_pos = 0;
@@ -7,6 +7,7 @@
 #define API_H
 
 #define CRYPTO_ALGNAME                      "HQC-192"
+#define HQC_NAMESPACE(s)                    hqc192_ref##s
 
 #define CRYPTO_SECRETKEYBYTES               4562
 #define CRYPTO_PUBLICKEYBYTES               4522
@@ -16,8 +17,24 @@
 // As a technicality, the public key is appended to the secret key in order to respect the NIST API.
 // Without this constraint, CRYPTO_SECRETKEYBYTES would be defined as 32
 
+// The secret and public key seeds, the compact form of a secret key (see crypto_kem_keypair_derand)
+#define CRYPTO_KEYPAIRCOINBYTES             80
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define crypto_kem_keypair HQC_NAMESPACE(_keypair)
 int crypto_kem_keypair(unsigned char* pk, unsigned char* sk);
+#define crypto_kem_keypair_derand HQC_NAMESPACE(_keypair_derand)
+int crypto_kem_keypair_derand(unsigned char* pk, unsigned char* sk, const unsigned char* seeds);
+#define crypto_kem_enc HQC_NAMESPACE(_enc)
 int crypto_kem_enc(unsigned char* ct, unsigned char* ss, const unsigned char* pk);
+#define crypto_kem_dec HQC_NAMESPACE(_dec)
 int crypto_kem_dec(unsigned char* ss, const unsigned char* ct, const unsigned char* sk);
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif
@@ -9,8 +9,11 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include "parameters.h"
 
+#define fft HQC_NAMESPACE(_fft)
 void fft(uint16_t *w, const uint16_t *f, size_t f_coeffs);
+#define fft_retrieve_error_poly HQC_NAMESPACE(_fft_retrieve_error_poly)
 void fft_retrieve_error_poly(uint8_t *error, const uint16_t *w);
 
 #endif
@@ -9,7 +9,9 @@
 #include <stdint.h>
 #include "fips202.h"
 #include "domains.h"
+#include "parameters.h"
 
+#define shake256_512_ds HQC_NAMESPACE(_shake256_512_ds)
 void shake256_512_ds(shake256incctx *state, uint8_t *output, const uint8_t *input, size_t inlen, uint8_t domain);
 
 #endif
@@ -13,6 +13,7 @@
 
 using namespace NTL;
 
+#define vect_mul HQC_NAMESPACE(_vect_mul)
 void vect_mul(uint64_t *o, const uint64_t *v1, const uint64_t *v2);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,111 @@
+#ifndef HYBRID_TLS_KEM_H
+#define HYBRID_TLS_KEM_H
+
+/*
+ * Hybrid KEM composed at compile time from a classical and a post-quantum KEM.
+ * HYBRID_CLASSICAL_API and HYBRID_PQ_API are the paths (as quoted strings) of
+ * the two components' api.h. Each one is included in turn, its sizes and entry
+ * points are captured under a hybrid_classical_/hybrid_pq_ prefix, and its
+ * CRYPTO_* and crypto_kem_* names are released for the next one, including the
+ * optional derand and streaming ones. The hybrid has neither, so tests/kem.c
+ * leaves those fields of its registry entry NULL.
+ *
+ * pk = pk_classical || pk_pq, sk = sk_classical || sk_pq and
+ * ct = ct_classical || ct_pq. The shared secret is
+ * SHA3-256(HYBRID_ALGNAME || ss_classical || ss_pq || ct_classical || ct_pq),
+ * so different compositions never produce related secrets. Defining
+ * HYBRID_THREADS runs the classical half on a helper thread while the calling
+ * thread runs the post-quantum half. It only changes how the work is scheduled:
+ * the label, and so the shared secret, stays the same, and only CRYPTO_ALGNAME
+ * gets a "-MT" suffix to tell the builds apart in results.
+ */
+
+#if !defined(HYBRID_CLASSICAL_API) || !defined(HYBRID_PQ_API) || !defined(HYBRID_ALGNAME) || !defined(HYBRID_ID)
+  #error "HYBRID_CLASSICAL_API, HYBRID_PQ_API, HYBRID_ALGNAME and HYBRID_ID must be defined"
+#endif
+
+#define HYBRID_CONCAT_(a, b, c) a##b##c
+#define HYBRID_CONCAT(a, b, c) HYBRID_CONCAT_(a, b, c)
+#define HYBRID_NAMESPACE(s) HYBRID_CONCAT(hybrid_, HYBRID_ID, s)
+
+#define HYBRID_CAPTURE(side) \
+    enum { \
+        hybrid_##side##_PUBLICKEYBYTES = CRYPTO_PUBLICKEYBYTES, \
+        hybrid_##side##_SECRETKEYBYTES = CRYPTO_SECRETKEYBYTES, \
+        hybrid_##side##_CIPHERTEXTBYTES = CRYPTO_CIPHERTEXTBYTES, \
+        hybrid_##side##_BYTES = CRYPTO_BYTES \
+    }; \
+    static inline int hybrid_##side##_keypair(unsigned char* pk, unsigned char* sk) { \
+        return crypto_kem_keypair(pk, sk); \
+    } \
+    static inline int hybrid_##side##_enc(unsigned char* ct, unsigned char* ss, const unsigned char* pk) { \
+        return crypto_kem_enc(ct, ss, pk); \
+    } \
+    static inline int hybrid_##side##_dec(unsigned char* ss, const unsigned char* ct, const unsigned char* sk) { \
+        return crypto_kem_dec(ss, ct, sk); \
+    }
+
+#include HYBRID_CLASSICAL_API
+HYBRID_CAPTURE(classical)
+#undef CRYPTO_ALGNAME
+#undef CRYPTO_PUBLICKEYBYTES
+#undef CRYPTO_SECRETKEYBYTES
+#undef CRYPTO_CIPHERTEXTBYTES
+#undef CRYPTO_BYTES
+#undef crypto_kem_keypair
+#undef crypto_kem_enc
+#undef crypto_kem_dec
+#undef CRYPTO_KEYPAIRCOINBYTES
+#undef crypto_kem_keypair_derand
+#undef CRYPTO_ENCSTATEBYTES
+#undef crypto_kem_enc_init
+#undef crypto_kem_enc_update
+#undef crypto_kem_enc_final
+#undef CRYPTO_DECSTATEBYTES
+#undef crypto_kem_dec_init
+#undef crypto_kem_dec_update
+#undef crypto_kem_dec_final
+#undef CRYPTO_BACKEND
+#undef API_H
+
+#include HYBRID_PQ_API
+HYBRID_CAPTURE(pq)
+#undef CRYPTO_ALGNAME
+#undef CRYPTO_PUBLICKEYBYTES
+#undef CRYPTO_SECRETKEYBYTES
+#undef CRYPTO_CIPHERTEXTBYTES
+#undef CRYPTO_BYTES
+#undef crypto_kem_keypair
+#undef crypto_kem_enc
+#undef crypto_kem_dec
+#undef CRYPTO_KEYPAIRCOINBYTES
+#undef crypto_kem_keypair_derand
+#undef CRYPTO_ENCSTATEBYTES
+#undef crypto_kem_enc_init
+#undef crypto_kem_enc_update
+#undef crypto_kem_enc_final
+#undef CRYPTO_DECSTATEBYTES
+#undef crypto_kem_dec_init
+#undef crypto_kem_dec_update
+#undef crypto_kem_dec_final
+#undef CRYPTO_BACKEND
+#undef API_H
+
+#ifdef HYBRID_THREADS
+  #define CRYPTO_ALGNAME HYBRID_ALGNAME "-MT"
+#else
+  #define CRYPTO_ALGNAME HYBRID_ALGNAME
+#endif
+#define CRYPTO_PUBLICKEYBYTES (hybrid_classical_PUBLICKEYBYTES + hybrid_pq_PUBLICKEYBYTES)
+#define CRYPTO_SECRETKEYBYTES (hybrid_classical_SECRETKEYBYTES + hybrid_pq_SECRETKEYBYTES)
+#define CRYPTO_CIPHERTEXTBYTES (hybrid_classical_CIPHERTEXTBYTES + hybrid_pq_CIPHERTEXTBYTES)
+#define CRYPTO_BYTES 32
+
+#define crypto_kem_keypair HYBRID_NAMESPACE(_keypair)
+int crypto_kem_keypair(unsigned char* pk, unsigned char* sk);
+#define crypto_kem_enc HYBRID_NAMESPACE(_enc)
+int crypto_kem_enc(unsigned char* ct, unsigned char* ss, const unsigned char* pk);
+#define crypto_kem_dec HYBRID_NAMESPACE(_dec)
+int crypto_kem_dec(unsigned char* ss, const unsigned char* ct, const unsigned char* sk);
+
+#endif
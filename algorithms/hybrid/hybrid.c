@@ -0,0 +1,199 @@
+#include "api.h"
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include <string.h>
+#include <stdlib.h>
+#ifdef HYBRID_THREADS
+#include <pthread.h>
+#endif
+
+/* Per-thread combiner state: SHA3-256 is fetched once and its context reused */
+static __thread EVP_MD *sha3;
+static __thread EVP_MD_CTX *sha3_ctx;
+
+/* ss = SHA3-256(HYBRID_ALGNAME || ss_classical || ss_pq || ct_classical || ct_pq) */
+static int combine(unsigned char *ss, const unsigned char *ss_classical, const unsigned char *ss_pq, const unsigned char *ct)
+{
+    static const char label[] = HYBRID_ALGNAME;
+
+    if (sha3_ctx == NULL) {
+        sha3 = EVP_MD_fetch(NULL, "SHA3-256", NULL);
+        sha3_ctx = EVP_MD_CTX_new();
+        if (sha3 == NULL || sha3_ctx == NULL)
+            return -1;
+    }
+
+    if (EVP_DigestInit_ex2(sha3_ctx, sha3, NULL) <= 0
+        || EVP_DigestUpdate(sha3_ctx, label, sizeof(label) - 1) <= 0
+        || EVP_DigestUpdate(sha3_ctx, ss_classical, hybrid_classical_BYTES) <= 0
+        || EVP_DigestUpdate(sha3_ctx, ss_pq, hybrid_pq_BYTES) <= 0
+        || EVP_DigestUpdate(sha3_ctx, ct, CRYPTO_CIPHERTEXTBYTES) <= 0
+        || EVP_DigestFinal_ex(sha3_ctx, ss, NULL) <= 0)
+        return -1;
+    return 0;
+}
+
+/* One call into the classical KEM, so it can be handed to another thread */
+typedef struct {
+    enum { CLASSICAL_KEYPAIR, CLASSICAL_ENC, CLASSICAL_DEC } op;
+    unsigned char *out1;
+    unsigned char *out2;
+    const unsigned char *in1;
+    const unsigned char *in2;
+    int result;
+} classical_job_t;
+
+static void classical_run(classical_job_t *job)
+{
+    switch (job->op) {
+    case CLASSICAL_KEYPAIR:
+        job->result = hybrid_classical_keypair(job->out1, job->out2);
+        break;
+    case CLASSICAL_ENC:
+        job->result = hybrid_classical_enc(job->out1, job->out2, job->in1);
+        break;
+    case CLASSICAL_DEC:
+        job->result = hybrid_classical_dec(job->out1, job->in1, job->in2);
+        break;
+    }
+}
+
+#ifdef HYBRID_THREADS
+/*
+ * Every calling thread gets its own helper thread, created on first use and
+ * kept for the life of the process, so the classical KEM's per-thread state
+ * (cached keys, RNG) stays with one thread and no job waits on another caller.
+ */
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    classical_job_t *job;
+    unsigned long submitted;
+    unsigned long completed;
+} helper_t;
+
+static __thread helper_t *helper;
+
+static void *helper_main(void *raw_helper)
+{
+    helper_t *h = raw_helper;
+    unsigned long done = 0;
+
+    for (;;) {
+        pthread_mutex_lock(&h->lock);
+        while (h->submitted == done)
+            pthread_cond_wait(&h->cond, &h->lock);
+        classical_job_t *job = h->job;
+        pthread_mutex_unlock(&h->lock);
+
+        classical_run(job);
+
+        pthread_mutex_lock(&h->lock);
+        h->completed = ++done;
+        pthread_cond_broadcast(&h->cond);
+        pthread_mutex_unlock(&h->lock);
+    }
+    return NULL;
+}
+
+static int classical_start(classical_job_t *job)
+{
+    if (helper == NULL) {
+        helper_t *h = calloc(1, sizeof(*h));
+        pthread_t thread;
+        if (h == NULL)
+            return -1;
+        pthread_mutex_init(&h->lock, NULL);
+        pthread_cond_init(&h->cond, NULL);
+        if (pthread_create(&thread, NULL, helper_main, h) != 0) {
+            free(h);
+            return -1;
+        }
+        pthread_detach(thread);
+        helper = h;
+    }
+
+    pthread_mutex_lock(&helper->lock);
+    helper->job = job;
+    helper->submitted++;
+    pthread_cond_broadcast(&helper->cond);
+    pthread_mutex_unlock(&helper->lock);
+    return 0;
+}
+
+static void classical_wait(void)
+{
+    pthread_mutex_lock(&helper->lock);
+    while (helper->completed != helper->submitted)
+        pthread_cond_wait(&helper->cond, &helper->lock);
+    pthread_mutex_unlock(&helper->lock);
+}
+#else
+/* Without HYBRID_THREADS the classical half simply runs first */
+static int classical_start(classical_job_t *job)
+{
+    classical_run(job);
+    return 0;
+}
+
+static void classical_wait(void)
+{
+}
+#endif
+
+/* Generate keypair */
+int crypto_kem_keypair(unsigned char *pk, unsigned char *sk)
+{
+    classical_job_t job = { CLASSICAL_KEYPAIR, pk, sk, NULL, NULL, -1 };
+
+    if (classical_start(&job) != 0)
+        return -1;
+    int result = hybrid_pq_keypair(pk + hybrid_classical_PUBLICKEYBYTES, sk + hybrid_classical_SECRETKEYBYTES);
+    classical_wait();
+
+    return (result != 0 || job.result != 0) ? -1 : 0;
+}
+
+/* Encapsulate */
+int crypto_kem_enc(unsigned char *ct, unsigned char *ss, const unsigned char *pk)
+{
+    unsigned char ss_classical[hybrid_classical_BYTES];
+    unsigned char ss_pq[hybrid_pq_BYTES];
+    classical_job_t job = { CLASSICAL_ENC, ct, ss_classical, pk, NULL, -1 };
+
+    if (classical_start(&job) != 0)
+        return -1;
+    int result = hybrid_pq_enc(ct + hybrid_classical_CIPHERTEXTBYTES, ss_pq, pk + hybrid_classical_PUBLICKEYBYTES);
+    classical_wait();
+
+    if (result == 0 && job.result == 0)
+        result = combine(ss, ss_classical, ss_pq, ct);
+    else
+        result = -1;
+
+    OPENSSL_cleanse(ss_classical, sizeof(ss_classical));
+    OPENSSL_cleanse(ss_pq, sizeof(ss_pq));
+    return result;
+}
+
+/* Decapsulate */
+int crypto_kem_dec(unsigned char *ss, const unsigned char *ct, const unsigned char *sk)
+{
+    unsigned char ss_classical[hybrid_classical_BYTES];
+    unsigned char ss_pq[hybrid_pq_BYTES];
+    classical_job_t job = { CLASSICAL_DEC, ss_classical, NULL, ct, sk, -1 };
+
+    if (classical_start(&job) != 0)
+        return -1;
+    int result = hybrid_pq_dec(ss_pq, ct + hybrid_classical_CIPHERTEXTBYTES, sk + hybrid_classical_SECRETKEYBYTES);
+    classical_wait();
+
+    if (result == 0 && job.result == 0)
+        result = combine(ss, ss_classical, ss_pq, ct);
+    else
+        result = -1;
+
+    OPENSSL_cleanse(ss_classical, sizeof(ss_classical));
+    OPENSSL_cleanse(ss_pq, sizeof(ss_pq));
+    return result;
+}
@@ -8,21 +8,30 @@
 #define CRYPTO_CIPHERTEXTBYTES KYBER_CIPHERTEXTBYTES
 #define CRYPTO_BYTES           KYBER_SSBYTES
 
+/* Keygen coins d || z, the compact form of a secret key */
+#define CRYPTO_KEYPAIRCOINBYTES (2*KYBER_SYMBYTES)
+
 #if   (KYBER_K == 2)
 #ifdef KYBER_90S
 #define CRYPTO_ALGNAME "Kyber512-90s"
+#elif defined(KYBER_MLKEM)
+#define CRYPTO_ALGNAME "ML-KEM-512"
 #else
 #define CRYPTO_ALGNAME "Kyber512"
 #endif
 #elif (KYBER_K == 3)
 #ifdef KYBER_90S
 #define CRYPTO_ALGNAME "Kyber768-90s"
+#elif defined(KYBER_MLKEM)
+#define CRYPTO_ALGNAME "ML-KEM-768"
 #else
 #define CRYPTO_ALGNAME "Kyber768"
 #endif
 #elif (KYBER_K == 4)
 #ifdef KYBER_90S
 #define CRYPTO_ALGNAME "Kyber1024-90s"
+#elif defined(KYBER_MLKEM)
+#define CRYPTO_ALGNAME "ML-KEM-1024"
 #else
 #define CRYPTO_ALGNAME "Kyber1024"
 #endif
@@ -31,11 +40,19 @@
 #define crypto_kem_keypair KYBER_NAMESPACE(_keypair)
 int crypto_kem_keypair(unsigned char *pk, unsigned char *sk);
 
+#define crypto_kem_keypair_derand KYBER_NAMESPACE(_keypair_derand)
+int crypto_kem_keypair_derand(unsigned char *pk,
+                              unsigned char *sk,
+                              const unsigned char *coins);
+
 #define crypto_kem_enc KYBER_NAMESPACE(_enc)
 int crypto_kem_enc(unsigned char *ct,
                    unsigned char *ss,
                    const unsigned char *pk);
 
+/* With KYBER_MLKEM, decapsulation leaves out FIPS 203's decapsulation key
+   check (H(ek) against the copy cached in sk). FIPS 203 allows that for keys
+   generated locally, which are the only ones decapsulated here */
 #define crypto_kem_dec KYBER_NAMESPACE(_dec)
 int crypto_kem_dec(unsigned char *ss,
                    const unsigned char *ct,
@@ -7,9 +7,14 @@
 
 #define gen_matrix KYBER_NAMESPACE(_gen_matrix)
 void gen_matrix(polyvec *a, const uint8_t seed[KYBER_SYMBYTES], int transposed);
-#define indcpa_keypair KYBER_NAMESPACE(_indcpa_keypair)
-void indcpa_keypair(uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
-                    uint8_t sk[KYBER_INDCPA_SECRETKEYBYTES]);
+#ifdef KYBER_LOWMEM
+#define gen_matrix_row KYBER_NAMESPACE(_gen_matrix_row)
+void gen_matrix_row(polyvec *a, const uint8_t seed[KYBER_SYMBYTES], unsigned int i, int transposed);
+#endif
+#define indcpa_keypair_derand KYBER_NAMESPACE(_indcpa_keypair_derand)
+void indcpa_keypair_derand(uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
+                           uint8_t sk[KYBER_INDCPA_SECRETKEYBYTES],
+                           const uint8_t coins[KYBER_SYMBYTES]);
 
 #define indcpa_enc KYBER_NAMESPACE(_indcpa_enc)
 void indcpa_enc(uint8_t c[KYBER_INDCPA_BYTES],
@@ -6,6 +6,11 @@
 #define crypto_kem_keypair KYBER_NAMESPACE(_keypair)
 int crypto_kem_keypair(unsigned char *pk, unsigned char *sk);
 
+#define crypto_kem_keypair_derand KYBER_NAMESPACE(_keypair_derand)
+int crypto_kem_keypair_derand(unsigned char *pk,
+                              unsigned char *sk,
+                              const unsigned char *coins);
+
 #define crypto_kem_enc KYBER_NAMESPACE(_enc)
 int crypto_kem_enc(unsigned char *ct,
                    unsigned char *ss,
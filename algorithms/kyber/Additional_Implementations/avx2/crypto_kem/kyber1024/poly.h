@@ -52,6 +52,7 @@ void poly_getnoise_eta1_4x(poly *r0,
                      uint8_t nonce1,
                      uint8_t nonce2,
                      uint8_t nonce3);
+#define poly_getnoise_eta1122_4x KYBER_NAMESPACE(_poly_getnoise_eta1122_4x)
 void poly_getnoise_eta1122_4x(poly *r0,
                      poly *r1,
                      poly *r2,
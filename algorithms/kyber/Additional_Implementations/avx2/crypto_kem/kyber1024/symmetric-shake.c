@@ -58,3 +58,33 @@ void kyber_shake256_prf(uint8_t *out,
 
   shake256(out, outlen, extkey, sizeof(extkey));
 }
+
+#ifdef KYBER_MLKEM
+/*************************************************
+* Name:        kyber_shake256_rkprf
+*
+* Description: Usage of SHAKE256 as the rejection-key PRF J of FIPS 203,
+*              concatenates secret and public input and then generates
+*              KYBER_SSBYTES bytes of SHAKE256 output
+*
+* Arguments:   - uint8_t *out:         pointer to output
+*              - const uint8_t *key:   pointer to the key
+*                                      (of length KYBER_SYMBYTES)
+*              - const uint8_t *input: pointer to the cipher text
+*                                      (of length KYBER_CIPHERTEXTBYTES)
+**************************************************/
+void kyber_shake256_rkprf(uint8_t out[KYBER_SSBYTES],
+                          const uint8_t key[KYBER_SYMBYTES],
+                          const uint8_t input[KYBER_CIPHERTEXTBYTES])
+{
+  unsigned int i;
+  uint8_t extkey[KYBER_SYMBYTES+KYBER_CIPHERTEXTBYTES];
+
+  for(i=0;i<KYBER_SYMBYTES;i++)
+    extkey[i] = key[i];
+  for(i=0;i<KYBER_CIPHERTEXTBYTES;i++)
+    extkey[KYBER_SYMBYTES+i] = input[i];
+
+  shake256(out, KYBER_SSBYTES, extkey, sizeof(extkey));
+}
+#endif
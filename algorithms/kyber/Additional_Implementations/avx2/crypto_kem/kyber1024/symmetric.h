@@ -58,6 +58,15 @@ void kyber_shake256_prf(uint8_t *out,
         kyber_shake256_prf(OUT, OUTBYTES, KEY, NONCE)
 #define kdf(OUT, IN, INBYTES) shake256(OUT, KYBER_SSBYTES, IN, INBYTES)
 
+#ifdef KYBER_MLKEM
+#define kyber_shake256_rkprf KYBER_NAMESPACE(_kyber_shake256_rkprf)
+void kyber_shake256_rkprf(uint8_t out[KYBER_SSBYTES],
+                          const uint8_t key[KYBER_SYMBYTES],
+                          const uint8_t input[KYBER_CIPHERTEXTBYTES]);
+
+#define rkprf(OUT, KEY, INPUT) kyber_shake256_rkprf(OUT, KEY, INPUT)
+#endif
+
 #endif /* KYBER_90S */
 
 #endif /* SYMMETRIC_H */
@@ -476,31 +476,102 @@ void gen_matrix(polyvec *a, const uint8_t seed[32], int transposed)
 #endif
 #endif
 
+#ifdef KYBER_LOWMEM
 /*************************************************
-* Name:        indcpa_keypair
+* Name:        gen_matrix_row
+*
+* Description: Deterministically generate row i of matrix A (or of the
+*              transpose of A) from a seed, one entry per lane of the 4-way
+*              Keccak. Lanes beyond KYBER_K are sampled into a spare
+*              polynomial and dropped, so Kyber512 and Kyber768 permute a
+*              little more than gen_matrix does. indcpa_keypair_derand and
+*              indcpa_enc call this right before multiplying each row, so
+*              only one row of the matrix is ever on the stack
+*
+* Arguments:   - polyvec *a: pointer to output row
+*              - const uint8_t *seed: pointer to input seed
+*              - unsigned int i: index of the row
+*              - int transposed: boolean deciding whether A or A^T is generated
+**************************************************/
+void gen_matrix_row(polyvec *a, const uint8_t seed[32], unsigned int i, int transposed)
+{
+  unsigned int j, done;
+  unsigned int ctr[4];
+  __attribute__((aligned(32)))
+  uint8_t buf[4][(GEN_MATRIX_NBLOCKS*XOF_BLOCKBYTES+31)/32*32];
+  __m256i f;
+  keccakx4_state state;
+  poly spare;
+  poly *r[4];
+
+  f = _mm256_load_si256((__m256i *)seed);
+  for(j=0;j<4;j++) {
+    r[j] = j < KYBER_K ? &a->vec[j] : &spare;
+    _mm256_store_si256((__m256i *)buf[j], f);
+    buf[j][KYBER_SYMBYTES+0] = transposed ? i : j;
+    buf[j][KYBER_SYMBYTES+1] = transposed ? j : i;
+  }
+
+  shake128x4_absorb(&state, buf[0], buf[1], buf[2], buf[3], KYBER_SYMBYTES+2);
+  shake128x4_squeezeblocks(buf[0], buf[1], buf[2], buf[3], GEN_MATRIX_NBLOCKS,
+                           &state);
+
+  for(j=0;j<4;j++)
+    ctr[j] = rej_uniform_avx(r[j]->coeffs, buf[j]);
+
+  // Only the row's own lanes have to be complete
+  for(;;) {
+    done = 1;
+    for(j=0;j<KYBER_K;j++)
+      done &= ctr[j] >= KYBER_N;
+    if(done)
+      break;
+
+    shake128x4_squeezeblocks(buf[0], buf[1], buf[2], buf[3], 1, &state);
+    for(j=0;j<KYBER_K;j++)
+      ctr[j] += rej_uniform(r[j]->coeffs + ctr[j], KYBER_N - ctr[j], buf[j],
+                            XOF_BLOCKBYTES);
+  }
+
+  for(j=0;j<KYBER_K;j++)
+    poly_nttunpack(r[j]);
+}
+#endif
+
+/*************************************************
+* Name:        indcpa_keypair_derand
 *
 * Description: Generates public and private key for the CPA-secure
-*              public-key encryption scheme underlying Kyber
+*              public-key encryption scheme underlying Kyber,
+*              deterministically from coins
 *
 * Arguments:   - uint8_t *pk: pointer to output public key
 *                             (of length KYBER_INDCPA_PUBLICKEYBYTES bytes)
 *              - uint8_t *sk: pointer to output private key
                               (of length KYBER_INDCPA_SECRETKEYBYTES bytes)
+*              - const uint8_t *coins: pointer to input randomness
+*                             (of length KYBER_SYMBYTES bytes)
 **************************************************/
-void indcpa_keypair(uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
-                    uint8_t sk[KYBER_INDCPA_SECRETKEYBYTES])
+void indcpa_keypair_derand(uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
+                           uint8_t sk[KYBER_INDCPA_SECRETKEYBYTES],
+                           const uint8_t coins[KYBER_SYMBYTES])
 {
   unsigned int i;
   __attribute__((aligned(32)))
   uint8_t buf[2*KYBER_SYMBYTES];
   const uint8_t *publicseed = buf;
   const uint8_t *noiseseed = buf+KYBER_SYMBYTES;
+#ifdef KYBER_LOWMEM
+  polyvec a, e, pkpv, skpv;
+#else
   polyvec a[KYBER_K], e, pkpv, skpv;
+#endif
 
-  randombytes(buf, KYBER_SYMBYTES);
-  hash_g(buf, buf, KYBER_SYMBYTES);
+  hash_g(buf, coins, KYBER_SYMBYTES);
 
+#ifndef KYBER_LOWMEM
   gen_a(a, publicseed);
+#endif
 
 #ifdef KYBER_90S
 #define NBLOCKS ((2*KYBER_ETA1*32)/AES256CTR_BLOCKBYTES ) /* Assumes divisibility */
@@ -508,19 +579,19 @@ void indcpa_keypair(uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
   uint64_t nonce = 0;
   aes256ctr_ctx state;
   __attribute__((aligned(32)))
-  uint8_t coins[AES256CTR_BLOCKBYTES*NBLOCKS+2]; /* +2 as required by cbd3 */
+  uint8_t coinbuf[AES256CTR_BLOCKBYTES*NBLOCKS+2]; /* +2 as required by cbd3 */
   aes256ctr_init(&state, noiseseed, nonce++);
   for(i=0;i<KYBER_K;i++) {
-    aes256ctr_squeezeblocks(coins, NBLOCKS, &state);
+    aes256ctr_squeezeblocks(coinbuf, NBLOCKS, &state);
     state.n = _mm_loadl_epi64((__m128i *)&nonce);
     nonce++;
-    cbd_eta1(&skpv.vec[i], coins);
+    cbd_eta1(&skpv.vec[i], coinbuf);
   }
   for(i=0;i<KYBER_K;i++) {
-    aes256ctr_squeezeblocks(coins, NBLOCKS, &state);
+    aes256ctr_squeezeblocks(coinbuf, NBLOCKS, &state);
     state.n = _mm_loadl_epi64((__m128i *)&nonce);
     nonce++;
-    cbd_eta1(&e.vec[i], coins);
+    cbd_eta1(&e.vec[i], coinbuf);
   }
 #else
 #if KYBER_K == 2
@@ -553,7 +624,12 @@ void indcpa_keypair(uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
 
   // matrix-vector multiplication
   for(i=0;i<KYBER_K;i++) {
+#ifdef KYBER_LOWMEM
+    gen_matrix_row(&a, publicseed, i, 0);
+    polyvec_pointwise_acc_montgomery(&pkpv.vec[i], &a, &skpv);
+#else
     polyvec_pointwise_acc_montgomery(&pkpv.vec[i], &a[i], &skpv);
+#endif
     poly_tomont(&pkpv.vec[i]);
   }
 
@@ -589,12 +665,18 @@ void indcpa_enc(uint8_t c[KYBER_INDCPA_BYTES],
   unsigned int i;
   __attribute__((aligned(32)))
   uint8_t seed[KYBER_SYMBYTES];
+#ifdef KYBER_LOWMEM
+  polyvec sp, pkpv, ep, at, bp;
+#else
   polyvec sp, pkpv, ep, at[KYBER_K], bp;
+#endif
   poly v, k, epp;
 
   unpack_pk(&pkpv, seed, pk);
   poly_frommsg(&k, m);
+#ifndef KYBER_LOWMEM
   gen_at(at, seed);
+#endif
 
 #ifdef KYBER_90S
 #define NBLOCKS ((2*KYBER_ETA1*32)/AES256CTR_BLOCKBYTES ) /* Assumes divisibility */
@@ -649,8 +731,14 @@ void indcpa_enc(uint8_t c[KYBER_INDCPA_BYTES],
   polyvec_ntt(&sp);
 
   // matrix-vector multiplication
-  for(i=0;i<KYBER_K;i++)
+  for(i=0;i<KYBER_K;i++) {
+#ifdef KYBER_LOWMEM
+    gen_matrix_row(&at, seed, i, 1);
+    polyvec_pointwise_acc_montgomery(&bp.vec[i], &at, &sp);
+#else
     polyvec_pointwise_acc_montgomery(&bp.vec[i], &at[i], &sp);
+#endif
+  }
   polyvec_pointwise_acc_montgomery(&v, &pkpv, &sp);
 
   polyvec_invntt_tomont(&bp);
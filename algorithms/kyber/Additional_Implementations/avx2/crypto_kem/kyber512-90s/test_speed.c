@@ -108,9 +108,9 @@ int main()
 
   for(i=0;i<NTESTS;i++) {
     t[i] = cpucycles();
-    indcpa_keypair(pk, sk);
+    indcpa_keypair_derand(pk, sk, seed);
   }
-  print_results("indcpa_keypair: ", t, NTESTS);
+  print_results("indcpa_keypair_derand: ", t, NTESTS);
 
   for(i=0;i<NTESTS;i++) {
     t[i] = cpucycles();
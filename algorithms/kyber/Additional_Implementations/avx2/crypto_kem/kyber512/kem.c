@@ -6,32 +6,63 @@
 #include "symmetric.h"
 #include "verify.h"
 #include "indcpa.h"
+#include "polyvec.h"
 
 /*************************************************
-* Name:        crypto_kem_keypair
+* Name:        crypto_kem_keypair_derand
 *
 * Description: Generates public and private key
 *              for CCA-secure Kyber key encapsulation mechanism
+*              deterministically from coins d || z. Nothing else goes into
+*              the keys, so the coins are a compact form of the secret key
+*              that this function expands again
 *
 * Arguments:   - unsigned char *pk: pointer to output public key
 *                (an already allocated array of CRYPTO_PUBLICKEYBYTES bytes)
 *              - unsigned char *sk: pointer to output private key
 *                (an already allocated array of CRYPTO_SECRETKEYBYTES bytes)
+*              - const unsigned char *coins: pointer to input randomness
+*                (an already allocated array of CRYPTO_KEYPAIRCOINBYTES bytes)
 *
 * Returns 0 (success)
 **************************************************/
-int crypto_kem_keypair(unsigned char *pk, unsigned char *sk)
+int crypto_kem_keypair_derand(unsigned char *pk,
+                              unsigned char *sk,
+                              const unsigned char *coins)
 {
   size_t i;
-  indcpa_keypair(pk, sk);
+  indcpa_keypair_derand(pk, sk, coins);
   for(i=0;i<KYBER_INDCPA_PUBLICKEYBYTES;i++)
     sk[i+KYBER_INDCPA_SECRETKEYBYTES] = pk[i];
   hash_h(sk+KYBER_SECRETKEYBYTES-2*KYBER_SYMBYTES, pk, KYBER_PUBLICKEYBYTES);
   /* Value z for pseudo-random output on reject */
-  randombytes(sk+KYBER_SECRETKEYBYTES-KYBER_SYMBYTES, KYBER_SYMBYTES);
+  for(i=0;i<KYBER_SYMBYTES;i++)
+    sk[i+KYBER_SECRETKEYBYTES-KYBER_SYMBYTES] = coins[i+KYBER_SYMBYTES];
   return 0;
 }
 
+/*************************************************
+* Name:        crypto_kem_keypair
+*
+* Description: Generates public and private key
+*              for CCA-secure Kyber key encapsulation mechanism
+*
+* Arguments:   - unsigned char *pk: pointer to output public key
+*                (an already allocated array of CRYPTO_PUBLICKEYBYTES bytes)
+*              - unsigned char *sk: pointer to output private key
+*                (an already allocated array of CRYPTO_SECRETKEYBYTES bytes)
+*
+* Returns 0 (success)
+**************************************************/
+int crypto_kem_keypair(unsigned char *pk, unsigned char *sk)
+{
+  uint8_t coins[2*KYBER_SYMBYTES];
+  /* d, then z, drawn separately as before so the KATs are unchanged */
+  randombytes(coins, KYBER_SYMBYTES);
+  randombytes(coins+KYBER_SYMBYTES, KYBER_SYMBYTES);
+  return crypto_kem_keypair_derand(pk, sk, coins);
+}
+
 /*************************************************
 * Name:        crypto_kem_enc
 *
@@ -45,21 +76,32 @@ int crypto_kem_keypair(unsigned char *pk, unsigned char *sk)
 *              - const unsigned char *pk: pointer to input public key
 *                (an already allocated array of CRYPTO_PUBLICKEYBYTES bytes)
 *
-* Returns 0 (success)
+* Returns 0 on success, -1 if ML-KEM's modulus check rejects the public key
 **************************************************/
 int crypto_kem_enc(unsigned char *ct,
                    unsigned char *ss,
                    const unsigned char *pk)
 {
+#ifdef KYBER_MLKEM
+  size_t i;
+#endif
   __attribute__((aligned(32)))
   uint8_t buf[2*KYBER_SYMBYTES];
   /* Will contain key, coins */
   __attribute__((aligned(32)))
   uint8_t kr[2*KYBER_SYMBYTES];
 
+#ifdef KYBER_MLKEM
+  /* FIPS 203 input check, the encoded t must have every coefficient below q */
+  if(polyvec_check_modulus(pk))
+    return -1;
+#endif
+
   randombytes(buf, KYBER_SYMBYTES);
+#ifndef KYBER_MLKEM
   /* Don't release system RNG output */
   hash_h(buf, buf, KYBER_SYMBYTES);
+#endif
 
   /* Multitarget countermeasure for coins + contributory KEM */
   hash_h(buf+KYBER_SYMBYTES, pk, KYBER_PUBLICKEYBYTES);
@@ -68,10 +110,16 @@ int crypto_kem_enc(unsigned char *ct,
   /* coins are in kr+KYBER_SYMBYTES */
   indcpa_enc(ct, buf, pk, kr+KYBER_SYMBYTES);
 
+#ifdef KYBER_MLKEM
+  /* FIPS 203 takes the key from G as is, without hashing in H(c) */
+  for(i=0;i<KYBER_SSBYTES;i++)
+    ss[i] = kr[i];
+#else
   /* overwrite coins in kr with H(c) */
   hash_h(kr+KYBER_SYMBYTES, ct, KYBER_CIPHERTEXTBYTES);
   /* hash concatenation of pre-k and H(c) to k */
   kdf(ss, kr, 2*KYBER_SYMBYTES);
+#endif
   return 0;
 }
 
@@ -118,6 +166,11 @@ int crypto_kem_dec(unsigned char *ss,
 
   fail = verify(ct, cmp, KYBER_CIPHERTEXTBYTES);
 
+#ifdef KYBER_MLKEM
+  /* Rejection key J(z || c), replaced by the key from G unless re-encryption failed */
+  rkprf(ss, sk+KYBER_SECRETKEYBYTES-KYBER_SYMBYTES, ct);
+  cmov(ss, kr, KYBER_SYMBYTES, !fail);
+#else
   /* overwrite coins in kr with H(c) */
   hash_h(kr+KYBER_SYMBYTES, ct, KYBER_CIPHERTEXTBYTES);
 
@@ -126,5 +179,6 @@ int crypto_kem_dec(unsigned char *ss,
 
   /* hash concatenation of pre-k and H(c) to k */
   kdf(ss, kr, 2*KYBER_SYMBYTES);
+#endif
   return 0;
 }
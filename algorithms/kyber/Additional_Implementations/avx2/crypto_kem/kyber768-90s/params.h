@@ -6,23 +6,34 @@
 #endif
 
 //#define KYBER_90S	/* Uncomment this if you want the 90S variant */
+//#define KYBER_LOWMEM	/* Uncomment this to generate the matrix row by row, see indcpa.c */
+
+#if defined(KYBER_90S) && defined(KYBER_LOWMEM)
+#error "KYBER_LOWMEM is only implemented for the SHAKE variant"
+#endif
 
 /* Don't change parameters below this line */
 #if   (KYBER_K == 2)
 #ifdef KYBER_90S
 #define KYBER_NAMESPACE(s) pqcrystals_kyber512_90s_avx2##s
+#elif defined(KYBER_LOWMEM)
+#define KYBER_NAMESPACE(s) pqcrystals_kyber512_lowmem_avx2##s
 #else
 #define KYBER_NAMESPACE(s) pqcrystals_kyber512_avx2##s
 #endif
 #elif (KYBER_K == 3)
 #ifdef KYBER_90S
 #define KYBER_NAMESPACE(s) pqcrystals_kyber768_90s_avx2##s
+#elif defined(KYBER_LOWMEM)
+#define KYBER_NAMESPACE(s) pqcrystals_kyber768_lowmem_avx2##s
 #else
 #define KYBER_NAMESPACE(s) pqcrystals_kyber768_avx2##s
 #endif
 #elif (KYBER_K == 4)
 #ifdef KYBER_90S
 #define KYBER_NAMESPACE(s) pqcrystals_kyber1024_90s_avx2##s
+#elif defined(KYBER_LOWMEM)
+#define KYBER_NAMESPACE(s) pqcrystals_kyber1024_lowmem_avx2##s
 #else
 #define KYBER_NAMESPACE(s) pqcrystals_kyber1024_avx2##s
 #endif
@@ -18,6 +18,8 @@ void polyvec_decompress(polyvec *r, const uint8_t a[KYBER_POLYVECCOMPRESSEDBYTES
 void polyvec_tobytes(uint8_t r[KYBER_POLYVECBYTES], polyvec *a);
 #define polyvec_frombytes KYBER_NAMESPACE(_polyvec_frombytes)
 void polyvec_frombytes(polyvec *r, const uint8_t a[KYBER_POLYVECBYTES]);
+#define polyvec_check_modulus KYBER_NAMESPACE(_polyvec_check_modulus)
+int polyvec_check_modulus(const uint8_t a[KYBER_POLYVECBYTES]);
 
 #define polyvec_ntt KYBER_NAMESPACE(_polyvec_ntt)
 void polyvec_ntt(polyvec *r);
@@ -6,12 +6,35 @@
 //
 
 #include <string.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <sys/random.h>
 #include "rng.h"
 #include <openssl/conf.h>
 #include <openssl/evp.h>
 #include <openssl/err.h>
 
-AES256_CTR_DRBG_struct  DRBG_ctx;
+#define RNG_OS_SEED_BYTES 48
+
+// Each thread owns its DRBG; generation 0 means the DRBG was never seeded
+static __thread AES256_CTR_DRBG_struct  DRBG_ctx;
+static __thread unsigned long           DRBG_generation;
+
+// Bumped in the child after fork() so DRBGs inherited from the parent are reseeded
+static unsigned long    DRBG_fork_generation = 1;
+static pthread_once_t   DRBG_atfork_once = PTHREAD_ONCE_INIT;
+
+static void
+DRBG_atfork_child(void)
+{
+    DRBG_fork_generation++;
+}
+
+static void
+DRBG_register_atfork(void)
+{
+    pthread_atfork(NULL, NULL, DRBG_atfork_child);
+}
 
 void    AES256_ECB(unsigned char *key, unsigned char *ctr, unsigned char *buffer);
 
@@ -135,6 +158,12 @@ AES256_ECB(unsigned char *key, unsigned char *ctr, unsigned char *buffer)
     EVP_CIPHER_CTX_free(ctx);
 }
 
+/*
+ randombytes_init()
+    Seeds the calling thread's DRBG. KAT generators call this with a fixed
+    entropy_input; threads that never call it are seeded from the OS on
+    their first randombytes() call.
+ */
 void
 randombytes_init(unsigned char *entropy_input,
                  unsigned char *personalization_string,
@@ -142,6 +171,7 @@ randombytes_init(unsigned char *entropy_input,
 {
     unsigned char   seed_material[48];
 
+    pthread_once(&DRBG_atfork_once, DRBG_register_atfork);
     memcpy(seed_material, entropy_input, 48);
     if (personalization_string)
         for (int i=0; i<48; i++)
@@ -150,6 +180,17 @@ randombytes_init(unsigned char *entropy_input,
     memset(DRBG_ctx.V, 0x00, 16);
     AES256_CTR_DRBG_Update(seed_material, DRBG_ctx.Key, DRBG_ctx.V);
     DRBG_ctx.reseed_counter = 1;
+    DRBG_generation = DRBG_fork_generation;
+}
+
+static void
+randombytes_init_from_os(void)
+{
+    unsigned char   entropy_input[RNG_OS_SEED_BYTES];
+
+    if ( getentropy(entropy_input, RNG_OS_SEED_BYTES) != 0 )
+        abort();
+    randombytes_init(entropy_input, NULL, 256);
 }
 
 int
@@ -158,6 +199,9 @@ randombytes(unsigned char *x, unsigned long long xlen)
     unsigned char   block[16];
     int             i = 0;
 
+    if ( DRBG_generation != DRBG_fork_generation )
+        randombytes_init_from_os();
+
     while ( xlen > 0 ) {
         //increment V
         for (int j=15; j>=0; j--) {
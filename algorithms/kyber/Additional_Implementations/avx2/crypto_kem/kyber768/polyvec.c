@@ -224,6 +224,32 @@ void polyvec_frombytes(polyvec *r, const uint8_t a[KYBER_POLYVECBYTES])
     poly_frombytes(&r->vec[i], a+i*KYBER_POLYBYTES);
 }
 
+/*************************************************
+* Name:        polyvec_check_modulus
+*
+* Description: Modulus check of FIPS 203 on a serialized vector of
+*              polynomials: ByteEncode12(ByteDecode12(a)) == a holds
+*              exactly when every 12-bit coefficient is below q
+*
+* Arguments:   - const uint8_t *a: pointer to input byte array
+*                                  (of length KYBER_POLYVECBYTES)
+*
+* Returns 0 if every coefficient is below q, -1 otherwise
+**************************************************/
+int polyvec_check_modulus(const uint8_t a[KYBER_POLYVECBYTES])
+{
+  unsigned int i;
+  uint16_t t0, t1;
+
+  for(i=0;i<KYBER_POLYVECBYTES/3;i++) {
+    t0 = (a[3*i+0] >> 0) | ((uint16_t)(a[3*i+1] & 0xF) << 8);
+    t1 = (a[3*i+1] >> 4) | ((uint16_t)a[3*i+2] << 4);
+    if(t0 >= KYBER_Q || t1 >= KYBER_Q)
+      return -1;
+  }
+  return 0;
+}
+
 /*************************************************
 * Name:        polyvec_ntt
 *
@@ -0,0 +1,178 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <immintrin.h>
+#include "fips202.h"
+#include "fips202x8.h"
+
+/*
+ * Eight-way SHAKE on AVX-512F: the 25 lanes of the Keccak state are 512-bit
+ * vectors holding one 64-bit word of each of eight independent instances.
+ * Rotations are vprolvq and the three-input XORs of theta and the
+ * not-and-xor of chi are single vpternlogq instructions.
+ */
+
+static const uint64_t KeccakF_RoundConstants[24] = {
+  0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808aULL,
+  0x8000000080008000ULL, 0x000000000000808bULL, 0x0000000080000001ULL,
+  0x8000000080008081ULL, 0x8000000000008009ULL, 0x000000000000008aULL,
+  0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000aULL,
+  0x000000008000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL,
+  0x8000000000008003ULL, 0x8000000000008002ULL, 0x8000000000000080ULL,
+  0x000000000000800aULL, 0x800000008000000aULL, 0x8000000080008081ULL,
+  0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL
+};
+
+/* Rotation offsets of rho, indexed by x+5y */
+static const uint8_t KeccakF_RhoOffsets[25] = {
+   0,  1, 62, 28, 27,
+  36, 44,  6, 55, 20,
+   3, 10, 43, 25, 39,
+  41, 45, 15, 21,  8,
+  18,  2, 61, 56, 14
+};
+
+#define ROL(a, n) _mm512_rolv_epi64(a, _mm512_set1_epi64(n))
+#define XOR3(a, b, c) _mm512_ternarylogic_epi64(a, b, c, 0x96)
+/* a ^ (~b & c) */
+#define XORANDN(a, b, c) _mm512_ternarylogic_epi64(a, b, c, 0xD2)
+
+/*************************************************
+* Name:        KeccakF1600_StatePermute8x
+*
+* Description: The Keccak F1600 Permutation on eight states at once
+*
+* Arguments:   - __m512i *s: pointer to input/output Keccak states
+**************************************************/
+static void KeccakF1600_StatePermute8x(__m512i s[25])
+{
+  unsigned int round, x, y;
+  __m512i B[25], C[5], D[5];
+
+  for(round = 0; round < 24; ++round) {
+    // theta
+    for(x = 0; x < 5; ++x)
+      C[x] = XOR3(XOR3(s[x], s[x+5], s[x+10]), s[x+15], s[x+20]);
+    for(x = 0; x < 5; ++x)
+      D[x] = _mm512_xor_si512(C[(x+4)%5], ROL(C[(x+1)%5], 1));
+
+    // rho and pi
+    for(y = 0; y < 5; ++y)
+      for(x = 0; x < 5; ++x)
+        B[y + 5*((2*x + 3*y)%5)] = ROL(_mm512_xor_si512(s[x+5*y], D[x]),
+                                       KeccakF_RhoOffsets[x+5*y]);
+
+    // chi
+    for(y = 0; y < 5; ++y)
+      for(x = 0; x < 5; ++x)
+        s[x+5*y] = XORANDN(B[x+5*y], B[(x+1)%5+5*y], B[(x+2)%5+5*y]);
+
+    // iota
+    s[0] = _mm512_xor_si512(s[0], _mm512_set1_epi64(KeccakF_RoundConstants[round]));
+  }
+}
+
+static inline void store64(uint8_t x[8], uint64_t u) {
+  unsigned int i;
+
+  for(i=0;i<8;i++)
+    x[i] = u >> 8*i;
+}
+
+static void keccakx8_absorb(__m512i s[25],
+                            unsigned int r,
+                            const uint8_t *in[8],
+                            size_t inlen,
+                            uint8_t p)
+{
+  size_t i, pos = 0;
+  __m512i t, idx;
+
+  for(i = 0; i < 25; ++i)
+    s[i] = _mm512_setzero_si512();
+
+  idx = _mm512_set_epi64((long long)in[7], (long long)in[6],
+                         (long long)in[5], (long long)in[4],
+                         (long long)in[3], (long long)in[2],
+                         (long long)in[1], (long long)in[0]);
+  while(inlen >= r) {
+    for(i = 0; i < r/8; ++i) {
+      t = _mm512_i64gather_epi64(idx, (const void *)pos, 1);
+      s[i] = _mm512_xor_si512(s[i], t);
+      pos += 8;
+    }
+
+    KeccakF1600_StatePermute8x(s);
+    inlen -= r;
+  }
+
+  i = 0;
+  while(inlen >= 8) {
+    t = _mm512_i64gather_epi64(idx, (const void *)pos, 1);
+    s[i] = _mm512_xor_si512(s[i], t);
+
+    i++;
+    pos += 8;
+    inlen -= 8;
+  }
+
+  if(inlen) {
+    t = _mm512_i64gather_epi64(idx, (const void *)pos, 1);
+    t = _mm512_and_si512(t, _mm512_set1_epi64((1ULL << (8*inlen)) - 1));
+    s[i] = _mm512_xor_si512(s[i], t);
+  }
+
+  t = _mm512_set1_epi64((uint64_t)p << 8*inlen);
+  s[i] = _mm512_xor_si512(s[i], t);
+  t = _mm512_set1_epi64(1ULL << 63);
+  s[r/8 - 1] = _mm512_xor_si512(s[r/8 - 1], t);
+}
+
+static void keccakx8_squeezeblocks(uint8_t *out[8],
+                                   size_t nblocks,
+                                   unsigned int r,
+                                   __m512i s[25])
+{
+  unsigned int i, j;
+  uint64_t f[8];
+  size_t pos = 0;
+
+  while(nblocks > 0) {
+    KeccakF1600_StatePermute8x(s);
+    for(i = 0; i < r/8; ++i) {
+      _mm512_storeu_si512((__m512i *)f, s[i]);
+      for(j = 0; j < 8; ++j)
+        store64(out[j] + pos, f[j]);
+      pos += 8;
+    }
+
+    --nblocks;
+  }
+}
+
+void shake128x8_absorb(keccakx8_state *state,
+                       const uint8_t *in[8],
+                       size_t inlen)
+{
+  keccakx8_absorb(state->s, SHAKE128_RATE, in, inlen, 0x1F);
+}
+
+void shake128x8_squeezeblocks(uint8_t *out[8],
+                              size_t nblocks,
+                              keccakx8_state *state)
+{
+  keccakx8_squeezeblocks(out, nblocks, SHAKE128_RATE, state->s);
+}
+
+void shake256x8_absorb(keccakx8_state *state,
+                       const uint8_t *in[8],
+                       size_t inlen)
+{
+  keccakx8_absorb(state->s, SHAKE256_RATE, in, inlen, 0x1F);
+}
+
+void shake256x8_squeezeblocks(uint8_t *out[8],
+                              size_t nblocks,
+                              keccakx8_state *state)
+{
+  keccakx8_squeezeblocks(out, nblocks, SHAKE256_RATE, state->s);
+}
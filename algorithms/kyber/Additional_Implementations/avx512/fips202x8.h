@@ -0,0 +1,35 @@
+#ifndef FIPS202X8_H
+#define FIPS202X8_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <immintrin.h>
+
+#define FIPS202X8_NAMESPACE(s) pqcrystals_fips202x8_avx512##s
+
+/* Eight Keccak states, lane i of each vector belongs to instance i */
+typedef struct {
+  __m512i s[25];
+} keccakx8_state;
+
+#define shake128x8_absorb FIPS202X8_NAMESPACE(_shake128x8_absorb)
+void shake128x8_absorb(keccakx8_state *state,
+                       const uint8_t *in[8],
+                       size_t inlen);
+
+#define shake128x8_squeezeblocks FIPS202X8_NAMESPACE(_shake128x8_squeezeblocks)
+void shake128x8_squeezeblocks(uint8_t *out[8],
+                              size_t nblocks,
+                              keccakx8_state *state);
+
+#define shake256x8_absorb FIPS202X8_NAMESPACE(_shake256x8_absorb)
+void shake256x8_absorb(keccakx8_state *state,
+                       const uint8_t *in[8],
+                       size_t inlen);
+
+#define shake256x8_squeezeblocks FIPS202X8_NAMESPACE(_shake256x8_squeezeblocks)
+void shake256x8_squeezeblocks(uint8_t *out[8],
+                              size_t nblocks,
+                              keccakx8_state *state);
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef FQ512_H
+#define FQ512_H
+
+#include <stdint.h>
+#include <immintrin.h>
+#include "params.h"
+#include "reduce.h"
+
+/*
+ * 32-way versions of the reductions in reduce.c. Each one performs the same
+ * 16-bit operations as its scalar counterpart, including wrap-around, so
+ * every coefficient comes out bit-for-bit identical to the Optimized build.
+ */
+
+/* montgomery_reduce(a*b): the low halves of a*b and u*q cancel, so the
+ * result is the difference of the high halves */
+static inline __m512i fqmul512(__m512i a, __m512i b)
+{
+  __m512i lo = _mm512_mullo_epi16(a, b);
+  __m512i hi = _mm512_mulhi_epi16(a, b);
+  __m512i u = _mm512_mullo_epi16(lo, _mm512_set1_epi16((int16_t)QINV));
+  return _mm512_sub_epi16(hi, _mm512_mulhi_epi16(u, _mm512_set1_epi16(KYBER_Q)));
+}
+
+/* barrett_reduce(a): (v*a) >> 26 taken as the high half shifted by 10 */
+static inline __m512i barrett512(__m512i a)
+{
+  const int16_t v = ((1U << 26) + KYBER_Q/2)/KYBER_Q;
+  __m512i t = _mm512_srai_epi16(_mm512_mulhi_epi16(a, _mm512_set1_epi16(v)), 10);
+  return _mm512_sub_epi16(a, _mm512_mullo_epi16(t, _mm512_set1_epi16(KYBER_Q)));
+}
+
+/* csubq(a) */
+static inline __m512i csubq512(__m512i a)
+{
+  const __m512i q = _mm512_set1_epi16(KYBER_Q);
+  a = _mm512_sub_epi16(a, q);
+  return _mm512_add_epi16(a, _mm512_and_si512(_mm512_srai_epi16(a, 15), q));
+}
+
+#endif
@@ -0,0 +1,493 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "params.h"
+#include "indcpa.h"
+#include "poly.h"
+#include "polyvec.h"
+#include "rng.h"
+#include "ntt.h"
+#include "symmetric.h"
+#include "cbd.h"
+#include "fips202x8.h"
+#include "rejsample.h"
+
+/*************************************************
+* Name:        pack_pk
+*
+* Description: Serialize the public key as concatenation of the
+*              serialized vector of polynomials pk
+*              and the public seed used to generate the matrix A.
+*
+* Arguments:   uint8_t *r:          pointer to the output serialized public key
+*              polyvec *pk:         pointer to the input public-key polyvec
+*              const uint8_t *seed: pointer to the input public seed
+**************************************************/
+static void pack_pk(uint8_t r[KYBER_INDCPA_PUBLICKEYBYTES],
+                    polyvec *pk,
+                    const uint8_t seed[KYBER_SYMBYTES])
+{
+  size_t i;
+  polyvec_tobytes(r, pk);
+  for(i=0;i<KYBER_SYMBYTES;i++)
+    r[i+KYBER_POLYVECBYTES] = seed[i];
+}
+
+/*************************************************
+* Name:        unpack_pk
+*
+* Description: De-serialize public key from a byte array;
+*              approximate inverse of pack_pk
+*
+* Arguments:   - polyvec *pk:             pointer to output public-key
+*                                         polynomial vector
+*              - uint8_t *seed:           pointer to output seed to generate
+*                                         matrix A
+*              - const uint8_t *packedpk: pointer to input serialized public key
+**************************************************/
+static void unpack_pk(polyvec *pk,
+                      uint8_t seed[KYBER_SYMBYTES],
+                      const uint8_t packedpk[KYBER_INDCPA_PUBLICKEYBYTES])
+{
+  size_t i;
+  polyvec_frombytes(pk, packedpk);
+  for(i=0;i<KYBER_SYMBYTES;i++)
+    seed[i] = packedpk[i+KYBER_POLYVECBYTES];
+}
+
+/*************************************************
+* Name:        pack_sk
+*
+* Description: Serialize the secret key
+*
+* Arguments:   - uint8_t *r:  pointer to output serialized secret key
+*              - polyvec *sk: pointer to input vector of polynomials (secret key)
+**************************************************/
+static void pack_sk(uint8_t r[KYBER_INDCPA_SECRETKEYBYTES], polyvec *sk)
+{
+  polyvec_tobytes(r, sk);
+}
+
+/*************************************************
+* Name:        unpack_sk
+*
+* Description: De-serialize the secret key;
+*              inverse of pack_sk
+*
+* Arguments:   - polyvec *sk:             pointer to output vector of
+*                                         polynomials (secret key)
+*              - const uint8_t *packedsk: pointer to input serialized secret key
+**************************************************/
+static void unpack_sk(polyvec *sk,
+                      const uint8_t packedsk[KYBER_INDCPA_SECRETKEYBYTES])
+{
+  polyvec_frombytes(sk, packedsk);
+}
+
+/*************************************************
+* Name:        pack_ciphertext
+*
+* Description: Serialize the ciphertext as concatenation of the
+*              compressed and serialized vector of polynomials b
+*              and the compressed and serialized polynomial v
+*
+* Arguments:   uint8_t *r: pointer to the output serialized ciphertext
+*              poly *pk:   pointer to the input vector of polynomials b
+*              poly *v:    pointer to the input polynomial v
+**************************************************/
+static void pack_ciphertext(uint8_t r[KYBER_INDCPA_BYTES],
+                            polyvec *b,
+                            poly *v)
+{
+  polyvec_compress(r, b);
+  poly_compress(r+KYBER_POLYVECCOMPRESSEDBYTES, v);
+}
+
+/*************************************************
+* Name:        unpack_ciphertext
+*
+* Description: De-serialize and decompress ciphertext from a byte array;
+*              approximate inverse of pack_ciphertext
+*
+* Arguments:   - polyvec *b:       pointer to the output vector of polynomials b
+*              - poly *v:          pointer to the output polynomial v
+*              - const uint8_t *c: pointer to the input serialized ciphertext
+**************************************************/
+static void unpack_ciphertext(polyvec *b,
+                              poly *v,
+                              const uint8_t c[KYBER_INDCPA_BYTES])
+{
+  polyvec_decompress(b, c);
+  poly_decompress(v, c+KYBER_POLYVECCOMPRESSEDBYTES);
+}
+
+#if (XOF_BLOCKBYTES % 3) != 0
+#error "gen_matrix assumes XOF blocks hold a whole number of 3-byte samples"
+#endif
+
+#define gen_a(A,B)  gen_matrix(A,B,0)
+#define gen_at(A,B) gen_matrix(A,B,1)
+
+/*************************************************
+* Name:        gen_matrix
+*
+* Description: Deterministically generate matrix A (or the transpose of A)
+*              from a seed. Entries of the matrix are polynomials that look
+*              uniformly random. Performs rejection sampling on output of
+*              a XOF. Eight entries are sampled at a time with the 8-way
+*              SHAKE128, so K=4 takes two passes and K=3 one pass plus one
+*              single entry; lanes past the last entry repeat it and their
+*              output is dropped
+*
+* Arguments:   - polyvec *a:          pointer to ouptput matrix A
+*              - const uint8_t *seed: pointer to input seed
+*              - int transposed:      boolean deciding whether A or A^T
+*                                     is generated
+**************************************************/
+#define GEN_MATRIX_NBLOCKS ((12*KYBER_N/8*(1 << 12)/KYBER_Q \
+                             + XOF_BLOCKBYTES)/XOF_BLOCKBYTES)
+// Not static for benchmarking
+void gen_matrix(polyvec *a, const uint8_t seed[KYBER_SYMBYTES], int transposed)
+{
+  unsigned int i, j, k, n, e, pending;
+  unsigned int ctr[8];
+  uint8_t extseed[8][KYBER_SYMBYTES+2];
+  uint8_t buf[8][GEN_MATRIX_NBLOCKS*XOF_BLOCKBYTES] __attribute__((aligned(64)));
+  const uint8_t *in[8];
+  uint8_t *out[8];
+  int16_t *r[8];
+  keccakx8_state state;
+  xof_state state1;
+
+  for(k=0;k<KYBER_K*KYBER_K;k+=n) {
+    n = KYBER_K*KYBER_K - k < 8 ? KYBER_K*KYBER_K - k : 8;
+
+    if(n == 1) {
+      i = k/KYBER_K;
+      j = k%KYBER_K;
+      if(transposed)
+        xof_absorb(&state1, seed, i, j);
+      else
+        xof_absorb(&state1, seed, j, i);
+
+      xof_squeezeblocks(buf[0], GEN_MATRIX_NBLOCKS, &state1);
+      ctr[0] = rej_uniform_avx512(a[i].vec[j].coeffs, KYBER_N, buf[0],
+                                  GEN_MATRIX_NBLOCKS*XOF_BLOCKBYTES);
+      while(ctr[0] < KYBER_N) {
+        xof_squeezeblocks(buf[0], 1, &state1);
+        ctr[0] += rej_uniform_avx512(a[i].vec[j].coeffs + ctr[0], KYBER_N - ctr[0],
+                                     buf[0], XOF_BLOCKBYTES);
+      }
+      continue;
+    }
+
+    for(e=0;e<8;e++) {
+      i = (k + (e < n ? e : n-1))/KYBER_K;
+      j = (k + (e < n ? e : n-1))%KYBER_K;
+      memcpy(extseed[e], seed, KYBER_SYMBYTES);
+      extseed[e][KYBER_SYMBYTES+0] = transposed ? i : j;
+      extseed[e][KYBER_SYMBYTES+1] = transposed ? j : i;
+      in[e] = extseed[e];
+      out[e] = buf[e];
+      r[e] = a[i].vec[j].coeffs;
+    }
+
+    shake128x8_absorb(&state, in, KYBER_SYMBYTES+2);
+    shake128x8_squeezeblocks(out, GEN_MATRIX_NBLOCKS, &state);
+
+    pending = 0;
+    for(e=0;e<n;e++) {
+      ctr[e] = rej_uniform_avx512(r[e], KYBER_N, buf[e], GEN_MATRIX_NBLOCKS*XOF_BLOCKBYTES);
+      pending |= ctr[e] < KYBER_N;
+    }
+
+    while(pending) {
+      shake128x8_squeezeblocks(out, 1, &state);
+      pending = 0;
+      for(e=0;e<n;e++) {
+        ctr[e] += rej_uniform_avx512(r[e] + ctr[e], KYBER_N - ctr[e], buf[e], XOF_BLOCKBYTES);
+        pending |= ctr[e] < KYBER_N;
+      }
+    }
+  }
+}
+
+/*************************************************
+* Name:        poly_getnoise_8x
+*
+* Description: Samples n polynomials with consecutive nonces as
+*              poly_getnoise_eta1/poly_getnoise_eta2 do, eight at a time
+*              with the 8-way SHAKE256. All lanes squeeze enough output for
+*              KYBER_ETA1, which is a prefix-compatible superset of what
+*              KYBER_ETA2 needs
+*
+* Arguments:   - poly **r:            pointers to the output polynomials
+*              - unsigned int n:      number of polynomials
+*              - const uint8_t *seed: pointer to input seed
+*                                     (of length KYBER_SYMBYTES bytes)
+*              - uint8_t nonce:       nonce of the first polynomial
+*              - unsigned int neta1:  number of leading polynomials that
+*                                     use KYBER_ETA1, the rest use KYBER_ETA2
+**************************************************/
+#define NOISE_NBLOCKS ((KYBER_ETA1*KYBER_N/4 + SHAKE256_RATE - 1)/SHAKE256_RATE)
+static void poly_getnoise_8x(poly **r,
+                             unsigned int n,
+                             const uint8_t seed[KYBER_SYMBYTES],
+                             uint8_t nonce,
+                             unsigned int neta1)
+{
+  unsigned int k, e, m;
+  uint8_t extkey[8][KYBER_SYMBYTES+1];
+  uint8_t buf[8][NOISE_NBLOCKS*SHAKE256_RATE] __attribute__((aligned(64)));
+  const uint8_t *in[8];
+  uint8_t *out[8];
+  keccakx8_state state;
+
+  for(k=0;k<n;k+=m) {
+    m = n - k < 8 ? n - k : 8;
+
+    if(m == 1) {
+      if(k < neta1)
+        poly_getnoise_eta1(r[k], seed, nonce+k);
+      else
+        poly_getnoise_eta2(r[k], seed, nonce+k);
+      continue;
+    }
+
+    for(e=0;e<8;e++) {
+      memcpy(extkey[e], seed, KYBER_SYMBYTES);
+      extkey[e][KYBER_SYMBYTES] = nonce + k + (e < m ? e : m-1);
+      in[e] = extkey[e];
+      out[e] = buf[e];
+    }
+
+    shake256x8_absorb(&state, in, KYBER_SYMBYTES+1);
+    shake256x8_squeezeblocks(out, NOISE_NBLOCKS, &state);
+
+    for(e=0;e<m;e++) {
+      if(k+e < neta1)
+        cbd_eta1(r[k+e], buf[e]);
+      else
+        cbd_eta2(r[k+e], buf[e]);
+    }
+  }
+}
+
+/*************************************************
+* Name:        indcpa_keypair_derand
+*
+* Description: Generates public and private key for the CPA-secure
+*              public-key encryption scheme underlying Kyber,
+*              deterministically from coins
+*
+* Arguments:   - uint8_t *pk: pointer to output public key
+*                             (of length KYBER_INDCPA_PUBLICKEYBYTES bytes)
+*              - uint8_t *sk: pointer to output private key
+                              (of length KYBER_INDCPA_SECRETKEYBYTES bytes)
+*              - const uint8_t *coins: pointer to input randomness
+*                             (of length KYBER_SYMBYTES bytes)
+**************************************************/
+void indcpa_keypair_derand(uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
+                           uint8_t sk[KYBER_INDCPA_SECRETKEYBYTES],
+                           const uint8_t coins[KYBER_SYMBYTES])
+{
+  unsigned int i;
+  uint8_t buf[2*KYBER_SYMBYTES];
+  const uint8_t *publicseed = buf;
+  const uint8_t *noiseseed = buf+KYBER_SYMBYTES;
+  polyvec a[KYBER_K], e, pkpv, skpv;
+  poly *noise[2*KYBER_K];
+
+  hash_g(buf, coins, KYBER_SYMBYTES);
+
+  gen_a(a, publicseed);
+
+  for(i=0;i<KYBER_K;i++) {
+    noise[i] = &skpv.vec[i];
+    noise[KYBER_K+i] = &e.vec[i];
+  }
+  poly_getnoise_8x(noise, 2*KYBER_K, noiseseed, 0, 2*KYBER_K);
+
+  polyvec_ntt(&skpv);
+  polyvec_ntt(&e);
+
+  // matrix-vector multiplication
+  for(i=0;i<KYBER_K;i++) {
+    polyvec_pointwise_acc_montgomery(&pkpv.vec[i], &a[i], &skpv);
+    poly_tomont(&pkpv.vec[i]);
+  }
+
+  polyvec_add(&pkpv, &pkpv, &e);
+  polyvec_reduce(&pkpv);
+
+  pack_sk(sk, &skpv);
+  pack_pk(pk, &pkpv, publicseed);
+}
+
+/*************************************************
+* Name:        encrypt_polys
+*
+* Description: Encryption shared by indcpa_enc and indcpa_enc_cmp, up to
+*              (not including) compression of the ciphertext
+*
+* Arguments:   - polyvec *bp:          pointer to output vector u
+*              - poly *v:              pointer to output polynomial v
+*              - const uint8_t *m:     pointer to input message
+*                                      (of length KYBER_INDCPA_MSGBYTES bytes)
+*              - const uint8_t *pk:    pointer to input public key
+*                                      (of length KYBER_INDCPA_PUBLICKEYBYTES)
+*              - const uint8_t *coins: pointer to input random coins
+*                                      used as seed (of length KYBER_SYMBYTES)
+*                                      to deterministically generate all
+*                                      randomness
+**************************************************/
+static void encrypt_polys(polyvec *bp,
+                          poly *v,
+                          const uint8_t m[KYBER_INDCPA_MSGBYTES],
+                          const uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
+                          const uint8_t coins[KYBER_SYMBYTES])
+{
+  unsigned int i;
+  uint8_t seed[KYBER_SYMBYTES];
+  polyvec sp, pkpv, ep, at[KYBER_K];
+  poly k, epp;
+  poly *noise[2*KYBER_K+1];
+
+  unpack_pk(&pkpv, seed, pk);
+  poly_frommsg(&k, m);
+  gen_at(at, seed);
+
+  for(i=0;i<KYBER_K;i++) {
+    noise[i] = &sp.vec[i];
+    noise[KYBER_K+i] = &ep.vec[i];
+  }
+  noise[2*KYBER_K] = &epp;
+  poly_getnoise_8x(noise, 2*KYBER_K+1, coins, 0, KYBER_K);
+
+  polyvec_ntt(&sp);
+
+  // matrix-vector multiplication
+  for(i=0;i<KYBER_K;i++)
+    polyvec_pointwise_acc_montgomery(&bp->vec[i], &at[i], &sp);
+
+  polyvec_pointwise_acc_montgomery(v, &pkpv, &sp);
+
+  polyvec_invntt_tomont(bp);
+  poly_invntt_tomont(v);
+
+  polyvec_add(bp, bp, &ep);
+  poly_add(v, v, &epp);
+  poly_add(v, v, &k);
+  polyvec_reduce(bp);
+  poly_reduce(v);
+}
+
+/*************************************************
+* Name:        indcpa_enc
+*
+* Description: Encryption function of the CPA-secure
+*              public-key encryption scheme underlying Kyber.
+*
+* Arguments:   - uint8_t *c:           pointer to output ciphertext
+*                                      (of length KYBER_INDCPA_BYTES bytes)
+*              - const uint8_t *m:     pointer to input message
+*                                      (of length KYBER_INDCPA_MSGBYTES bytes)
+*              - const uint8_t *pk:    pointer to input public key
+*                                      (of length KYBER_INDCPA_PUBLICKEYBYTES)
+*              - const uint8_t *coins: pointer to input random coins
+*                                      used as seed (of length KYBER_SYMBYTES)
+*                                      to deterministically generate all
+*                                      randomness
+**************************************************/
+void indcpa_enc(uint8_t c[KYBER_INDCPA_BYTES],
+                const uint8_t m[KYBER_INDCPA_MSGBYTES],
+                const uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
+                const uint8_t coins[KYBER_SYMBYTES])
+{
+  polyvec bp;
+  poly v;
+
+  encrypt_polys(&bp, &v, m, pk, coins);
+  pack_ciphertext(c, &bp, &v);
+}
+
+/*************************************************
+* Name:        indcpa_enc_cmp
+*
+* Description: Re-encryption for decapsulation: encrypts m like indcpa_enc
+*              and compares each compressed polynomial with its part of c
+*              in constant time, without storing the re-encrypted
+*              ciphertext. Each part of c is absorbed into h right after
+*              it is compared, so c is read once for both.
+*
+* Arguments:   - const uint8_t *c:     pointer to ciphertext to compare with
+*                                      (of length KYBER_INDCPA_BYTES bytes)
+*              - const uint8_t *m:     pointer to input message
+*                                      (of length KYBER_INDCPA_MSGBYTES bytes)
+*              - const uint8_t *pk:    pointer to input public key
+*                                      (of length KYBER_INDCPA_PUBLICKEYBYTES)
+*              - const uint8_t *coins: pointer to input random coins
+*                                      (of length KYBER_SYMBYTES)
+*              - sha3_256incctx *h:    pointer to hash state c is absorbed
+*                                      into, or NULL
+*
+* Returns 0 if the re-encryption equals c, 1 otherwise (as verify)
+**************************************************/
+int indcpa_enc_cmp(const uint8_t c[KYBER_INDCPA_BYTES],
+                   const uint8_t m[KYBER_INDCPA_MSGBYTES],
+                   const uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
+                   const uint8_t coins[KYBER_SYMBYTES],
+                   sha3_256incctx *h)
+{
+  unsigned int i;
+  uint64_t rc = 0;
+  const size_t rowbytes = KYBER_POLYVECCOMPRESSEDBYTES/KYBER_K;
+  polyvec bp;
+  poly v;
+
+  encrypt_polys(&bp, &v, m, pk, coins);
+
+  for(i=0;i<KYBER_K;i++) {
+    rc |= polyvec_compress_poly_cmp(c+i*rowbytes, &bp.vec[i]);
+    if(h != NULL)
+      sha3_256_inc_absorb(h, c+i*rowbytes, rowbytes);
+  }
+  rc |= poly_compress_cmp(c+KYBER_POLYVECCOMPRESSEDBYTES, &v);
+  if(h != NULL)
+    sha3_256_inc_absorb(h, c+KYBER_POLYVECCOMPRESSEDBYTES, KYBER_POLYCOMPRESSEDBYTES);
+
+  return (-rc) >> 63;
+}
+
+/*************************************************
+* Name:        indcpa_dec
+*
+* Description: Decryption function of the CPA-secure
+*              public-key encryption scheme underlying Kyber.
+*
+* Arguments:   - uint8_t *m:        pointer to output decrypted message
+*                                   (of length KYBER_INDCPA_MSGBYTES)
+*              - const uint8_t *c:  pointer to input ciphertext
+*                                   (of length KYBER_INDCPA_BYTES)
+*              - const uint8_t *sk: pointer to input secret key
+*                                   (of length KYBER_INDCPA_SECRETKEYBYTES)
+**************************************************/
+void indcpa_dec(uint8_t m[KYBER_INDCPA_MSGBYTES],
+                const uint8_t c[KYBER_INDCPA_BYTES],
+                const uint8_t sk[KYBER_INDCPA_SECRETKEYBYTES])
+{
+  polyvec bp, skpv;
+  poly v, mp;
+
+  unpack_ciphertext(&bp, &v, c);
+  unpack_sk(&skpv, sk);
+
+  polyvec_ntt(&bp);
+  polyvec_pointwise_acc_montgomery(&mp, &skpv, &bp);
+  poly_invntt_tomont(&mp);
+
+  poly_sub(&mp, &v, &mp);
+  poly_reduce(&mp);
+
+  poly_tomsg(m, &mp);
+}
@@ -0,0 +1,265 @@
+#include <stdint.h>
+#include <immintrin.h>
+#include "params.h"
+#include "ntt.h"
+#include "reduce.h"
+#include "fq512.h"
+
+/* Code to generate zetas and zetas_inv used in the number-theoretic transform:
+
+#define KYBER_ROOT_OF_UNITY 17
+
+static const uint16_t tree[128] = {
+  0, 64, 32, 96, 16, 80, 48, 112, 8, 72, 40, 104, 24, 88, 56, 120,
+  4, 68, 36, 100, 20, 84, 52, 116, 12, 76, 44, 108, 28, 92, 60, 124,
+  2, 66, 34, 98, 18, 82, 50, 114, 10, 74, 42, 106, 26, 90, 58, 122,
+  6, 70, 38, 102, 22, 86, 54, 118, 14, 78, 46, 110, 30, 94, 62, 126,
+  1, 65, 33, 97, 17, 81, 49, 113, 9, 73, 41, 105, 25, 89, 57, 121,
+  5, 69, 37, 101, 21, 85, 53, 117, 13, 77, 45, 109, 29, 93, 61, 125,
+  3, 67, 35, 99, 19, 83, 51, 115, 11, 75, 43, 107, 27, 91, 59, 123,
+  7, 71, 39, 103, 23, 87, 55, 119, 15, 79, 47, 111, 31, 95, 63, 127
+};
+
+void init_ntt() {
+  unsigned int i, j, k;
+  int16_t tmp[128];
+
+  tmp[0] = MONT;
+  for(i = 1; i < 128; ++i)
+    tmp[i] = fqmul(tmp[i-1], KYBER_ROOT_OF_UNITY*MONT % KYBER_Q);
+
+  for(i = 0; i < 128; ++i)
+    zetas[i] = tmp[tree[i]];
+
+  k = 0;
+  for(i = 64; i >= 1; i >>= 1)
+    for(j = i; j < 2*i; ++j)
+      zetas_inv[k++] = -tmp[128 - tree[j]];
+
+  zetas_inv[127] = MONT * (MONT * (KYBER_Q - 1) * ((KYBER_Q - 1)/128) % KYBER_Q) % KYBER_Q;
+}
+
+*/
+
+const int16_t zetas[128] = {
+  2285, 2571, 2970, 1812, 1493, 1422, 287, 202, 3158, 622, 1577, 182, 962,
+  2127, 1855, 1468, 573, 2004, 264, 383, 2500, 1458, 1727, 3199, 2648, 1017,
+  732, 608, 1787, 411, 3124, 1758, 1223, 652, 2777, 1015, 2036, 1491, 3047,
+  1785, 516, 3321, 3009, 2663, 1711, 2167, 126, 1469, 2476, 3239, 3058, 830,
+  107, 1908, 3082, 2378, 2931, 961, 1821, 2604, 448, 2264, 677, 2054, 2226,
+  430, 555, 843, 2078, 871, 1550, 105, 422, 587, 177, 3094, 3038, 2869, 1574,
+  1653, 3083, 778, 1159, 3182, 2552, 1483, 2727, 1119, 1739, 644, 2457, 349,
+  418, 329, 3173, 3254, 817, 1097, 603, 610, 1322, 2044, 1864, 384, 2114, 3193,
+  1218, 1994, 2455, 220, 2142, 1670, 2144, 1799, 2051, 794, 1819, 2475, 2459,
+  478, 3221, 3021, 996, 991, 958, 1869, 1522, 1628
+};
+
+const int16_t zetas_inv[128] = {
+  1701, 1807, 1460, 2371, 2338, 2333, 308, 108, 2851, 870, 854, 1510, 2535,
+  1278, 1530, 1185, 1659, 1187, 3109, 874, 1335, 2111, 136, 1215, 2945, 1465,
+  1285, 2007, 2719, 2726, 2232, 2512, 75, 156, 3000, 2911, 2980, 872, 2685,
+  1590, 2210, 602, 1846, 777, 147, 2170, 2551, 246, 1676, 1755, 460, 291, 235,
+  3152, 2742, 2907, 3224, 1779, 2458, 1251, 2486, 2774, 2899, 1103, 1275, 2652,
+  1065, 2881, 725, 1508, 2368, 398, 951, 247, 1421, 3222, 2499, 271, 90, 853,
+  1860, 3203, 1162, 1618, 666, 320, 8, 2813, 1544, 282, 1838, 1293, 2314, 552,
+  2677, 2106, 1571, 205, 2918, 1542, 2721, 2597, 2312, 681, 130, 1602, 1871,
+  829, 2946, 3065, 1325, 2756, 1861, 1474, 1202, 2367, 3147, 1752, 2707, 171,
+  3127, 3042, 1907, 1836, 1517, 359, 758, 1441
+};
+
+/*************************************************
+* Name:        fqmul
+*
+* Description: Multiplication followed by Montgomery reduction
+*
+* Arguments:   - int16_t a: first factor
+*              - int16_t b: second factor
+*
+* Returns 16-bit integer congruent to a*b*R^{-1} mod q
+**************************************************/
+static int16_t fqmul(int16_t a, int16_t b) {
+  return montgomery_reduce((int32_t)a*b);
+}
+
+/* Lane numbers of a vector of 32 coefficients */
+static const int16_t lane_index[32] __attribute__((aligned(64))) = {
+   0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15,
+  16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31
+};
+
+/*
+ * Layers with len >= 32 pair whole vectors and use one zeta per pair. The
+ * layers with len in {16,...,2} work on two vectors (64 coefficients) at a
+ * time: vpermt2w gathers the lower halves of all blocks into x and the upper
+ * halves into y, the butterflies run on x and y with a zeta per block, and a
+ * second pair of vpermt2w puts the coefficients back in standard order.
+ */
+
+/*************************************************
+* Name:        layer_indices
+*
+* Description: Computes the vpermt2w indices of a layer with blocks of
+*              2*len coefficients, for a pair of vectors a and b
+*
+* Arguments:   - unsigned int l: log2 of len
+*              - __m512i *idx:   output; idx[0] and idx[1] gather the lower
+*                                and upper halves of the blocks from (a,b),
+*                                idx[2] and idx[3] scatter them back from
+*                                (x,y) to a and b
+**************************************************/
+static inline void layer_indices(unsigned int l, __m512i idx[4])
+{
+  const __m512i lane = _mm512_load_si512((const __m512i *)lane_index);
+  const __m512i len = _mm512_set1_epi16(1 << l);
+  const __m512i off = _mm512_set1_epi16((1 << l) - 1);
+  __m512i j;
+  unsigned int h;
+
+  idx[0] = _mm512_add_epi16(lane, _mm512_andnot_si512(off, lane));
+  idx[1] = _mm512_add_epi16(idx[0], len);
+  for(h = 0; h < 2; h++) {
+    j = _mm512_add_epi16(lane, _mm512_set1_epi16(32*h));
+    idx[2+h] = _mm512_add_epi16(
+        _mm512_slli_epi16(_mm512_and_si512(_mm512_srli_epi16(j, l), _mm512_set1_epi16(1)), 5),
+        _mm512_add_epi16(_mm512_slli_epi16(_mm512_srli_epi16(j, l+1), l),
+                         _mm512_and_si512(j, off)));
+  }
+}
+
+/*************************************************
+* Name:        layer_zetas
+*
+* Description: Loads the zetas of the 32 >> l blocks of one pair of vectors
+*              and spreads them over the lanes of x (and y)
+*
+* Arguments:   - const int16_t *z: pointer to the zeta of the first block
+*              - unsigned int l:   log2 of len
+**************************************************/
+static inline __m512i layer_zetas(const int16_t *z, unsigned int l)
+{
+  const __m512i lane = _mm512_load_si512((const __m512i *)lane_index);
+  __m512i t = _mm512_maskz_loadu_epi16((1U << (32 >> l)) - 1, z);
+  return _mm512_permutexvar_epi16(_mm512_srli_epi16(lane, l), t);
+}
+
+/*************************************************
+* Name:        ntt
+*
+* Description: Inplace number-theoretic transform (NTT) in Rq
+*              input is in standard order, output is in bitreversed order
+*
+* Arguments:   - int16_t r[256]: pointer to input/output vector of elements
+*                                of Zq
+**************************************************/
+void ntt(int16_t r[256]) {
+  unsigned int len, start, i, c, l, k;
+  __m512i a[8], idx[4], x, y, t, zeta;
+
+  for(i = 0; i < 8; ++i)
+    a[i] = _mm512_loadu_si512((const __m512i *)&r[32*i]);
+
+  // len = 128, 64, 32 (4, 2, 1 vectors)
+  k = 1;
+  for(len = 4; len >= 1; len >>= 1) {
+    for(start = 0; start < 8; start = i + len) {
+      zeta = _mm512_set1_epi16(zetas[k++]);
+      for(i = start; i < start + len; ++i) {
+        t = fqmul512(zeta, a[i + len]);
+        a[i + len] = _mm512_sub_epi16(a[i], t);
+        a[i] = _mm512_add_epi16(a[i], t);
+      }
+    }
+  }
+
+  // len = 16, 8, 4, 2
+  for(l = 4; l >= 1; --l) {
+    layer_indices(l, idx);
+    for(c = 0; c < 4; ++c) {
+      zeta = layer_zetas(&zetas[(128 >> l) + c*(32 >> l)], l);
+      x = _mm512_permutex2var_epi16(a[2*c], idx[0], a[2*c+1]);
+      y = _mm512_permutex2var_epi16(a[2*c], idx[1], a[2*c+1]);
+      t = fqmul512(zeta, y);
+      y = _mm512_sub_epi16(x, t);
+      x = _mm512_add_epi16(x, t);
+      a[2*c] = _mm512_permutex2var_epi16(x, idx[2], y);
+      a[2*c+1] = _mm512_permutex2var_epi16(x, idx[3], y);
+    }
+  }
+
+  for(i = 0; i < 8; ++i)
+    _mm512_storeu_si512((__m512i *)&r[32*i], a[i]);
+}
+
+/*************************************************
+* Name:        invntt_tomont
+*
+* Description: Inplace inverse number-theoretic transform in Rq and
+*              multiplication by Montgomery factor 2^16.
+*              Input is in bitreversed order, output is in standard order
+*
+* Arguments:   - int16_t r[256]: pointer to input/output vector of elements
+*                                of Zq
+**************************************************/
+void invntt(int16_t r[256]) {
+  unsigned int len, start, i, c, l, k;
+  __m512i a[8], idx[4], x, y, t, zeta;
+
+  for(i = 0; i < 8; ++i)
+    a[i] = _mm512_loadu_si512((const __m512i *)&r[32*i]);
+
+  // len = 2, 4, 8, 16
+  for(l = 1; l <= 4; ++l) {
+    layer_indices(l, idx);
+    for(c = 0; c < 4; ++c) {
+      zeta = layer_zetas(&zetas_inv[128 - (256 >> l) + c*(32 >> l)], l);
+      x = _mm512_permutex2var_epi16(a[2*c], idx[0], a[2*c+1]);
+      y = _mm512_permutex2var_epi16(a[2*c], idx[1], a[2*c+1]);
+      t = x;
+      x = barrett512(_mm512_add_epi16(t, y));
+      y = fqmul512(zeta, _mm512_sub_epi16(t, y));
+      a[2*c] = _mm512_permutex2var_epi16(x, idx[2], y);
+      a[2*c+1] = _mm512_permutex2var_epi16(x, idx[3], y);
+    }
+  }
+
+  // len = 32, 64, 128 (1, 2, 4 vectors)
+  k = 120;
+  for(len = 1; len <= 4; len <<= 1) {
+    for(start = 0; start < 8; start = i + len) {
+      zeta = _mm512_set1_epi16(zetas_inv[k++]);
+      for(i = start; i < start + len; ++i) {
+        t = a[i];
+        a[i] = barrett512(_mm512_add_epi16(t, a[i + len]));
+        a[i + len] = fqmul512(zeta, _mm512_sub_epi16(t, a[i + len]));
+      }
+    }
+  }
+
+  zeta = _mm512_set1_epi16(zetas_inv[127]);
+  for(i = 0; i < 8; ++i)
+    _mm512_storeu_si512((__m512i *)&r[32*i], fqmul512(a[i], zeta));
+}
+
+/*************************************************
+* Name:        basemul
+*
+* Description: Multiplication of polynomials in Zq[X]/(X^2-zeta)
+*              used for multiplication of elements in Rq in NTT domain
+*
+* Arguments:   - int16_t r[2]:       pointer to the output polynomial
+*              - const int16_t a[2]: pointer to the first factor
+*              - const int16_t b[2]: pointer to the second factor
+*              - int16_t zeta:       integer defining the reduction polynomial
+**************************************************/
+void basemul(int16_t r[2],
+             const int16_t a[2],
+             const int16_t b[2],
+             int16_t zeta)
+{
+  r[0]  = fqmul(a[1], b[1]);
+  r[0]  = fqmul(r[0], zeta);
+  r[0] += fqmul(a[0], b[0]);
+
+  r[1]  = fqmul(a[0], b[1]);
+  r[1] += fqmul(a[1], b[0]);
+}
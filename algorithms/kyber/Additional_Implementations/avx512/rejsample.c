@@ -0,0 +1,74 @@
+#include <stdint.h>
+#include <immintrin.h>
+#include "params.h"
+#include "rejsample.h"
+
+/*
+ * Byte positions of the 32 candidates in 48 bytes of XOF output: candidate
+ * 2k is bytes 3k and 3k+1 (low 12 bits), candidate 2k+1 is bytes 3k+1 and
+ * 3k+2 (high 12 bits), as in rej_uniform of the Optimized_Implementation.
+ */
+static const uint8_t rej_idx[64] __attribute__((aligned(64))) = {
+   0,  1,  1,  2,  3,  4,  4,  5,  6,  7,  7,  8,  9, 10, 10, 11,
+  12, 13, 13, 14, 15, 16, 16, 17, 18, 19, 19, 20, 21, 22, 22, 23,
+  24, 25, 25, 26, 27, 28, 28, 29, 30, 31, 31, 32, 33, 34, 34, 35,
+  36, 37, 37, 38, 39, 40, 40, 41, 42, 43, 43, 44, 45, 46, 46, 47
+};
+
+/*************************************************
+* Name:        rej_uniform_avx512
+*
+* Description: Run rejection sampling on uniform random bytes to generate
+*              uniform random integers mod q. Takes 48 bytes (32 candidates)
+*              per step: vpermb spreads them over 16-bit lanes, vpcmpuw
+*              selects the ones below q and vpcompressw packs them into r.
+*              The rest is sampled one triple at a time, so the output
+*              is the same as the scalar rej_uniform's
+*
+* Arguments:   - int16_t *r:          pointer to output buffer
+*              - unsigned int len:    requested number of 16-bit integers
+*                                     (uniform mod q)
+*              - const uint8_t *buf:  pointer to input buffer
+*                                     (assumed to be uniform random bytes)
+*              - unsigned int buflen: length of input buffer in bytes
+*
+* Returns number of sampled 16-bit integers (at most len)
+**************************************************/
+unsigned int rej_uniform_avx512(int16_t *r,
+                                unsigned int len,
+                                const uint8_t *buf,
+                                unsigned int buflen)
+{
+  unsigned int ctr, pos;
+  uint16_t val0, val1;
+  __mmask32 good;
+  const __m512i idx = _mm512_load_si512((const __m512i *)rej_idx);
+  const __m512i shift = _mm512_set1_epi32(4 << 16);
+  const __m512i mask = _mm512_set1_epi16(0xFFF);
+  const __m512i q = _mm512_set1_epi16(KYBER_Q);
+  __m512i f;
+
+  ctr = pos = 0;
+  while(ctr + 32 <= len && pos + 48 <= buflen) {
+    f = _mm512_maskz_loadu_epi8(0xFFFFFFFFFFFFULL, &buf[pos]);
+    f = _mm512_permutexvar_epi8(idx, f);
+    f = _mm512_and_si512(_mm512_srlv_epi16(f, shift), mask);
+    good = _mm512_cmplt_epu16_mask(f, q);
+    _mm512_mask_compressstoreu_epi16(&r[ctr], good, f);
+    ctr += _mm_popcnt_u32(good);
+    pos += 48;
+  }
+
+  while(ctr < len && pos + 3 <= buflen) {
+    val0 = ((buf[pos+0] >> 0) | ((uint16_t)buf[pos+1] << 8)) & 0xFFF;
+    val1 = ((buf[pos+1] >> 4) | ((uint16_t)buf[pos+2] << 4)) & 0xFFF;
+    pos += 3;
+
+    if(val0 < KYBER_Q)
+      r[ctr++] = val0;
+    if(ctr < len && val1 < KYBER_Q)
+      r[ctr++] = val1;
+  }
+
+  return ctr;
+}
@@ -0,0 +1,13 @@
+#ifndef REJSAMPLE_H
+#define REJSAMPLE_H
+
+#include <stdint.h>
+#include "params.h"
+
+#define rej_uniform_avx512 KYBER_NAMESPACE(_rej_uniform_avx512)
+unsigned int rej_uniform_avx512(int16_t *r,
+                                unsigned int len,
+                                const uint8_t *buf,
+                                unsigned int buflen);
+
+#endif
@@ -0,0 +1,299 @@
+#include <stdint.h>
+#include "params.h"
+#include "poly.h"
+#include "ntt.h"
+#include "compact.h"
+
+/*
+ * Polynomial helpers of the compact build, after the m4 implementation's
+ * poly.c: they work on one polynomial of a vector at a time, or on packed
+ * bytes directly, so indcpa.c never needs a whole polyvec temporary for the
+ * matrix, the public key, the secret key or the ciphertext. The arithmetic
+ * is the portable C of the Optimized_Implementation, operation for
+ * operation, so keys and ciphertexts are identical to its output.
+ */
+
+#define POLYCOMPRESSEDBYTES_VEC (KYBER_POLYVECCOMPRESSEDBYTES/KYBER_K)
+
+/*************************************************
+* Name:        poly_zeroize
+*
+* Description: Sets all coefficients of a polynomial to zero
+*
+* Arguments:   - poly *r: pointer to output polynomial
+**************************************************/
+void poly_zeroize(poly *r)
+{
+  unsigned int i;
+  for(i=0;i<KYBER_N;i++)
+    r->coeffs[i] = 0;
+}
+
+/*************************************************
+* Name:        basemul_acc
+*
+* Description: Multiplies four coefficients (two degree-one factors) of
+*              a and b in the NTT domain and adds the products to r,
+*              as poly_basemul_montgomery does for a whole polynomial
+*
+* Arguments:   - int16_t r[4]:       pointer to the output coefficients
+*              - const int16_t a[4]: pointer to the first factor
+*              - const int16_t b[4]: pointer to the second factor
+*              - int16_t zeta:       zeta of the first degree-one factor
+**************************************************/
+void basemul_acc(int16_t r[4], const int16_t a[4], const int16_t b[4], int16_t zeta)
+{
+  int16_t t[2];
+
+  basemul(t, a, b, zeta);
+  r[0] += t[0];
+  r[1] += t[1];
+  basemul(t, a+2, b+2, -zeta);
+  r[2] += t[0];
+  r[3] += t[1];
+}
+
+/*************************************************
+* Name:        poly_frombytes_basemul_acc
+*
+* Description: Multiplies a serialized polynomial with b in the NTT
+*              domain and adds the product to r, deserializing four
+*              coefficients at a time instead of the whole polynomial
+*
+* Arguments:   - poly *r:          pointer to the output polynomial
+*              - const uint8_t *a: pointer to the serialized polynomial
+*                                  (of length KYBER_POLYBYTES)
+*              - const poly *b:    pointer to the second factor
+**************************************************/
+void poly_frombytes_basemul_acc(poly *r, const uint8_t a[KYBER_POLYBYTES], const poly *b)
+{
+  unsigned int i;
+  int16_t t[4];
+
+  for(i=0;i<KYBER_N/4;i++) {
+    t[0] = ((a[6*i+0] >> 0) | ((uint16_t)a[6*i+1] << 8)) & 0xFFF;
+    t[1] = ((a[6*i+1] >> 4) | ((uint16_t)a[6*i+2] << 4)) & 0xFFF;
+    t[2] = ((a[6*i+3] >> 0) | ((uint16_t)a[6*i+4] << 8)) & 0xFFF;
+    t[3] = ((a[6*i+4] >> 4) | ((uint16_t)a[6*i+5] << 4)) & 0xFFF;
+    basemul_acc(&r->coeffs[4*i], t, &b->coeffs[4*i], zetas[64+i]);
+  }
+}
+
+/*************************************************
+* Name:        poly_packcompress
+*
+* Description: Compresses and serializes polynomial i of a vector into
+*              its place in the serialized vector, as polyvec_compress
+*              does for the whole vector
+*
+* Arguments:   - uint8_t *r: pointer to the serialized vector
+*                            (of length KYBER_POLYVECCOMPRESSEDBYTES)
+*              - poly *a:    pointer to the input polynomial
+*              - unsigned int i: index of the polynomial in the vector
+**************************************************/
+void poly_packcompress(uint8_t r[KYBER_POLYVECCOMPRESSEDBYTES], poly *a, unsigned int i)
+{
+  unsigned int j,k;
+
+  poly_csubq(a);
+  r += i*POLYCOMPRESSEDBYTES_VEC;
+
+#if (KYBER_POLYVECCOMPRESSEDBYTES == (KYBER_K * 352))
+  uint16_t t[8];
+  for(j=0;j<KYBER_N/8;j++) {
+    for(k=0;k<8;k++)
+      t[k] = ((((uint32_t)a->coeffs[8*j+k] << 11) + KYBER_Q/2)
+              /KYBER_Q) & 0x7ff;
+
+    r[ 0] = (t[0] >>  0);
+    r[ 1] = (t[0] >>  8) | (t[1] << 3);
+    r[ 2] = (t[1] >>  5) | (t[2] << 6);
+    r[ 3] = (t[2] >>  2);
+    r[ 4] = (t[2] >> 10) | (t[3] << 1);
+    r[ 5] = (t[3] >>  7) | (t[4] << 4);
+    r[ 6] = (t[4] >>  4) | (t[5] << 7);
+    r[ 7] = (t[5] >>  1);
+    r[ 8] = (t[5] >>  9) | (t[6] << 2);
+    r[ 9] = (t[6] >>  6) | (t[7] << 5);
+    r[10] = (t[7] >>  3);
+    r += 11;
+  }
+#elif (KYBER_POLYVECCOMPRESSEDBYTES == (KYBER_K * 320))
+  uint16_t t[4];
+  for(j=0;j<KYBER_N/4;j++) {
+    for(k=0;k<4;k++)
+      t[k] = ((((uint32_t)a->coeffs[4*j+k] << 10) + KYBER_Q/2)
+              / KYBER_Q) & 0x3ff;
+
+    r[0] = (t[0] >> 0);
+    r[1] = (t[0] >> 8) | (t[1] << 2);
+    r[2] = (t[1] >> 6) | (t[2] << 4);
+    r[3] = (t[2] >> 4) | (t[3] << 6);
+    r[4] = (t[3] >> 2);
+    r += 5;
+  }
+#else
+#error "KYBER_POLYVECCOMPRESSEDBYTES needs to be in {320*KYBER_K, 352*KYBER_K}"
+#endif
+}
+
+/*************************************************
+* Name:        poly_unpackdecompress
+*
+* Description: De-serializes and decompresses polynomial i of a
+*              serialized vector; approximate inverse of poly_packcompress
+*
+* Arguments:   - poly *r:          pointer to the output polynomial
+*              - const uint8_t *a: pointer to the serialized vector
+*                                  (of length KYBER_POLYVECCOMPRESSEDBYTES)
+*              - unsigned int i:   index of the polynomial in the vector
+**************************************************/
+void poly_unpackdecompress(poly *r, const uint8_t a[KYBER_POLYVECCOMPRESSEDBYTES], unsigned int i)
+{
+  unsigned int j,k;
+
+  a += i*POLYCOMPRESSEDBYTES_VEC;
+
+#if (KYBER_POLYVECCOMPRESSEDBYTES == (KYBER_K * 352))
+  uint16_t t[8];
+  for(j=0;j<KYBER_N/8;j++) {
+    t[0] = (a[0] >> 0) | ((uint16_t)a[ 1] << 8);
+    t[1] = (a[1] >> 3) | ((uint16_t)a[ 2] << 5);
+    t[2] = (a[2] >> 6) | ((uint16_t)a[ 3] << 2) | ((uint16_t)a[4] << 10);
+    t[3] = (a[4] >> 1) | ((uint16_t)a[ 5] << 7);
+    t[4] = (a[5] >> 4) | ((uint16_t)a[ 6] << 4);
+    t[5] = (a[6] >> 7) | ((uint16_t)a[ 7] << 1) | ((uint16_t)a[8] << 9);
+    t[6] = (a[8] >> 2) | ((uint16_t)a[ 9] << 6);
+    t[7] = (a[9] >> 5) | ((uint16_t)a[10] << 3);
+    a += 11;
+
+    for(k=0;k<8;k++)
+      r->coeffs[8*j+k] = ((uint32_t)(t[k] & 0x7FF)*KYBER_Q + 1024) >> 11;
+  }
+#elif (KYBER_POLYVECCOMPRESSEDBYTES == (KYBER_K * 320))
+  uint16_t t[4];
+  for(j=0;j<KYBER_N/4;j++) {
+    t[0] = (a[0] >> 0) | ((uint16_t)a[1] << 8);
+    t[1] = (a[1] >> 2) | ((uint16_t)a[2] << 6);
+    t[2] = (a[2] >> 4) | ((uint16_t)a[3] << 4);
+    t[3] = (a[3] >> 6) | ((uint16_t)a[4] << 2);
+    a += 5;
+
+    for(k=0;k<4;k++)
+      r->coeffs[4*j+k] = ((uint32_t)(t[k] & 0x3FF)*KYBER_Q + 512) >> 10;
+  }
+#else
+#error "KYBER_POLYVECCOMPRESSEDBYTES needs to be in {320*KYBER_K, 352*KYBER_K}"
+#endif
+}
+
+/*************************************************
+* Name:        cmp_poly_packcompress
+*
+* Description: Compresses polynomial i of a vector like poly_packcompress,
+*              but compares the result with its place in r instead of
+*              writing it, in constant time
+*
+* Arguments:   - const uint8_t *r: pointer to the serialized vector to
+*                                  compare with
+*              - poly *a:          pointer to the input polynomial
+*              - unsigned int i:   index of the polynomial in the vector
+*
+* Returns 0 if the bytes are equal, non-zero otherwise
+**************************************************/
+uint8_t cmp_poly_packcompress(const uint8_t r[KYBER_POLYVECCOMPRESSEDBYTES], poly *a, unsigned int i)
+{
+  unsigned int j,k;
+  uint8_t rc = 0;
+
+  poly_csubq(a);
+  r += i*POLYCOMPRESSEDBYTES_VEC;
+
+#if (KYBER_POLYVECCOMPRESSEDBYTES == (KYBER_K * 352))
+  uint16_t t[8];
+  for(j=0;j<KYBER_N/8;j++) {
+    for(k=0;k<8;k++)
+      t[k] = ((((uint32_t)a->coeffs[8*j+k] << 11) + KYBER_Q/2)
+              /KYBER_Q) & 0x7ff;
+
+    rc |= r[ 0] ^ (uint8_t)((t[0] >>  0));
+    rc |= r[ 1] ^ (uint8_t)((t[0] >>  8) | (t[1] << 3));
+    rc |= r[ 2] ^ (uint8_t)((t[1] >>  5) | (t[2] << 6));
+    rc |= r[ 3] ^ (uint8_t)((t[2] >>  2));
+    rc |= r[ 4] ^ (uint8_t)((t[2] >> 10) | (t[3] << 1));
+    rc |= r[ 5] ^ (uint8_t)((t[3] >>  7) | (t[4] << 4));
+    rc |= r[ 6] ^ (uint8_t)((t[4] >>  4) | (t[5] << 7));
+    rc |= r[ 7] ^ (uint8_t)((t[5] >>  1));
+    rc |= r[ 8] ^ (uint8_t)((t[5] >>  9) | (t[6] << 2));
+    rc |= r[ 9] ^ (uint8_t)((t[6] >>  6) | (t[7] << 5));
+    rc |= r[10] ^ (uint8_t)((t[7] >>  3));
+    r += 11;
+  }
+#elif (KYBER_POLYVECCOMPRESSEDBYTES == (KYBER_K * 320))
+  uint16_t t[4];
+  for(j=0;j<KYBER_N/4;j++) {
+    for(k=0;k<4;k++)
+      t[k] = ((((uint32_t)a->coeffs[4*j+k] << 10) + KYBER_Q/2)
+              / KYBER_Q) & 0x3ff;
+
+    rc |= r[0] ^ (uint8_t)((t[0] >> 0));
+    rc |= r[1] ^ (uint8_t)((t[0] >> 8) | (t[1] << 2));
+    rc |= r[2] ^ (uint8_t)((t[1] >> 6) | (t[2] << 4));
+    rc |= r[3] ^ (uint8_t)((t[2] >> 4) | (t[3] << 6));
+    rc |= r[4] ^ (uint8_t)((t[3] >> 2));
+    r += 5;
+  }
+#else
+#error "KYBER_POLYVECCOMPRESSEDBYTES needs to be in {320*KYBER_K, 352*KYBER_K}"
+#endif
+  return rc;
+}
+
+/*************************************************
+* Name:        cmp_poly_compress
+*
+* Description: Compresses a polynomial like poly_compress, but compares
+*              the result with r instead of writing it, in constant time
+*
+* Arguments:   - const uint8_t *r: pointer to the bytes to compare with
+*                                  (of length KYBER_POLYCOMPRESSEDBYTES)
+*              - poly *a:          pointer to the input polynomial
+*
+* Returns 0 if the bytes are equal, non-zero otherwise
+**************************************************/
+uint8_t cmp_poly_compress(const uint8_t r[KYBER_POLYCOMPRESSEDBYTES], poly *a)
+{
+  unsigned int i,j;
+  uint8_t t[8];
+  uint8_t rc = 0;
+
+  poly_csubq(a);
+
+#if (KYBER_POLYCOMPRESSEDBYTES == 128)
+  for(i=0;i<KYBER_N/8;i++) {
+    for(j=0;j<8;j++)
+      t[j] = ((((uint16_t)a->coeffs[8*i+j] << 4) + KYBER_Q/2)/KYBER_Q) & 15;
+
+    rc |= r[0] ^ (uint8_t)(t[0] | (t[1] << 4));
+    rc |= r[1] ^ (uint8_t)(t[2] | (t[3] << 4));
+    rc |= r[2] ^ (uint8_t)(t[4] | (t[5] << 4));
+    rc |= r[3] ^ (uint8_t)(t[6] | (t[7] << 4));
+    r += 4;
+  }
+#elif (KYBER_POLYCOMPRESSEDBYTES == 160)
+  for(i=0;i<KYBER_N/8;i++) {
+    for(j=0;j<8;j++)
+      t[j] = ((((uint32_t)a->coeffs[8*i+j] << 5) + KYBER_Q/2)/KYBER_Q) & 31;
+
+    rc |= r[0] ^ (uint8_t)((t[0] >> 0) | (t[1] << 5));
+    rc |= r[1] ^ (uint8_t)((t[1] >> 3) | (t[2] << 2) | (t[3] << 7));
+    rc |= r[2] ^ (uint8_t)((t[3] >> 1) | (t[4] << 4));
+    rc |= r[3] ^ (uint8_t)((t[4] >> 4) | (t[5] << 1) | (t[6] << 6));
+    rc |= r[4] ^ (uint8_t)((t[6] >> 2) | (t[7] << 3));
+    r += 5;
+  }
+#else
+#error "KYBER_POLYCOMPRESSEDBYTES needs to be in {128, 160}"
+#endif
+  return rc;
+}
@@ -0,0 +1,26 @@
+#ifndef COMPACT_H
+#define COMPACT_H
+
+#include <stdint.h>
+#include "params.h"
+#include "poly.h"
+
+#define poly_zeroize KYBER_NAMESPACE(_poly_zeroize)
+void poly_zeroize(poly *r);
+
+#define basemul_acc KYBER_NAMESPACE(_basemul_acc)
+void basemul_acc(int16_t r[4], const int16_t a[4], const int16_t b[4], int16_t zeta);
+#define poly_frombytes_basemul_acc KYBER_NAMESPACE(_poly_frombytes_basemul_acc)
+void poly_frombytes_basemul_acc(poly *r, const uint8_t a[KYBER_POLYBYTES], const poly *b);
+
+#define poly_packcompress KYBER_NAMESPACE(_poly_packcompress)
+void poly_packcompress(uint8_t r[KYBER_POLYVECCOMPRESSEDBYTES], poly *a, unsigned int i);
+#define poly_unpackdecompress KYBER_NAMESPACE(_poly_unpackdecompress)
+void poly_unpackdecompress(poly *r, const uint8_t a[KYBER_POLYVECCOMPRESSEDBYTES], unsigned int i);
+
+#define cmp_poly_packcompress KYBER_NAMESPACE(_cmp_poly_packcompress)
+uint8_t cmp_poly_packcompress(const uint8_t r[KYBER_POLYVECCOMPRESSEDBYTES], poly *a, unsigned int i);
+#define cmp_poly_compress KYBER_NAMESPACE(_cmp_poly_compress)
+uint8_t cmp_poly_compress(const uint8_t r[KYBER_POLYCOMPRESSEDBYTES], poly *a);
+
+#endif
@@ -0,0 +1,314 @@
+#include <stddef.h>
+#include <stdint.h>
+#include "params.h"
+#include "indcpa.h"
+#include "poly.h"
+#include "polyvec.h"
+#include "compact.h"
+#include "rng.h"
+#include "ntt.h"
+#include "symmetric.h"
+
+/*
+ * Stack-optimized IND-CPA scheme, after the m4 implementation's indcpa.c and
+ * built on the Optimized_Implementation's portable kernels. Rows of A are
+ * generated on the fly and multiplied as their coefficients come out of the
+ * XOF (matacc), the noise, public key, secret key and ciphertext are handled
+ * one polynomial at a time, and decapsulation compares the re-encryption with
+ * the received ciphertext as it is compressed (indcpa_enc_cmp), so no
+ * ciphertext-sized buffer is needed. The only polyvec left is the secret
+ * (keypair) or ephemeral (enc) vector the matrix is multiplied with.
+ */
+
+#if (XOF_BLOCKBYTES % 3) != 0
+#error "matacc assumes XOF blocks hold a whole number of 3-byte samples"
+#endif
+
+/*************************************************
+* Name:        matacc
+*
+* Description: Multiplies row i of A (or of the transpose of A), generated
+*              on the fly from a seed, with a vector of polynomials. Samples
+*              are taken from the XOF by rejection, exactly as gen_matrix
+*              does, and every four of them are multiplied right away, so
+*              neither the row nor the XOF output is held in full
+*
+* Arguments:   - poly *r:             pointer to output polynomial
+*              - const polyvec *b:    pointer to input vector of polynomials
+*              - unsigned int i:      index of the row
+*              - const uint8_t *seed: pointer to the public seed
+*              - int transposed:      boolean deciding whether A or A^T
+*                                     is used
+**************************************************/
+static void matacc(poly *r,
+                   const polyvec *b,
+                   unsigned int i,
+                   const uint8_t seed[KYBER_SYMBYTES],
+                   int transposed)
+{
+  unsigned int j, k, ctr, pos;
+  uint16_t val0, val1;
+  int16_t c[4];
+  uint8_t buf[XOF_BLOCKBYTES];
+  xof_state state;
+
+  poly_zeroize(r);
+
+  for(j=0;j<KYBER_K;j++) {
+    if(transposed)
+      xof_absorb(&state, seed, i, j);
+    else
+      xof_absorb(&state, seed, j, i);
+
+    xof_squeezeblocks(buf, 1, &state);
+    ctr = pos = k = 0;
+    while(ctr < KYBER_N/4) {
+      if(pos == XOF_BLOCKBYTES) {
+        xof_squeezeblocks(buf, 1, &state);
+        pos = 0;
+      }
+
+      val0 = ((buf[pos+0] >> 0) | ((uint16_t)buf[pos+1] << 8)) & 0xFFF;
+      val1 = ((buf[pos+1] >> 4) | ((uint16_t)buf[pos+2] << 4));
+      pos += 3;
+
+      if(val0 < KYBER_Q) {
+        c[k++] = val0;
+        if(k == 4) {
+          basemul_acc(&r->coeffs[4*ctr], c, &b->vec[j].coeffs[4*ctr], zetas[64+ctr]);
+          ctr++;
+          k = 0;
+        }
+      }
+      if(ctr < KYBER_N/4 && val1 < KYBER_Q) {
+        c[k++] = val1;
+        if(k == 4) {
+          basemul_acc(&r->coeffs[4*ctr], c, &b->vec[j].coeffs[4*ctr], zetas[64+ctr]);
+          ctr++;
+          k = 0;
+        }
+      }
+    }
+  }
+
+  poly_reduce(r);
+}
+
+/*************************************************
+* Name:        indcpa_keypair_derand
+*
+* Description: Generates public and private key for the CPA-secure
+*              public-key encryption scheme underlying Kyber,
+*              deterministically from coins
+*
+* Arguments:   - uint8_t *pk: pointer to output public key
+*                             (of length KYBER_INDCPA_PUBLICKEYBYTES bytes)
+*              - uint8_t *sk: pointer to output private key
+                              (of length KYBER_INDCPA_SECRETKEYBYTES bytes)
+*              - const uint8_t *coins: pointer to input randomness
+*                             (of length KYBER_SYMBYTES bytes)
+**************************************************/
+void indcpa_keypair_derand(uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
+                           uint8_t sk[KYBER_INDCPA_SECRETKEYBYTES],
+                           const uint8_t coins[KYBER_SYMBYTES])
+{
+  unsigned int i;
+  uint8_t buf[2*KYBER_SYMBYTES];
+  const uint8_t *publicseed = buf;
+  const uint8_t *noiseseed = buf+KYBER_SYMBYTES;
+  polyvec skpv;
+  poly pkp, e;
+
+  hash_g(buf, coins, KYBER_SYMBYTES);
+
+  for(i=0;i<KYBER_K;i++)
+    poly_getnoise_eta1(&skpv.vec[i], noiseseed, i);
+  polyvec_ntt(&skpv);
+
+  // matrix-vector multiplication, one row and one noise polynomial at a time
+  for(i=0;i<KYBER_K;i++) {
+    matacc(&pkp, &skpv, i, publicseed, 0);
+    poly_tomont(&pkp);
+
+    poly_getnoise_eta1(&e, noiseseed, KYBER_K+i);
+    poly_ntt(&e);
+    poly_add(&pkp, &pkp, &e);
+    poly_reduce(&pkp);
+
+    poly_tobytes(pk+i*KYBER_POLYBYTES, &pkp);
+  }
+
+  polyvec_tobytes(sk, &skpv);
+  for(i=0;i<KYBER_SYMBYTES;i++)
+    pk[i+KYBER_POLYVECBYTES] = publicseed[i];
+}
+
+/*************************************************
+* Name:        enc
+*
+* Description: Encryption shared by indcpa_enc and indcpa_enc_cmp. Each
+*              polynomial of the ciphertext is either written to out or
+*              compared with cmp as soon as it is compressed, and then
+*              absorbed into h
+*
+* Arguments:   - uint8_t *out:         pointer to output ciphertext, or NULL
+*              - const uint8_t *cmp:   pointer to ciphertext to compare
+*                                      with, or NULL
+*              - sha3_256incctx *h:    pointer to hash state cmp is absorbed
+*                                      into, or NULL
+*              - const uint8_t *m:     pointer to input message
+*              - const uint8_t *pk:    pointer to input public key
+*              - const uint8_t *coins: pointer to input random coins
+*
+* Returns 0 when comparing equal (or writing), non-zero otherwise
+**************************************************/
+static uint8_t enc(uint8_t *out,
+                   const uint8_t *cmp,
+                   sha3_256incctx *h,
+                   const uint8_t m[KYBER_INDCPA_MSGBYTES],
+                   const uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
+                   const uint8_t coins[KYBER_SYMBYTES])
+{
+  unsigned int i;
+  uint8_t rc = 0;
+  const uint8_t *seed = pk+KYBER_POLYVECBYTES;
+  polyvec sp;
+  poly bp, e;
+
+  for(i=0;i<KYBER_K;i++)
+    poly_getnoise_eta1(&sp.vec[i], coins, i);
+  polyvec_ntt(&sp);
+
+  // u = A^T r + e1, one row at a time
+  for(i=0;i<KYBER_K;i++) {
+    matacc(&bp, &sp, i, seed, 1);
+    poly_invntt_tomont(&bp);
+
+    poly_getnoise_eta2(&e, coins, KYBER_K+i);
+    poly_add(&bp, &bp, &e);
+    poly_reduce(&bp);
+
+    if(out != NULL)
+      poly_packcompress(out, &bp, i);
+    else
+      rc |= cmp_poly_packcompress(cmp, &bp, i);
+    if(h != NULL)
+      sha3_256_inc_absorb(h, cmp+i*(KYBER_POLYVECCOMPRESSEDBYTES/KYBER_K),
+                          KYBER_POLYVECCOMPRESSEDBYTES/KYBER_K);
+  }
+
+  // v = t^T r + e2 + m, with t read from the public key four coefficients at a time
+  poly_zeroize(&bp);
+  for(i=0;i<KYBER_K;i++)
+    poly_frombytes_basemul_acc(&bp, pk+i*KYBER_POLYBYTES, &sp.vec[i]);
+  poly_reduce(&bp);
+  poly_invntt_tomont(&bp);
+
+  poly_getnoise_eta2(&e, coins, 2*KYBER_K);
+  poly_add(&bp, &bp, &e);
+  poly_frommsg(&e, m);
+  poly_add(&bp, &bp, &e);
+  poly_reduce(&bp);
+
+  if(out != NULL)
+    poly_compress(out+KYBER_POLYVECCOMPRESSEDBYTES, &bp);
+  else
+    rc |= cmp_poly_compress(cmp+KYBER_POLYVECCOMPRESSEDBYTES, &bp);
+  if(h != NULL)
+    sha3_256_inc_absorb(h, cmp+KYBER_POLYVECCOMPRESSEDBYTES, KYBER_POLYCOMPRESSEDBYTES);
+
+  return rc;
+}
+
+/*************************************************
+* Name:        indcpa_enc
+*
+* Description: Encryption function of the CPA-secure
+*              public-key encryption scheme underlying Kyber.
+*
+* Arguments:   - uint8_t *c:           pointer to output ciphertext
+*                                      (of length KYBER_INDCPA_BYTES bytes)
+*              - const uint8_t *m:     pointer to input message
+*                                      (of length KYBER_INDCPA_MSGBYTES bytes)
+*              - const uint8_t *pk:    pointer to input public key
+*                                      (of length KYBER_INDCPA_PUBLICKEYBYTES)
+*              - const uint8_t *coins: pointer to input random coins
+*                                      used as seed (of length KYBER_SYMBYTES)
+*                                      to deterministically generate all
+*                                      randomness
+**************************************************/
+void indcpa_enc(uint8_t c[KYBER_INDCPA_BYTES],
+                const uint8_t m[KYBER_INDCPA_MSGBYTES],
+                const uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
+                const uint8_t coins[KYBER_SYMBYTES])
+{
+  enc(c, NULL, NULL, m, pk, coins);
+}
+
+/*************************************************
+* Name:        indcpa_enc_cmp
+*
+* Description: Re-encryption for decapsulation: encrypts m like indcpa_enc
+*              and compares the result with c in constant time, without
+*              storing the re-encrypted ciphertext. Each polynomial of c is
+*              absorbed into h right after it is compared.
+*
+* Arguments:   - const uint8_t *c:     pointer to ciphertext to compare with
+*                                      (of length KYBER_INDCPA_BYTES bytes)
+*              - const uint8_t *m:     pointer to input message
+*                                      (of length KYBER_INDCPA_MSGBYTES bytes)
+*              - const uint8_t *pk:    pointer to input public key
+*                                      (of length KYBER_INDCPA_PUBLICKEYBYTES)
+*              - const uint8_t *coins: pointer to input random coins
+*                                      (of length KYBER_SYMBYTES)
+*              - sha3_256incctx *h:    pointer to hash state c is absorbed
+*                                      into, or NULL
+*
+* Returns 0 if the re-encryption equals c, 1 otherwise (as verify)
+**************************************************/
+int indcpa_enc_cmp(const uint8_t c[KYBER_INDCPA_BYTES],
+                   const uint8_t m[KYBER_INDCPA_MSGBYTES],
+                   const uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
+                   const uint8_t coins[KYBER_SYMBYTES],
+                   sha3_256incctx *h)
+{
+  uint64_t rc = enc(NULL, c, h, m, pk, coins);
+  return (-rc) >> 63;
+}
+
+/*************************************************
+* Name:        indcpa_dec
+*
+* Description: Decryption function of the CPA-secure
+*              public-key encryption scheme underlying Kyber.
+*
+* Arguments:   - uint8_t *m:        pointer to output decrypted message
+*                                   (of length KYBER_INDCPA_MSGBYTES)
+*              - const uint8_t *c:  pointer to input ciphertext
+*                                   (of length KYBER_INDCPA_BYTES)
+*              - const uint8_t *sk: pointer to input secret key
+*                                   (of length KYBER_INDCPA_SECRETKEYBYTES)
+**************************************************/
+void indcpa_dec(uint8_t m[KYBER_INDCPA_MSGBYTES],
+                const uint8_t c[KYBER_INDCPA_BYTES],
+                const uint8_t sk[KYBER_INDCPA_SECRETKEYBYTES])
+{
+  unsigned int i;
+  poly mp, bp;
+
+  // s^T u, one ciphertext polynomial at a time, s read from the secret key
+  poly_zeroize(&mp);
+  for(i=0;i<KYBER_K;i++) {
+    poly_unpackdecompress(&bp, c, i);
+    poly_ntt(&bp);
+    poly_frombytes_basemul_acc(&mp, sk+i*KYBER_POLYBYTES, &bp);
+  }
+  poly_reduce(&mp);
+  poly_invntt_tomont(&mp);
+
+  poly_decompress(&bp, c+KYBER_POLYVECCOMPRESSEDBYTES);
+  poly_sub(&mp, &bp, &mp);
+  poly_reduce(&mp);
+
+  poly_tomsg(m, &mp);
+}
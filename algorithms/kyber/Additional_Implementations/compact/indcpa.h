@@ -0,0 +1,32 @@
+#ifndef INDCPA_H
+#define INDCPA_H
+
+#include <stdint.h>
+#include "params.h"
+#include "polyvec.h"
+#include "fips202.h"
+
+#define indcpa_keypair_derand KYBER_NAMESPACE(_indcpa_keypair_derand)
+void indcpa_keypair_derand(uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
+                           uint8_t sk[KYBER_INDCPA_SECRETKEYBYTES],
+                           const uint8_t coins[KYBER_SYMBYTES]);
+
+#define indcpa_enc KYBER_NAMESPACE(_indcpa_enc)
+void indcpa_enc(uint8_t c[KYBER_INDCPA_BYTES],
+                const uint8_t m[KYBER_INDCPA_MSGBYTES],
+                const uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
+                const uint8_t coins[KYBER_SYMBYTES]);
+
+#define indcpa_enc_cmp KYBER_NAMESPACE(_indcpa_enc_cmp)
+int indcpa_enc_cmp(const uint8_t c[KYBER_INDCPA_BYTES],
+                   const uint8_t m[KYBER_INDCPA_MSGBYTES],
+                   const uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
+                   const uint8_t coins[KYBER_SYMBYTES],
+                   sha3_256incctx *h);
+
+#define indcpa_dec KYBER_NAMESPACE(_indcpa_dec)
+void indcpa_dec(uint8_t m[KYBER_INDCPA_MSGBYTES],
+                const uint8_t c[KYBER_INDCPA_BYTES],
+                const uint8_t sk[KYBER_INDCPA_SECRETKEYBYTES]);
+
+#endif
@@ -0,0 +1,166 @@
+#include <stddef.h>
+#include <stdint.h>
+#include "kem.h"
+#include "params.h"
+#include "rng.h"
+#include "symmetric.h"
+#include "verify.h"
+#include "indcpa.h"
+
+/*************************************************
+* Name:        crypto_kem_keypair_derand
+*
+* Description: Generates public and private key
+*              for CCA-secure Kyber key encapsulation mechanism
+*              deterministically from coins d || z. Nothing else goes into
+*              the keys, so the coins are a compact form of the secret key
+*              that this function expands again
+*
+* Arguments:   - unsigned char *pk: pointer to output public key
+*                (an already allocated array of CRYPTO_PUBLICKEYBYTES bytes)
+*              - unsigned char *sk: pointer to output private key
+*                (an already allocated array of CRYPTO_SECRETKEYBYTES bytes)
+*              - const unsigned char *coins: pointer to input randomness
+*                (an already allocated array of CRYPTO_KEYPAIRCOINBYTES bytes)
+*
+* Returns 0 (success)
+**************************************************/
+int crypto_kem_keypair_derand(unsigned char *pk,
+                              unsigned char *sk,
+                              const unsigned char *coins)
+{
+  size_t i;
+  indcpa_keypair_derand(pk, sk, coins);
+  for(i=0;i<KYBER_INDCPA_PUBLICKEYBYTES;i++)
+    sk[i+KYBER_INDCPA_SECRETKEYBYTES] = pk[i];
+  hash_h(sk+KYBER_SECRETKEYBYTES-2*KYBER_SYMBYTES, pk, KYBER_PUBLICKEYBYTES);
+  /* Value z for pseudo-random output on reject */
+  for(i=0;i<KYBER_SYMBYTES;i++)
+    sk[i+KYBER_SECRETKEYBYTES-KYBER_SYMBYTES] = coins[i+KYBER_SYMBYTES];
+  return 0;
+}
+
+/*************************************************
+* Name:        crypto_kem_keypair
+*
+* Description: Generates public and private key
+*              for CCA-secure Kyber key encapsulation mechanism
+*
+* Arguments:   - unsigned char *pk: pointer to output public key
+*                (an already allocated array of CRYPTO_PUBLICKEYBYTES bytes)
+*              - unsigned char *sk: pointer to output private key
+*                (an already allocated array of CRYPTO_SECRETKEYBYTES bytes)
+*
+* Returns 0 (success)
+**************************************************/
+int crypto_kem_keypair(unsigned char *pk, unsigned char *sk)
+{
+  uint8_t coins[2*KYBER_SYMBYTES];
+  /* d, then z, drawn separately as before so the KATs are unchanged */
+  randombytes(coins, KYBER_SYMBYTES);
+  randombytes(coins+KYBER_SYMBYTES, KYBER_SYMBYTES);
+  return crypto_kem_keypair_derand(pk, sk, coins);
+}
+
+/*************************************************
+* Name:        crypto_kem_enc
+*
+* Description: Generates cipher text and shared
+*              secret for given public key
+*
+* Arguments:   - unsigned char *ct: pointer to output cipher text
+*                (an already allocated array of CRYPTO_CIPHERTEXTBYTES bytes)
+*              - unsigned char *ss: pointer to output shared secret
+*                (an already allocated array of CRYPTO_BYTES bytes)
+*              - const unsigned char *pk: pointer to input public key
+*                (an already allocated array of CRYPTO_PUBLICKEYBYTES bytes)
+*
+* Returns 0 (success)
+**************************************************/
+int crypto_kem_enc(unsigned char *ct,
+                   unsigned char *ss,
+                   const unsigned char *pk)
+{
+  uint8_t buf[2*KYBER_SYMBYTES];
+  /* Will contain key, coins */
+  uint8_t kr[2*KYBER_SYMBYTES];
+
+  randombytes(buf, KYBER_SYMBYTES);
+  /* Don't release system RNG output */
+  hash_h(buf, buf, KYBER_SYMBYTES);
+
+  /* Multitarget countermeasure for coins + contributory KEM */
+  hash_h(buf+KYBER_SYMBYTES, pk, KYBER_PUBLICKEYBYTES);
+  hash_g(kr, buf, 2*KYBER_SYMBYTES);
+
+  /* coins are in kr+KYBER_SYMBYTES */
+  indcpa_enc(ct, buf, pk, kr+KYBER_SYMBYTES);
+
+  /* overwrite coins in kr with H(c) */
+  hash_h(kr+KYBER_SYMBYTES, ct, KYBER_CIPHERTEXTBYTES);
+  /* hash concatenation of pre-k and H(c) to k */
+  kdf(ss, kr, 2*KYBER_SYMBYTES);
+  return 0;
+}
+
+/*************************************************
+* Name:        crypto_kem_dec
+*
+* Description: Generates shared secret for given
+*              cipher text and private key
+*
+* Arguments:   - unsigned char *ss: pointer to output shared secret
+*                (an already allocated array of CRYPTO_BYTES bytes)
+*              - const unsigned char *ct: pointer to input cipher text
+*                (an already allocated array of CRYPTO_CIPHERTEXTBYTES bytes)
+*              - const unsigned char *sk: pointer to input private key
+*                (an already allocated array of CRYPTO_SECRETKEYBYTES bytes)
+*
+* Returns 0.
+*
+* On failure, ss will contain a pseudo-random value.
+**************************************************/
+int crypto_kem_dec(unsigned char *ss,
+                   const unsigned char *ct,
+                   const unsigned char *sk)
+{
+  size_t i;
+  int fail;
+  uint8_t buf[2*KYBER_SYMBYTES];
+  /* Will contain key, coins */
+  uint8_t kr[2*KYBER_SYMBYTES];
+  const uint8_t *pk = sk+KYBER_INDCPA_SECRETKEYBYTES;
+#ifdef KYBER_FUSED
+  sha3_256incctx h;
+#endif
+
+  indcpa_dec(buf, ct, sk);
+
+  /* Multitarget countermeasure for coins + contributory KEM */
+  for(i=0;i<KYBER_SYMBYTES;i++)
+    buf[KYBER_SYMBYTES+i] = sk[KYBER_SECRETKEYBYTES-2*KYBER_SYMBYTES+i];
+  hash_g(kr, buf, 2*KYBER_SYMBYTES);
+
+#ifdef KYBER_FUSED
+  /* coins are in kr+KYBER_SYMBYTES; re-encrypt, compare with ct and absorb
+     ct into H(c) in one pass */
+  sha3_256_inc_init(&h);
+  fail = indcpa_enc_cmp(ct, buf, pk, kr+KYBER_SYMBYTES, &h);
+
+  /* overwrite coins in kr with H(c) */
+  sha3_256_inc_finalize(kr+KYBER_SYMBYTES, &h);
+#else
+  /* coins are in kr+KYBER_SYMBYTES; re-encrypt and compare with ct in one pass */
+  fail = indcpa_enc_cmp(ct, buf, pk, kr+KYBER_SYMBYTES, NULL);
+
+  /* overwrite coins in kr with H(c) */
+  hash_h(kr+KYBER_SYMBYTES, ct, KYBER_CIPHERTEXTBYTES);
+#endif
+
+  /* Overwrite pre-k with z on re-encryption failure */
+  cmov(kr, sk+KYBER_SECRETKEYBYTES-KYBER_SYMBYTES, KYBER_SYMBYTES, fail);
+
+  /* hash concatenation of pre-k and H(c) to k */
+  kdf(ss, kr, 2*KYBER_SYMBYTES);
+  return 0;
+}
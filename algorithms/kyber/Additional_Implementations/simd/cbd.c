@@ -0,0 +1,103 @@
+#include <stdint.h>
+#include <string.h>
+#include "params.h"
+#include "cbd.h"
+#include "vec.h"
+
+/*
+ * Coefficients are taken from the bytes they are stored in with byte-wise
+ * operations and shifts, so the result does not depend on the byte order of
+ * the machine.
+ */
+
+/*************************************************
+* Name:        cbd2
+*
+* Description: Given an array of uniformly random bytes, compute
+*              polynomial with coefficients distributed according to
+*              a centered binomial distribution with parameter eta=2
+*
+* Arguments:   - poly *r:            pointer to output polynomial
+*              - const uint8_t *buf: pointer to input byte array
+**************************************************/
+static void cbd2(poly *r, const uint8_t buf[2*KYBER_N/4])
+{
+  unsigned int i;
+  uvec8 t, d;
+  vec8 lo, hi;
+
+  // each byte holds two coefficients, its low and high nibble
+  for(i=0;i<KYBER_N/32;i++) {
+    memcpy(&t, buf+16*i, 16);
+    d  = t & 0x55;
+    d += (t>>1) & 0x55;
+
+    lo = (vec8)(d & 0x3) - (vec8)((d >> 2) & 0x3);
+    hi = (vec8)((d >> 4) & 0x3) - (vec8)((d >> 6) & 0x3);
+    vec_store(&r->coeffs[32*i],
+              __builtin_convertvector(__builtin_shufflevector(lo, hi, 0,16,1,17,2,18,3,19,4,20,5,21,6,22,7,23), vec16));
+    vec_store(&r->coeffs[32*i+16],
+              __builtin_convertvector(__builtin_shufflevector(lo, hi, 8,24,9,25,10,26,11,27,12,28,13,29,14,30,15,31), vec16));
+  }
+}
+
+/*************************************************
+* Name:        cbd3
+*
+* Description: Given an array of uniformly random bytes, compute
+*              polynomial with coefficients distributed according to
+*              a centered binomial distribution with parameter eta=3
+*              This function is only needed for Kyber-512
+*
+* Arguments:   - poly *r:            pointer to output polynomial
+*              - const uint8_t *buf: pointer to input byte array
+**************************************************/
+#if KYBER_ETA1 == 3
+static void cbd3(poly *r, const uint8_t buf[3*KYBER_N/4])
+{
+  unsigned int i;
+  uvec8 bytes, lo, hi;
+  uvec16 t, d;
+  const uvec16 shift = {0, 6, 4, 2, 0, 6, 4, 2, 0, 6, 4, 2, 0, 6, 4, 2};
+
+  // 16 coefficients take 12 bytes, read as 16; the last lane only needs byte
+  // 11, so the final group, which would read past buf, is padded with zeros
+  for(i=0;i<KYBER_N/16;i++) {
+    if(i < KYBER_N/16-1) {
+      memcpy(&bytes, buf+12*i, 16);
+    } else {
+      bytes = (uvec8){0};
+      memcpy(&bytes, buf+12*i, 12);
+    }
+    lo = __builtin_shufflevector(bytes, bytes, 0,0,1,2,3,3,4,5,6,6,7,8,9,9,10,11);
+    hi = __builtin_shufflevector(bytes, bytes, 1,1,2,3,4,4,5,6,7,7,8,9,10,10,11,12);
+    t  = __builtin_convertvector(lo, uvec16) | (__builtin_convertvector(hi, uvec16) << 8);
+    t  = (t >> shift) & 0x3F;
+    d  = t & 0x9;
+    d += (t>>1) & 0x9;
+    d += (t>>2) & 0x9;
+
+    vec_store(&r->coeffs[16*i], (vec16)(d & 0x7) - (vec16)((d >> 3) & 0x7));
+  }
+}
+#endif
+
+void cbd_eta1(poly *r, const uint8_t buf[KYBER_ETA1*KYBER_N/4])
+{
+#if KYBER_ETA1 == 2
+  cbd2(r, buf);
+#elif KYBER_ETA1 == 3
+  cbd3(r, buf);
+#else
+#error "This implementation requires eta1 in {2,3}"
+#endif
+}
+
+void cbd_eta2(poly *r, const uint8_t buf[KYBER_ETA1*KYBER_N/4])
+{
+#if KYBER_ETA2 != 2
+#error "This implementation requires eta2 = 2"
+#else
+  cbd2(r, buf);
+#endif
+}
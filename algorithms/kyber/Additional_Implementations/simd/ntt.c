@@ -0,0 +1,259 @@
+#include <stdint.h>
+#include "params.h"
+#include "ntt.h"
+#include "reduce.h"
+#include "vec.h"
+
+/* Code to generate zetas and zetas_inv used in the number-theoretic transform:
+
+#define KYBER_ROOT_OF_UNITY 17
+
+static const uint16_t tree[128] = {
+  0, 64, 32, 96, 16, 80, 48, 112, 8, 72, 40, 104, 24, 88, 56, 120,
+  4, 68, 36, 100, 20, 84, 52, 116, 12, 76, 44, 108, 28, 92, 60, 124,
+  2, 66, 34, 98, 18, 82, 50, 114, 10, 74, 42, 106, 26, 90, 58, 122,
+  6, 70, 38, 102, 22, 86, 54, 118, 14, 78, 46, 110, 30, 94, 62, 126,
+  1, 65, 33, 97, 17, 81, 49, 113, 9, 73, 41, 105, 25, 89, 57, 121,
+  5, 69, 37, 101, 21, 85, 53, 117, 13, 77, 45, 109, 29, 93, 61, 125,
+  3, 67, 35, 99, 19, 83, 51, 115, 11, 75, 43, 107, 27, 91, 59, 123,
+  7, 71, 39, 103, 23, 87, 55, 119, 15, 79, 47, 111, 31, 95, 63, 127
+};
+
+void init_ntt() {
+  unsigned int i, j, k;
+  int16_t tmp[128];
+
+  tmp[0] = MONT;
+  for(i = 1; i < 128; ++i)
+    tmp[i] = fqmul(tmp[i-1], KYBER_ROOT_OF_UNITY*MONT % KYBER_Q);
+
+  for(i = 0; i < 128; ++i)
+    zetas[i] = tmp[tree[i]];
+
+  k = 0;
+  for(i = 64; i >= 1; i >>= 1)
+    for(j = i; j < 2*i; ++j)
+      zetas_inv[k++] = -tmp[128 - tree[j]];
+
+  zetas_inv[127] = MONT * (MONT * (KYBER_Q - 1) * ((KYBER_Q - 1)/128) % KYBER_Q) % KYBER_Q;
+}
+
+*/
+
+const int16_t zetas[128] = {
+  2285, 2571, 2970, 1812, 1493, 1422, 287, 202, 3158, 622, 1577, 182, 962,
+  2127, 1855, 1468, 573, 2004, 264, 383, 2500, 1458, 1727, 3199, 2648, 1017,
+  732, 608, 1787, 411, 3124, 1758, 1223, 652, 2777, 1015, 2036, 1491, 3047,
+  1785, 516, 3321, 3009, 2663, 1711, 2167, 126, 1469, 2476, 3239, 3058, 830,
+  107, 1908, 3082, 2378, 2931, 961, 1821, 2604, 448, 2264, 677, 2054, 2226,
+  430, 555, 843, 2078, 871, 1550, 105, 422, 587, 177, 3094, 3038, 2869, 1574,
+  1653, 3083, 778, 1159, 3182, 2552, 1483, 2727, 1119, 1739, 644, 2457, 349,
+  418, 329, 3173, 3254, 817, 1097, 603, 610, 1322, 2044, 1864, 384, 2114, 3193,
+  1218, 1994, 2455, 220, 2142, 1670, 2144, 1799, 2051, 794, 1819, 2475, 2459,
+  478, 3221, 3021, 996, 991, 958, 1869, 1522, 1628
+};
+
+const int16_t zetas_inv[128] = {
+  1701, 1807, 1460, 2371, 2338, 2333, 308, 108, 2851, 870, 854, 1510, 2535,
+  1278, 1530, 1185, 1659, 1187, 3109, 874, 1335, 2111, 136, 1215, 2945, 1465,
+  1285, 2007, 2719, 2726, 2232, 2512, 75, 156, 3000, 2911, 2980, 872, 2685,
+  1590, 2210, 602, 1846, 777, 147, 2170, 2551, 246, 1676, 1755, 460, 291, 235,
+  3152, 2742, 2907, 3224, 1779, 2458, 1251, 2486, 2774, 2899, 1103, 1275, 2652,
+  1065, 2881, 725, 1508, 2368, 398, 951, 247, 1421, 3222, 2499, 271, 90, 853,
+  1860, 3203, 1162, 1618, 666, 320, 8, 2813, 1544, 282, 1838, 1293, 2314, 552,
+  2677, 2106, 1571, 205, 2918, 1542, 2721, 2597, 2312, 681, 130, 1602, 1871,
+  829, 2946, 3065, 1325, 2756, 1861, 1474, 1202, 2367, 3147, 1752, 2707, 171,
+  3127, 3042, 1907, 1836, 1517, 359, 758, 1441
+};
+
+/*************************************************
+* Name:        fqmul
+*
+* Description: Multiplication followed by Montgomery reduction
+*
+* Arguments:   - int16_t a: first factor
+*              - int16_t b: second factor
+*
+* Returns 16-bit integer congruent to a*b*R^{-1} mod q
+**************************************************/
+static int16_t fqmul(int16_t a, int16_t b) {
+  return montgomery_reduce((int32_t)a*b);
+}
+
+/*
+ * The layers with len >= 16 pair whole vectors of 16 coefficients and use one
+ * zeta per pair. The layers with len in {8,4,2} work on two vectors (32
+ * coefficients) at a time: a shuffle gathers the lower halves of all blocks
+ * into x and the upper halves into y, the butterflies run on x and y with a
+ * zeta per block, and a second shuffle puts the coefficients back in order.
+ * The shuffle indices refer to the concatenation of the two operands.
+ */
+#define GATHER8_LO  0, 1, 2, 3, 4, 5, 6, 7,16,17,18,19,20,21,22,23
+#define GATHER8_HI  8, 9,10,11,12,13,14,15,24,25,26,27,28,29,30,31
+#define GATHER4_LO  0, 1, 2, 3, 8, 9,10,11,16,17,18,19,24,25,26,27
+#define GATHER4_HI  4, 5, 6, 7,12,13,14,15,20,21,22,23,28,29,30,31
+#define SCATTER4_LO 0, 1, 2, 3,16,17,18,19, 4, 5, 6, 7,20,21,22,23
+#define SCATTER4_HI 8, 9,10,11,24,25,26,27,12,13,14,15,28,29,30,31
+#define GATHER2_LO  0, 1, 4, 5, 8, 9,12,13,16,17,20,21,24,25,28,29
+#define GATHER2_HI  2, 3, 6, 7,10,11,14,15,18,19,22,23,26,27,30,31
+#define SCATTER2_LO 0, 1,16,17, 2, 3,18,19, 4, 5,20,21, 6, 7,22,23
+#define SCATTER2_HI 8, 9,24,25,10,11,26,27,12,13,28,29,14,15,30,31
+
+/* Zetas of consecutive blocks, repeated for the len lanes of each block;
+ * z must have 8 readable entries */
+static inline vec16 zetas_len8(const int16_t *z) {
+  vec16h v;
+  memcpy(&v, z, sizeof(v));
+  return __builtin_shufflevector(v, v, 0,0,0,0,0,0,0,0,1,1,1,1,1,1,1,1);
+}
+
+static inline vec16 zetas_len4(const int16_t *z) {
+  vec16h v;
+  memcpy(&v, z, sizeof(v));
+  return __builtin_shufflevector(v, v, 0,0,0,0,1,1,1,1,2,2,2,2,3,3,3,3);
+}
+
+static inline vec16 zetas_len2(const int16_t *z) {
+  vec16h v;
+  memcpy(&v, z, sizeof(v));
+  return __builtin_shufflevector(v, v, 0,0,1,1,2,2,3,3,4,4,5,5,6,6,7,7);
+}
+
+/*************************************************
+* Name:        ntt
+*
+* Description: Inplace number-theoretic transform (NTT) in Rq
+*              input is in standard order, output is in bitreversed order
+*
+* Arguments:   - int16_t r[256]: pointer to input/output vector of elements
+*                                of Zq
+**************************************************/
+void ntt(int16_t r[256]) {
+  unsigned int len, start, j, k;
+  vec16 v[16], x, y, t, zeta;
+
+  for(j = 0; j < 16; ++j)
+    v[j] = vec_load(&r[16*j]);
+
+  k = 1;
+  for(len = 8; len >= 1; len >>= 1) {
+    for(start = 0; start < 16; start = j + len) {
+      zeta = vec_set1(zetas[k++]);
+      for(j = start; j < start + len; ++j) {
+        t = vec_fqmul(zeta, v[j + len]);
+        v[j + len] = v[j] - t;
+        v[j] = v[j] + t;
+      }
+    }
+  }
+
+  for(j = 0; j < 8; ++j) {
+    x = __builtin_shufflevector(v[2*j], v[2*j+1], GATHER8_LO);
+    y = __builtin_shufflevector(v[2*j], v[2*j+1], GATHER8_HI);
+    t = vec_fqmul(zetas_len8(&zetas[16 + 2*j]), y);
+    y = x - t;
+    x = x + t;
+
+    v[2*j]   = __builtin_shufflevector(x, y, GATHER8_LO);
+    v[2*j+1] = __builtin_shufflevector(x, y, GATHER8_HI);
+    x = __builtin_shufflevector(v[2*j], v[2*j+1], GATHER4_LO);
+    y = __builtin_shufflevector(v[2*j], v[2*j+1], GATHER4_HI);
+    t = vec_fqmul(zetas_len4(&zetas[32 + 4*j]), y);
+    y = x - t;
+    x = x + t;
+
+    v[2*j]   = __builtin_shufflevector(x, y, SCATTER4_LO);
+    v[2*j+1] = __builtin_shufflevector(x, y, SCATTER4_HI);
+    x = __builtin_shufflevector(v[2*j], v[2*j+1], GATHER2_LO);
+    y = __builtin_shufflevector(v[2*j], v[2*j+1], GATHER2_HI);
+    t = vec_fqmul(zetas_len2(&zetas[64 + 8*j]), y);
+    y = x - t;
+    x = x + t;
+
+    vec_store(&r[32*j],    __builtin_shufflevector(x, y, SCATTER2_LO));
+    vec_store(&r[32*j+16], __builtin_shufflevector(x, y, SCATTER2_HI));
+  }
+}
+
+/*************************************************
+* Name:        invntt_tomont
+*
+* Description: Inplace inverse number-theoretic transform in Rq and
+*              multiplication by Montgomery factor 2^16.
+*              Input is in bitreversed order, output is in standard order
+*
+* Arguments:   - int16_t r[256]: pointer to input/output vector of elements
+*                                of Zq
+**************************************************/
+void invntt(int16_t r[256]) {
+  unsigned int start, len, j, k;
+  vec16 v[16], x, y, t;
+
+  for(j = 0; j < 8; ++j) {
+    v[2*j]   = vec_load(&r[32*j]);
+    v[2*j+1] = vec_load(&r[32*j+16]);
+
+    x = __builtin_shufflevector(v[2*j], v[2*j+1], GATHER2_LO);
+    y = __builtin_shufflevector(v[2*j], v[2*j+1], GATHER2_HI);
+    t = x;
+    x = vec_barrett(t + y);
+    y = vec_fqmul(zetas_len2(&zetas_inv[8*j]), t - y);
+    v[2*j]   = __builtin_shufflevector(x, y, SCATTER2_LO);
+    v[2*j+1] = __builtin_shufflevector(x, y, SCATTER2_HI);
+
+    x = __builtin_shufflevector(v[2*j], v[2*j+1], GATHER4_LO);
+    y = __builtin_shufflevector(v[2*j], v[2*j+1], GATHER4_HI);
+    t = x;
+    x = vec_barrett(t + y);
+    y = vec_fqmul(zetas_len4(&zetas_inv[64 + 4*j]), t - y);
+    v[2*j]   = __builtin_shufflevector(x, y, SCATTER4_LO);
+    v[2*j+1] = __builtin_shufflevector(x, y, SCATTER4_HI);
+
+    x = __builtin_shufflevector(v[2*j], v[2*j+1], GATHER8_LO);
+    y = __builtin_shufflevector(v[2*j], v[2*j+1], GATHER8_HI);
+    t = x;
+    x = vec_barrett(t + y);
+    y = vec_fqmul(zetas_len8(&zetas_inv[96 + 2*j]), t - y);
+    v[2*j]   = __builtin_shufflevector(x, y, GATHER8_LO);
+    v[2*j+1] = __builtin_shufflevector(x, y, GATHER8_HI);
+  }
+
+  k = 112;
+  for(len = 1; len <= 8; len <<= 1) {
+    for(start = 0; start < 16; start = j + len) {
+      x = vec_set1(zetas_inv[k++]);
+      for(j = start; j < start + len; ++j) {
+        t = v[j];
+        v[j] = vec_barrett(t + v[j + len]);
+        v[j + len] = vec_fqmul(x, t - v[j + len]);
+      }
+    }
+  }
+
+  for(j = 0; j < 16; ++j)
+    vec_store(&r[16*j], vec_fqmul(v[j], vec_set1(zetas_inv[127])));
+}
+
+/*************************************************
+* Name:        basemul
+*
+* Description: Multiplication of polynomials in Zq[X]/(X^2-zeta)
+*              used for multiplication of elements in Rq in NTT domain
+*
+* Arguments:   - int16_t r[2]:       pointer to the output polynomial
+*              - const int16_t a[2]: pointer to the first factor
+*              - const int16_t b[2]: pointer to the second factor
+*              - int16_t zeta:       integer defining the reduction polynomial
+**************************************************/
+void basemul(int16_t r[2],
+             const int16_t a[2],
+             const int16_t b[2],
+             int16_t zeta)
+{
+  r[0]  = fqmul(a[1], b[1]);
+  r[0]  = fqmul(r[0], zeta);
+  r[0] += fqmul(a[0], b[0]);
+
+  r[1]  = fqmul(a[0], b[1]);
+  r[1] += fqmul(a[1], b[0]);
+}
@@ -0,0 +1,82 @@
+#ifndef VEC_H
+#define VEC_H
+
+#include <stdint.h>
+#include <string.h>
+#include "params.h"
+#include "reduce.h"
+
+/*
+ * Portable SIMD types (GCC/Clang vector extensions). A vec16 holds 16
+ * coefficients, a vec16h half as many (used to load zetas) and a vec8 16
+ * bytes; the compiler lowers it to whatever the target has (two SSE2
+ * or NEON registers, one AVX2 register, ...). The reductions perform the
+ * same 16-bit operations as their scalar counterparts in reduce.c, so every
+ * coefficient is bit-for-bit identical to the Optimized build.
+ */
+typedef int16_t vec16 __attribute__((vector_size(32)));
+typedef int16_t vec16h __attribute__((vector_size(16)));
+typedef uint16_t uvec16 __attribute__((vector_size(32)));
+typedef int8_t vec8 __attribute__((vector_size(16)));
+typedef uint8_t uvec8 __attribute__((vector_size(16)));
+
+static inline vec16 vec_load(const int16_t *p)
+{
+  vec16 r;
+  memcpy(&r, p, sizeof(r));
+  return r;
+}
+
+static inline void vec_store(int16_t *p, vec16 a)
+{
+  memcpy(p, &a, sizeof(a));
+}
+
+static inline vec16 vec_set1(int16_t a)
+{
+  vec16 r = {0};
+  return r + a;
+}
+
+/* 16-bit products wrap, as the int16_t stores of the scalar code do */
+static inline vec16 vec_mullo(vec16 a, vec16 b)
+{
+  return (vec16)((uvec16)a * (uvec16)b);
+}
+
+/* Written per lane because compilers recognize this form as the 16-bit
+ * multiply-high instruction (pmulhw, sqdmulh/smull2, ...), which a
+ * widening multiply on 32-bit vectors is not lowered to */
+static inline vec16 vec_mulhi(vec16 a, vec16 b)
+{
+  unsigned int i;
+  vec16 r;
+  for(i=0;i<16;i++)
+    r[i] = ((int32_t)a[i]*b[i]) >> 16;
+  return r;
+}
+
+/* montgomery_reduce(a*b): the low halves of a*b and u*q cancel, so the
+ * result is the difference of the high halves */
+static inline vec16 vec_fqmul(vec16 a, vec16 b)
+{
+  vec16 u = vec_mullo(vec_mullo(a, b), vec_set1((int16_t)QINV));
+  return vec_mulhi(a, b) - vec_mulhi(u, vec_set1(KYBER_Q));
+}
+
+/* barrett_reduce(a): (v*a) >> 26 taken as the high half shifted by 10 */
+static inline vec16 vec_barrett(vec16 a)
+{
+  const int16_t v = ((1U << 26) + KYBER_Q/2)/KYBER_Q;
+  vec16 t = vec_mulhi(a, vec_set1(v)) >> 10;
+  return a - vec_mullo(t, vec_set1(KYBER_Q));
+}
+
+/* csubq(a) */
+static inline vec16 vec_csubq(vec16 a)
+{
+  a -= KYBER_Q;
+  return a + ((a >> 15) & KYBER_Q);
+}
+
+#endif
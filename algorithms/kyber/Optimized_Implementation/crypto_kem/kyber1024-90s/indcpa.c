@@ -176,59 +176,89 @@ static unsigned int rej_uniform(int16_t *r,
 // Not static for benchmarking
 void gen_matrix(polyvec *a, const uint8_t seed[KYBER_SYMBYTES], int transposed)
 {
-  unsigned int ctr, i, j, k;
+  unsigned int i;
+
+  for(i=0;i<KYBER_K;i++)
+    gen_matrix_row(&a[i], seed, i, transposed);
+}
+
+/*************************************************
+* Name:        gen_matrix_row
+*
+* Description: Deterministically generate row i of matrix A (or of the
+*              transpose of A) from a seed, as gen_matrix does for every row.
+*              With KYBER_LOWMEM, indcpa_keypair_derand and indcpa_enc
+*              call this right before multiplying each row, so only one row
+*              of the matrix is ever on the stack
+*
+* Arguments:   - polyvec *a:          pointer to output row
+*              - const uint8_t *seed: pointer to input seed
+*              - unsigned int i:      index of the row
+*              - int transposed:      boolean deciding whether A or A^T
+*                                     is generated
+**************************************************/
+void gen_matrix_row(polyvec *a, const uint8_t seed[KYBER_SYMBYTES], unsigned int i, int transposed)
+{
+  unsigned int ctr, j, k;
   unsigned int buflen, off;
   uint8_t buf[GEN_MATRIX_NBLOCKS*XOF_BLOCKBYTES+2];
   xof_state state;
 
-  for(i=0;i<KYBER_K;i++) {
-    for(j=0;j<KYBER_K;j++) {
-      if(transposed)
-        xof_absorb(&state, seed, i, j);
-      else
-        xof_absorb(&state, seed, j, i);
-
-      xof_squeezeblocks(buf, GEN_MATRIX_NBLOCKS, &state);
-      buflen = GEN_MATRIX_NBLOCKS*XOF_BLOCKBYTES;
-      ctr = rej_uniform(a[i].vec[j].coeffs, KYBER_N, buf, buflen);
-
-      while(ctr < KYBER_N) {
-        off = buflen % 3;
-        for(k = 0; k < off; k++)
-          buf[k] = buf[buflen - off + k];
-        xof_squeezeblocks(buf + off, 1, &state);
-        buflen = off + XOF_BLOCKBYTES;
-        ctr += rej_uniform(a[i].vec[j].coeffs + ctr, KYBER_N - ctr, buf, buflen);
-      }
+  for(j=0;j<KYBER_K;j++) {
+    if(transposed)
+      xof_absorb(&state, seed, i, j);
+    else
+      xof_absorb(&state, seed, j, i);
+
+    xof_squeezeblocks(buf, GEN_MATRIX_NBLOCKS, &state);
+    buflen = GEN_MATRIX_NBLOCKS*XOF_BLOCKBYTES;
+    ctr = rej_uniform(a->vec[j].coeffs, KYBER_N, buf, buflen);
+
+    while(ctr < KYBER_N) {
+      off = buflen % 3;
+      for(k = 0; k < off; k++)
+        buf[k] = buf[buflen - off + k];
+      xof_squeezeblocks(buf + off, 1, &state);
+      buflen = off + XOF_BLOCKBYTES;
+      ctr += rej_uniform(a->vec[j].coeffs + ctr, KYBER_N - ctr, buf, buflen);
     }
   }
 }
 
 /*************************************************
-* Name:        indcpa_keypair
+* Name:        indcpa_keypair_derand
 *
 * Description: Generates public and private key for the CPA-secure
-*              public-key encryption scheme underlying Kyber
+*              public-key encryption scheme underlying Kyber,
+*              deterministically from coins
 *
 * Arguments:   - uint8_t *pk: pointer to output public key
 *                             (of length KYBER_INDCPA_PUBLICKEYBYTES bytes)
 *              - uint8_t *sk: pointer to output private key
                               (of length KYBER_INDCPA_SECRETKEYBYTES bytes)
+*              - const uint8_t *coins: pointer to input randomness
+*                             (of length KYBER_SYMBYTES bytes)
 **************************************************/
-void indcpa_keypair(uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
-                    uint8_t sk[KYBER_INDCPA_SECRETKEYBYTES])
+void indcpa_keypair_derand(uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
+                           uint8_t sk[KYBER_INDCPA_SECRETKEYBYTES],
+                           const uint8_t coins[KYBER_SYMBYTES])
 {
   unsigned int i;
   uint8_t buf[2*KYBER_SYMBYTES];
   const uint8_t *publicseed = buf;
   const uint8_t *noiseseed = buf+KYBER_SYMBYTES;
   uint8_t nonce = 0;
+#ifdef KYBER_LOWMEM
+  polyvec a, e, pkpv, skpv;
+#else
   polyvec a[KYBER_K], e, pkpv, skpv;
+#endif
 
-  randombytes(buf, KYBER_SYMBYTES);
-  hash_g(buf, buf, KYBER_SYMBYTES);
+  hash_g(buf, coins, KYBER_SYMBYTES);
 
+#ifndef KYBER_LOWMEM
   gen_a(a, publicseed);
+#endif
 
   for(i=0;i<KYBER_K;i++)
     poly_getnoise_eta1(&skpv.vec[i], noiseseed, nonce++);
@@ -240,7 +270,12 @@ void indcpa_keypair(uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
 
   // matrix-vector multiplication
   for(i=0;i<KYBER_K;i++) {
+#ifdef KYBER_LOWMEM
+    gen_matrix_row(&a, publicseed, i, 0);
+    polyvec_pointwise_acc_montgomery(&pkpv.vec[i], &a, &skpv);
+#else
     polyvec_pointwise_acc_montgomery(&pkpv.vec[i], &a[i], &skpv);
+#endif
     poly_tomont(&pkpv.vec[i]);
   }
 
@@ -276,12 +311,18 @@ void indcpa_enc(uint8_t c[KYBER_INDCPA_BYTES],
   unsigned int i;
   uint8_t seed[KYBER_SYMBYTES];
   uint8_t nonce = 0;
+#ifdef KYBER_LOWMEM
+  polyvec sp, pkpv, ep, at, bp;
+#else
   polyvec sp, pkpv, ep, at[KYBER_K], bp;
+#endif
   poly v, k, epp;
 
   unpack_pk(&pkpv, seed, pk);
   poly_frommsg(&k, m);
+#ifndef KYBER_LOWMEM
   gen_at(at, seed);
+#endif
 
   for(i=0;i<KYBER_K;i++)
     poly_getnoise_eta1(sp.vec+i, coins, nonce++);
@@ -292,8 +333,14 @@ void indcpa_enc(uint8_t c[KYBER_INDCPA_BYTES],
   polyvec_ntt(&sp);
 
   // matrix-vector multiplication
-  for(i=0;i<KYBER_K;i++)
+  for(i=0;i<KYBER_K;i++) {
+#ifdef KYBER_LOWMEM
+    gen_matrix_row(&at, seed, i, 1);
+    polyvec_pointwise_acc_montgomery(&bp.vec[i], &at, &sp);
+#else
     polyvec_pointwise_acc_montgomery(&bp.vec[i], &at[i], &sp);
+#endif
+  }
 
   polyvec_pointwise_acc_montgomery(&v, &pkpv, &sp);
 
@@ -8,30 +8,60 @@
 #include "indcpa.h"
 
 /*************************************************
-* Name:        crypto_kem_keypair
+* Name:        crypto_kem_keypair_derand
 *
 * Description: Generates public and private key
 *              for CCA-secure Kyber key encapsulation mechanism
+*              deterministically from coins d || z. Nothing else goes into
+*              the keys, so the coins are a compact form of the secret key
+*              that this function expands again
 *
 * Arguments:   - unsigned char *pk: pointer to output public key
 *                (an already allocated array of CRYPTO_PUBLICKEYBYTES bytes)
 *              - unsigned char *sk: pointer to output private key
 *                (an already allocated array of CRYPTO_SECRETKEYBYTES bytes)
+*              - const unsigned char *coins: pointer to input randomness
+*                (an already allocated array of CRYPTO_KEYPAIRCOINBYTES bytes)
 *
 * Returns 0 (success)
 **************************************************/
-int crypto_kem_keypair(unsigned char *pk, unsigned char *sk)
+int crypto_kem_keypair_derand(unsigned char *pk,
+                              unsigned char *sk,
+                              const unsigned char *coins)
 {
   size_t i;
-  indcpa_keypair(pk, sk);
+  indcpa_keypair_derand(pk, sk, coins);
   for(i=0;i<KYBER_INDCPA_PUBLICKEYBYTES;i++)
     sk[i+KYBER_INDCPA_SECRETKEYBYTES] = pk[i];
   hash_h(sk+KYBER_SECRETKEYBYTES-2*KYBER_SYMBYTES, pk, KYBER_PUBLICKEYBYTES);
   /* Value z for pseudo-random output on reject */
-  randombytes(sk+KYBER_SECRETKEYBYTES-KYBER_SYMBYTES, KYBER_SYMBYTES);
+  for(i=0;i<KYBER_SYMBYTES;i++)
+    sk[i+KYBER_SECRETKEYBYTES-KYBER_SYMBYTES] = coins[i+KYBER_SYMBYTES];
   return 0;
 }
 
+/*************************************************
+* Name:        crypto_kem_keypair
+*
+* Description: Generates public and private key
+*              for CCA-secure Kyber key encapsulation mechanism
+*
+* Arguments:   - unsigned char *pk: pointer to output public key
+*                (an already allocated array of CRYPTO_PUBLICKEYBYTES bytes)
+*              - unsigned char *sk: pointer to output private key
+*                (an already allocated array of CRYPTO_SECRETKEYBYTES bytes)
+*
+* Returns 0 (success)
+**************************************************/
+int crypto_kem_keypair(unsigned char *pk, unsigned char *sk)
+{
+  uint8_t coins[2*KYBER_SYMBYTES];
+  /* d, then z, drawn separately as before so the KATs are unchanged */
+  randombytes(coins, KYBER_SYMBYTES);
+  randombytes(coins+KYBER_SYMBYTES, KYBER_SYMBYTES);
+  return crypto_kem_keypair_derand(pk, sk, coins);
+}
+
 /*************************************************
 * Name:        crypto_kem_enc
 *
@@ -15,6 +15,16 @@ typedef struct {
   uint64_t s[25];
 } keccak_state;
 
+typedef struct {
+  uint64_t s[25];
+  unsigned int pos;
+} sha3_256incctx;
+
+typedef struct {
+  uint64_t s[25];
+  unsigned int pos;
+} shake256incctx;
+
 #define shake128_absorb FIPS202_NAMESPACE(_shake128_absorb)
 void shake128_absorb(keccak_state *state, const uint8_t *in, size_t inlen);
 #define shake128_squeezeblocks FIPS202_NAMESPACE(_shake128_squeezeblocks)
@@ -28,8 +38,20 @@ void shake256_squeezeblocks(uint8_t *out, size_t nblocks,  keccak_state *state);
 void shake128(uint8_t *out, size_t outlen, const uint8_t *in, size_t inlen);
 #define shake256 FIPS202_NAMESPACE(_shake256)
 void shake256(uint8_t *out, size_t outlen, const uint8_t *in, size_t inlen);
+#define shake256_inc_init FIPS202_NAMESPACE(_shake256_inc_init)
+void shake256_inc_init(shake256incctx *state);
+#define shake256_inc_absorb FIPS202_NAMESPACE(_shake256_inc_absorb)
+void shake256_inc_absorb(shake256incctx *state, const uint8_t *in, size_t inlen);
+#define shake256_inc_finalize FIPS202_NAMESPACE(_shake256_inc_finalize)
+void shake256_inc_finalize(uint8_t *out, size_t outlen, shake256incctx *state);
 #define sha3_256 FIPS202_NAMESPACE(_sha3_256)
 void sha3_256(uint8_t h[32], const uint8_t *in, size_t inlen);
+#define sha3_256_inc_init FIPS202_NAMESPACE(_sha3_256_inc_init)
+void sha3_256_inc_init(sha3_256incctx *state);
+#define sha3_256_inc_absorb FIPS202_NAMESPACE(_sha3_256_inc_absorb)
+void sha3_256_inc_absorb(sha3_256incctx *state, const uint8_t *in, size_t inlen);
+#define sha3_256_inc_finalize FIPS202_NAMESPACE(_sha3_256_inc_finalize)
+void sha3_256_inc_finalize(uint8_t h[32], sha3_256incctx *state);
 #define sha3_512 FIPS202_NAMESPACE(_sha3_512)
 void sha3_512(uint8_t h[64], const uint8_t *in, size_t inlen);
 
@@ -50,6 +50,55 @@ void poly_compress(uint8_t r[KYBER_POLYCOMPRESSEDBYTES], poly *a)
 #endif
 }
 
+/*************************************************
+* Name:        poly_compress_cmp
+*
+* Description: Compresses a polynomial like poly_compress, but compares
+*              each byte with r instead of writing it, in constant time
+*
+* Arguments:   - const uint8_t *r: pointer to byte array to compare with
+*                                  (of length KYBER_POLYCOMPRESSEDBYTES)
+*              - poly *a:          pointer to input polynomial
+*
+* Returns 0 if the bytes are equal, non-zero otherwise
+**************************************************/
+uint8_t poly_compress_cmp(const uint8_t r[KYBER_POLYCOMPRESSEDBYTES], poly *a)
+{
+  unsigned int i,j;
+  uint8_t t[8];
+  uint8_t rc = 0;
+
+  poly_csubq(a);
+
+#if (KYBER_POLYCOMPRESSEDBYTES == 128)
+  for(i=0;i<KYBER_N/8;i++) {
+    for(j=0;j<8;j++)
+      t[j] = ((((uint16_t)a->coeffs[8*i+j] << 4) + KYBER_Q/2)/KYBER_Q) & 15;
+
+    rc |= r[0] ^ (uint8_t)(t[0] | (t[1] << 4));
+    rc |= r[1] ^ (uint8_t)(t[2] | (t[3] << 4));
+    rc |= r[2] ^ (uint8_t)(t[4] | (t[5] << 4));
+    rc |= r[3] ^ (uint8_t)(t[6] | (t[7] << 4));
+    r += 4;
+  }
+#elif (KYBER_POLYCOMPRESSEDBYTES == 160)
+  for(i=0;i<KYBER_N/8;i++) {
+    for(j=0;j<8;j++)
+      t[j] = ((((uint32_t)a->coeffs[8*i+j] << 5) + KYBER_Q/2)/KYBER_Q) & 31;
+
+    rc |= r[0] ^ (uint8_t)((t[0] >> 0) | (t[1] << 5));
+    rc |= r[1] ^ (uint8_t)((t[1] >> 3) | (t[2] << 2) | (t[3] << 7));
+    rc |= r[2] ^ (uint8_t)((t[3] >> 1) | (t[4] << 4));
+    rc |= r[3] ^ (uint8_t)((t[4] >> 4) | (t[5] << 1) | (t[6] << 6));
+    rc |= r[4] ^ (uint8_t)((t[6] >> 2) | (t[7] << 3));
+    r += 5;
+  }
+#else
+#error "KYBER_POLYCOMPRESSEDBYTES needs to be in {128, 160}"
+#endif
+  return rc;
+}
+
 /*************************************************
 * Name:        poly_decompress
 *
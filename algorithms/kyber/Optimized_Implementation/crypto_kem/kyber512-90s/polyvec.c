@@ -62,57 +62,73 @@ void polyvec_compress(uint8_t r[KYBER_POLYVECCOMPRESSEDBYTES], polyvec *a)
 }
 
 /*************************************************
-* Name:        polyvec_decompress
+* Name:        polyvec_decompress_poly
 *
-* Description: De-serialize and decompress vector of polynomials;
-*              approximate inverse of polyvec_compress
+* Description: De-serialize and decompress one polynomial of a compressed
+*              vector of polynomials, so a vector can be decompressed
+*              one polynomial at a time as its bytes arrive
 *
-* Arguments:   - polyvec *r:       pointer to output vector of polynomials
+* Arguments:   - poly *r:          pointer to output polynomial
 *              - const uint8_t *a: pointer to input byte array
-*                                  (of length KYBER_POLYVECCOMPRESSEDBYTES)
+*                                  (of length KYBER_POLYVECCOMPRESSEDBYTES/KYBER_K)
 **************************************************/
-void polyvec_decompress(polyvec *r,
-                        const uint8_t a[KYBER_POLYVECCOMPRESSEDBYTES])
+void polyvec_decompress_poly(poly *r,
+                             const uint8_t a[KYBER_POLYVECCOMPRESSEDBYTES/KYBER_K])
 {
-  unsigned int i,j,k;
+  unsigned int j,k;
 
 #if (KYBER_POLYVECCOMPRESSEDBYTES == (KYBER_K * 352))
   uint16_t t[8];
-  for(i=0;i<KYBER_K;i++) {
-    for(j=0;j<KYBER_N/8;j++) {
-      t[0] = (a[0] >> 0) | ((uint16_t)a[ 1] << 8);
-      t[1] = (a[1] >> 3) | ((uint16_t)a[ 2] << 5);
-      t[2] = (a[2] >> 6) | ((uint16_t)a[ 3] << 2) | ((uint16_t)a[4] << 10);
-      t[3] = (a[4] >> 1) | ((uint16_t)a[ 5] << 7);
-      t[4] = (a[5] >> 4) | ((uint16_t)a[ 6] << 4);
-      t[5] = (a[6] >> 7) | ((uint16_t)a[ 7] << 1) | ((uint16_t)a[8] << 9);
-      t[6] = (a[8] >> 2) | ((uint16_t)a[ 9] << 6);
-      t[7] = (a[9] >> 5) | ((uint16_t)a[10] << 3);
-      a += 11;
+  for(j=0;j<KYBER_N/8;j++) {
+    t[0] = (a[0] >> 0) | ((uint16_t)a[ 1] << 8);
+    t[1] = (a[1] >> 3) | ((uint16_t)a[ 2] << 5);
+    t[2] = (a[2] >> 6) | ((uint16_t)a[ 3] << 2) | ((uint16_t)a[4] << 10);
+    t[3] = (a[4] >> 1) | ((uint16_t)a[ 5] << 7);
+    t[4] = (a[5] >> 4) | ((uint16_t)a[ 6] << 4);
+    t[5] = (a[6] >> 7) | ((uint16_t)a[ 7] << 1) | ((uint16_t)a[8] << 9);
+    t[6] = (a[8] >> 2) | ((uint16_t)a[ 9] << 6);
+    t[7] = (a[9] >> 5) | ((uint16_t)a[10] << 3);
+    a += 11;
 
-      for(k=0;k<8;k++)
-        r->vec[i].coeffs[8*j+k] = ((uint32_t)(t[k] & 0x7FF)*KYBER_Q + 1024) >> 11;
-    }
+    for(k=0;k<8;k++)
+      r->coeffs[8*j+k] = ((uint32_t)(t[k] & 0x7FF)*KYBER_Q + 1024) >> 11;
   }
 #elif (KYBER_POLYVECCOMPRESSEDBYTES == (KYBER_K * 320))
   uint16_t t[4];
-  for(i=0;i<KYBER_K;i++) {
-    for(j=0;j<KYBER_N/4;j++) {
-      t[0] = (a[0] >> 0) | ((uint16_t)a[1] << 8);
-      t[1] = (a[1] >> 2) | ((uint16_t)a[2] << 6);
-      t[2] = (a[2] >> 4) | ((uint16_t)a[3] << 4);
-      t[3] = (a[3] >> 6) | ((uint16_t)a[4] << 2);
-      a += 5;
+  for(j=0;j<KYBER_N/4;j++) {
+    t[0] = (a[0] >> 0) | ((uint16_t)a[1] << 8);
+    t[1] = (a[1] >> 2) | ((uint16_t)a[2] << 6);
+    t[2] = (a[2] >> 4) | ((uint16_t)a[3] << 4);
+    t[3] = (a[3] >> 6) | ((uint16_t)a[4] << 2);
+    a += 5;
 
-      for(k=0;k<4;k++)
-        r->vec[i].coeffs[4*j+k] = ((uint32_t)(t[k] & 0x3FF)*KYBER_Q + 512) >> 10;
-    }
+    for(k=0;k<4;k++)
+      r->coeffs[4*j+k] = ((uint32_t)(t[k] & 0x3FF)*KYBER_Q + 512) >> 10;
   }
 #else
 #error "KYBER_POLYVECCOMPRESSEDBYTES needs to be in {320*KYBER_K, 352*KYBER_K}"
 #endif
 }
 
+/*************************************************
+* Name:        polyvec_decompress
+*
+* Description: De-serialize and decompress vector of polynomials;
+*              approximate inverse of polyvec_compress
+*
+* Arguments:   - polyvec *r:       pointer to output vector of polynomials
+*              - const uint8_t *a: pointer to input byte array
+*                                  (of length KYBER_POLYVECCOMPRESSEDBYTES)
+**************************************************/
+void polyvec_decompress(polyvec *r,
+                        const uint8_t a[KYBER_POLYVECCOMPRESSEDBYTES])
+{
+  unsigned int i;
+
+  for(i=0;i<KYBER_K;i++)
+    polyvec_decompress_poly(&r->vec[i], a+i*(KYBER_POLYVECCOMPRESSEDBYTES/KYBER_K));
+}
+
 /*************************************************
 * Name:        polyvec_tobytes
 *
@@ -11,6 +11,9 @@ typedef struct{
 
 #define polyvec_compress KYBER_NAMESPACE(_polyvec_compress)
 void polyvec_compress(uint8_t r[KYBER_POLYVECCOMPRESSEDBYTES], polyvec *a);
+#define polyvec_decompress_poly KYBER_NAMESPACE(_polyvec_decompress_poly)
+void polyvec_decompress_poly(poly *r,
+                             const uint8_t a[KYBER_POLYVECCOMPRESSEDBYTES/KYBER_K]);
 #define polyvec_decompress KYBER_NAMESPACE(_polyvec_decompress)
 void polyvec_decompress(polyvec *r,
                         const uint8_t a[KYBER_POLYVECCOMPRESSEDBYTES]);
@@ -389,6 +389,76 @@ static void keccak_absorb(uint64_t s[25],
     s[i] ^= load64(t + 8*i);
 }
 
+/*************************************************
+* Name:        keccak_inc_absorb
+*
+* Description: Incremental absorb step of Keccak; absorbs input into a
+*              state that already holds pos bytes of the current block.
+*              Can be called multiple times before keccak_inc_finalize
+*
+* Arguments:   - uint64_t *s:       pointer to input/output Keccak state
+*              - unsigned int pos:  position in the current block
+*              - unsigned int r:    rate in bytes (e.g., 136 for SHA3-256)
+*              - const uint8_t *in: pointer to input to be absorbed into s
+*              - size_t inlen:      length of input in bytes
+*
+* Returns new position in the current block
+**************************************************/
+static unsigned int keccak_inc_absorb(uint64_t s[25],
+                                      unsigned int pos,
+                                      unsigned int r,
+                                      const uint8_t *in,
+                                      size_t inlen)
+{
+  unsigned int i, end;
+
+  /* Bytes up to the next word boundary, then whole words */
+  while(pos+inlen >= r) {
+    for(i=pos;i<r && i%8;i++)
+      s[i/8] ^= (uint64_t)*in++ << 8*(i%8);
+    for(;i<r;i+=8) {
+      s[i/8] ^= load64(in);
+      in += 8;
+    }
+    inlen -= r-pos;
+    pos = 0;
+    KeccakF1600_StatePermute(s);
+  }
+
+  end = pos+inlen;
+  for(i=pos;i<end && i%8;i++)
+    s[i/8] ^= (uint64_t)*in++ << 8*(i%8);
+  for(;i+8<=end;i+=8) {
+    s[i/8] ^= load64(in);
+    in += 8;
+  }
+  for(;i<end;i++)
+    s[i/8] ^= (uint64_t)*in++ << 8*(i%8);
+
+  return i;
+}
+
+/*************************************************
+* Name:        keccak_inc_finalize
+*
+* Description: Finalize absorb step of Keccak: adds the domain-separation
+*              byte and the final padding bit after pos absorbed bytes
+*
+* Arguments:   - uint64_t *s:      pointer to input/output Keccak state
+*              - unsigned int pos: position in the current block
+*              - unsigned int r:   rate in bytes (e.g., 136 for SHA3-256)
+*              - uint8_t p:        domain-separation byte for different
+*                                  Keccak-derived functions
+**************************************************/
+static void keccak_inc_finalize(uint64_t s[25],
+                                unsigned int pos,
+                                unsigned int r,
+                                uint8_t p)
+{
+  s[pos/8] ^= (uint64_t)p << 8*(pos%8);
+  s[r/8-1] ^= 1ULL << 63;
+}
+
 /*************************************************
 * Name:        keccak_squeezeblocks
 *
@@ -541,6 +611,67 @@ void shake256(uint8_t *out, size_t outlen, const uint8_t *in, size_t inlen)
   }
 }
 
+/*************************************************
+* Name:        shake256_inc_init
+*
+* Description: Initializes the state of SHAKE256 with incremental API
+*
+* Arguments:   - shake256incctx *state: pointer to (uninitialized) state
+**************************************************/
+void shake256_inc_init(shake256incctx *state)
+{
+  unsigned int i;
+  for(i=0;i<25;i++)
+    state->s[i] = 0;
+  state->pos = 0;
+}
+
+/*************************************************
+* Name:        shake256_inc_absorb
+*
+* Description: Absorbs the next inlen bytes into the SHAKE256 state; the
+*              output is the same whichever way the input was split into
+*              calls
+*
+* Arguments:   - shake256incctx *state: pointer to input/output state
+*              - const uint8_t *in:     pointer to input
+*              - size_t inlen:          length of input in bytes
+**************************************************/
+void shake256_inc_absorb(shake256incctx *state, const uint8_t *in, size_t inlen)
+{
+  state->pos = keccak_inc_absorb(state->s, state->pos, SHAKE256_RATE, in, inlen);
+}
+
+/*************************************************
+* Name:        shake256_inc_finalize
+*
+* Description: Pads the absorbed input and writes out outlen bytes of
+*              SHAKE256 output
+*
+* Arguments:   - uint8_t *out:          pointer to output
+*              - size_t outlen:         requested output length in bytes
+*              - shake256incctx *state: pointer to input state, which
+*                                       can't absorb any more afterwards
+**************************************************/
+void shake256_inc_finalize(uint8_t *out, size_t outlen, shake256incctx *state)
+{
+  unsigned int i;
+  size_t nblocks = outlen/SHAKE256_RATE;
+  uint8_t t[SHAKE256_RATE];
+
+  keccak_inc_finalize(state->s, state->pos, SHAKE256_RATE, 0x1F);
+  keccak_squeezeblocks(out, nblocks, state->s, SHAKE256_RATE);
+
+  out += nblocks*SHAKE256_RATE;
+  outlen -= nblocks*SHAKE256_RATE;
+
+  if(outlen) {
+    keccak_squeezeblocks(t, 1, state->s, SHAKE256_RATE);
+    for(i=0;i<outlen;i++)
+      out[i] = t[i];
+  }
+}
+
 /*************************************************
 * Name:        sha3_256
 *
@@ -563,6 +694,58 @@ void sha3_256(uint8_t h[32], const uint8_t *in, size_t inlen)
     h[i] = t[i];
 }
 
+/*************************************************
+* Name:        sha3_256_inc_init
+*
+* Description: Initializes the state of SHA3-256 with incremental API
+*
+* Arguments:   - sha3_256incctx *state: pointer to (uninitialized) state
+**************************************************/
+void sha3_256_inc_init(sha3_256incctx *state)
+{
+  unsigned int i;
+  for(i=0;i<25;i++)
+    state->s[i] = 0;
+  state->pos = 0;
+}
+
+/*************************************************
+* Name:        sha3_256_inc_absorb
+*
+* Description: Absorbs the next inlen bytes into the SHA3-256 state; the
+*              hash of all absorbed bytes is the same whichever way they
+*              were split into calls
+*
+* Arguments:   - sha3_256incctx *state: pointer to input/output state
+*              - const uint8_t *in:     pointer to input
+*              - size_t inlen:          length of input in bytes
+**************************************************/
+void sha3_256_inc_absorb(sha3_256incctx *state, const uint8_t *in, size_t inlen)
+{
+  state->pos = keccak_inc_absorb(state->s, state->pos, SHA3_256_RATE, in, inlen);
+}
+
+/*************************************************
+* Name:        sha3_256_inc_finalize
+*
+* Description: Pads the absorbed input and writes out the SHA3-256 hash
+*
+* Arguments:   - uint8_t *h:            pointer to output (32 bytes)
+*              - sha3_256incctx *state: pointer to input state, which
+*                                       can't absorb any more afterwards
+**************************************************/
+void sha3_256_inc_finalize(uint8_t h[32], sha3_256incctx *state)
+{
+  unsigned int i;
+  uint8_t t[SHA3_256_RATE];
+
+  keccak_inc_finalize(state->s, state->pos, SHA3_256_RATE, 0x06);
+  keccak_squeezeblocks(t, 1, state->s, SHA3_256_RATE);
+
+  for(i=0;i<32;i++)
+    h[i] = t[i];
+}
+
 /*************************************************
 * Name:        sha3_512
 *
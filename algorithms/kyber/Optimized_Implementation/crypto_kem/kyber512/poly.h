@@ -14,6 +14,8 @@ typedef struct{
 
 #define poly_compress KYBER_NAMESPACE(_poly_compress)
 void poly_compress(uint8_t r[KYBER_POLYCOMPRESSEDBYTES], poly *a);
+#define poly_compress_cmp KYBER_NAMESPACE(_poly_compress_cmp)
+uint8_t poly_compress_cmp(const uint8_t r[KYBER_POLYCOMPRESSEDBYTES], poly *a);
 #define poly_decompress KYBER_NAMESPACE(_poly_decompress)
 void poly_decompress(poly *r, const uint8_t a[KYBER_POLYCOMPRESSEDBYTES]);
 
@@ -11,6 +11,12 @@ typedef struct{
 
 #define polyvec_compress KYBER_NAMESPACE(_polyvec_compress)
 void polyvec_compress(uint8_t r[KYBER_POLYVECCOMPRESSEDBYTES], polyvec *a);
+#define polyvec_compress_poly_cmp KYBER_NAMESPACE(_polyvec_compress_poly_cmp)
+uint8_t polyvec_compress_poly_cmp(const uint8_t r[KYBER_POLYVECCOMPRESSEDBYTES/KYBER_K],
+                                  poly *a);
+#define polyvec_decompress_poly KYBER_NAMESPACE(_polyvec_decompress_poly)
+void polyvec_decompress_poly(poly *r,
+                             const uint8_t a[KYBER_POLYVECCOMPRESSEDBYTES/KYBER_K]);
 #define polyvec_decompress KYBER_NAMESPACE(_polyvec_decompress)
 void polyvec_decompress(polyvec *r,
                         const uint8_t a[KYBER_POLYVECCOMPRESSEDBYTES]);
@@ -19,6 +25,8 @@ void polyvec_decompress(polyvec *r,
 void polyvec_tobytes(uint8_t r[KYBER_POLYVECBYTES], polyvec *a);
 #define polyvec_frombytes KYBER_NAMESPACE(_polyvec_frombytes)
 void polyvec_frombytes(polyvec *r, const uint8_t a[KYBER_POLYVECBYTES]);
+#define polyvec_check_modulus KYBER_NAMESPACE(_polyvec_check_modulus)
+int polyvec_check_modulus(const uint8_t a[KYBER_POLYVECBYTES]);
 
 #define polyvec_ntt KYBER_NAMESPACE(_polyvec_ntt)
 void polyvec_ntt(polyvec *r);
@@ -0,0 +1,279 @@
+#include <stddef.h>
+#include <stdint.h>
+#include "params.h"
+#include "stream.h"
+#include "indcpa.h"
+#include "poly.h"
+#include "polyvec.h"
+#include "rng.h"
+#include "symmetric.h"
+#include "verify.h"
+
+#ifdef KYBER_90S
+#error "Streaming needs the incremental SHA3-256 of fips202.c"
+#endif
+
+/* Bytes of one compressed polynomial of u in the ciphertext */
+#define KYBER_POLYCOMPRESSEDROWBYTES (KYBER_POLYVECCOMPRESSEDBYTES/KYBER_K)
+
+/*************************************************
+* Name:        crypto_kem_enc_init
+*
+* Description: Starts a streaming encapsulation, before any byte of the
+*              public key has arrived
+*
+* Arguments:   - crypto_kem_enc_state *state: pointer to output state
+*
+* Returns 0 (success)
+**************************************************/
+int crypto_kem_enc_init(crypto_kem_enc_state *state)
+{
+  state->len = 0;
+  sha3_256_inc_init(&state->h);
+  return 0;
+}
+
+/*************************************************
+* Name:        crypto_kem_enc_update
+*
+* Description: Takes the next chunk of the public key and absorbs it into
+*              H(pk), so only the encryption itself is left for the last
+*              byte
+*
+* Arguments:   - crypto_kem_enc_state *state: pointer to input/output state
+*              - const unsigned char *pk:     pointer to chunk of public key
+*              - size_t pklen:                length of chunk in bytes
+*
+* Returns 0 on success, -1 if the chunk runs past the public key
+**************************************************/
+int crypto_kem_enc_update(crypto_kem_enc_state *state,
+                          const unsigned char *pk,
+                          size_t pklen)
+{
+  size_t i;
+
+  if(pklen > KYBER_PUBLICKEYBYTES - state->len)
+    return -1;
+
+  for(i=0;i<pklen;i++)
+    state->pk[state->len+i] = pk[i];
+  state->len += pklen;
+
+  sha3_256_inc_absorb(&state->h, pk, pklen);
+  return 0;
+}
+
+/*************************************************
+* Name:        crypto_kem_enc_final
+*
+* Description: Generates cipher text and shared secret once the whole
+*              public key was passed to crypto_kem_enc_update; the same as
+*              crypto_kem_enc on that public key
+*
+* Arguments:   - unsigned char *ct:           pointer to output cipher text
+*                (an already allocated array of CRYPTO_CIPHERTEXTBYTES bytes)
+*              - unsigned char *ss:           pointer to output shared secret
+*                (an already allocated array of CRYPTO_BYTES bytes)
+*              - crypto_kem_enc_state *state: pointer to input state
+*
+* Returns 0 on success, -1 if the public key is incomplete or fails
+* ML-KEM's modulus check
+**************************************************/
+int crypto_kem_enc_final(unsigned char *ct,
+                         unsigned char *ss,
+                         crypto_kem_enc_state *state)
+{
+#ifdef KYBER_MLKEM
+  size_t i;
+#endif
+  uint8_t buf[2*KYBER_SYMBYTES];
+  /* Will contain key, coins */
+  uint8_t kr[2*KYBER_SYMBYTES];
+
+  if(state->len != KYBER_PUBLICKEYBYTES)
+    return -1;
+#ifdef KYBER_MLKEM
+  /* FIPS 203 input check, as in crypto_kem_enc */
+  if(polyvec_check_modulus(state->pk))
+    return -1;
+#endif
+
+  randombytes(buf, KYBER_SYMBYTES);
+#ifndef KYBER_MLKEM
+  /* Don't release system RNG output */
+  hash_h(buf, buf, KYBER_SYMBYTES);
+#endif
+
+  /* Multitarget countermeasure for coins + contributory KEM */
+  sha3_256_inc_finalize(buf+KYBER_SYMBYTES, &state->h);
+  hash_g(kr, buf, 2*KYBER_SYMBYTES);
+
+  /* coins are in kr+KYBER_SYMBYTES */
+  indcpa_enc(ct, buf, state->pk, kr+KYBER_SYMBYTES);
+
+#ifdef KYBER_MLKEM
+  for(i=0;i<KYBER_SSBYTES;i++)
+    ss[i] = kr[i];
+#else
+  /* overwrite coins in kr with H(c) */
+  hash_h(kr+KYBER_SYMBYTES, ct, KYBER_CIPHERTEXTBYTES);
+  /* hash concatenation of pre-k and H(c) to k */
+  kdf(ss, kr, 2*KYBER_SYMBYTES);
+#endif
+  return 0;
+}
+
+/*************************************************
+* Name:        crypto_kem_dec_init
+*
+* Description: Starts a streaming decapsulation, before any byte of the
+*              cipher text has arrived
+*
+* Arguments:   - crypto_kem_dec_state *state: pointer to output state
+*              - const unsigned char *sk:     pointer to input private key,
+*                which has to stay valid until crypto_kem_dec_final
+*                (an already allocated array of CRYPTO_SECRETKEYBYTES bytes)
+*
+* Returns 0 (success)
+**************************************************/
+int crypto_kem_dec_init(crypto_kem_dec_state *state,
+                        const unsigned char *sk)
+{
+  state->len = 0;
+  state->rows = 0;
+  state->sk = sk;
+#ifdef KYBER_MLKEM
+  /* z is known up front, so J(z || c) takes c as it arrives */
+  shake256_inc_init(&state->j);
+  shake256_inc_absorb(&state->j, sk+KYBER_SECRETKEYBYTES-KYBER_SYMBYTES, KYBER_SYMBYTES);
+#else
+  sha3_256_inc_init(&state->h);
+#endif
+  return 0;
+}
+
+/*************************************************
+* Name:        crypto_kem_dec_update
+*
+* Description: Takes the next chunk of the cipher text, absorbs it into
+*              H(c) (J(z || c) for ML-KEM) and, for every polynomial of u
+*              it completes, decompresses it, transforms it to the NTT
+*              domain and accumulates its product with the secret key, as
+*              indcpa_dec does for the whole vector
+*
+* Arguments:   - crypto_kem_dec_state *state: pointer to input/output state
+*              - const unsigned char *ct:     pointer to chunk of cipher text
+*              - size_t ctlen:                length of chunk in bytes
+*
+* Returns 0 on success, -1 if the chunk runs past the cipher text
+**************************************************/
+int crypto_kem_dec_update(crypto_kem_dec_state *state,
+                          const unsigned char *ct,
+                          size_t ctlen)
+{
+  size_t i;
+  poly bp, skp, t;
+
+  if(ctlen > KYBER_CIPHERTEXTBYTES - state->len)
+    return -1;
+
+  for(i=0;i<ctlen;i++)
+    state->ct[state->len+i] = ct[i];
+  state->len += ctlen;
+
+#ifdef KYBER_MLKEM
+  shake256_inc_absorb(&state->j, ct, ctlen);
+#else
+  sha3_256_inc_absorb(&state->h, ct, ctlen);
+#endif
+
+  while(state->rows < KYBER_K
+        && state->len >= (state->rows+1)*KYBER_POLYCOMPRESSEDROWBYTES) {
+    polyvec_decompress_poly(&bp, state->ct+state->rows*KYBER_POLYCOMPRESSEDROWBYTES);
+    poly_ntt(&bp);
+    poly_frombytes(&skp, state->sk+state->rows*KYBER_POLYBYTES);
+
+    if(state->rows == 0) {
+      poly_basemul_montgomery(&state->mp, &skp, &bp);
+    } else {
+      poly_basemul_montgomery(&t, &skp, &bp);
+      poly_add(&state->mp, &state->mp, &t);
+    }
+    state->rows++;
+  }
+  return 0;
+}
+
+/*************************************************
+* Name:        crypto_kem_dec_final
+*
+* Description: Generates shared secret once the whole cipher text was
+*              passed to crypto_kem_dec_update; the same as crypto_kem_dec
+*              on that cipher text
+*
+* Arguments:   - unsigned char *ss:           pointer to output shared secret
+*                (an already allocated array of CRYPTO_BYTES bytes)
+*              - crypto_kem_dec_state *state: pointer to input state
+*
+* Returns 0 on success, -1 if the cipher text is incomplete.
+*
+* On failure of the re-encryption check, ss will contain a pseudo-random
+* value, as with crypto_kem_dec.
+**************************************************/
+int crypto_kem_dec_final(unsigned char *ss,
+                         crypto_kem_dec_state *state)
+{
+  size_t i;
+  int fail;
+  uint8_t buf[2*KYBER_SYMBYTES];
+  /* Will contain key, coins */
+  uint8_t kr[2*KYBER_SYMBYTES];
+  const uint8_t *sk = state->sk;
+  const uint8_t *pk = sk+KYBER_INDCPA_SECRETKEYBYTES;
+  poly v;
+#ifndef KYBER_FUSED
+  uint8_t cmp[KYBER_CIPHERTEXTBYTES];
+#endif
+
+  if(state->len != KYBER_CIPHERTEXTBYTES)
+    return -1;
+
+  /* Rest of indcpa_dec, with s^T NTT(u) accumulated in mp */
+  poly_reduce(&state->mp);
+  poly_invntt_tomont(&state->mp);
+  poly_decompress(&v, state->ct+KYBER_POLYVECCOMPRESSEDBYTES);
+  poly_sub(&state->mp, &v, &state->mp);
+  poly_reduce(&state->mp);
+  poly_tomsg(buf, &state->mp);
+
+  /* Multitarget countermeasure for coins + contributory KEM */
+  for(i=0;i<KYBER_SYMBYTES;i++)
+    buf[KYBER_SYMBYTES+i] = sk[KYBER_SECRETKEYBYTES-2*KYBER_SYMBYTES+i];
+  hash_g(kr, buf, 2*KYBER_SYMBYTES);
+
+#ifdef KYBER_FUSED
+  /* coins are in kr+KYBER_SYMBYTES, compared with the cipher text as re-encrypted */
+  fail = indcpa_enc_cmp(state->ct, buf, pk, kr+KYBER_SYMBYTES, NULL);
+#else
+  /* coins are in kr+KYBER_SYMBYTES */
+  indcpa_enc(cmp, buf, pk, kr+KYBER_SYMBYTES);
+
+  fail = verify(state->ct, cmp, KYBER_CIPHERTEXTBYTES);
+#endif
+
+#ifdef KYBER_MLKEM
+  /* Rejection key J(z || c), absorbed as the cipher text arrived */
+  shake256_inc_finalize(ss, KYBER_SSBYTES, &state->j);
+  cmov(ss, kr, KYBER_SYMBYTES, !fail);
+#else
+  /* overwrite coins in kr with H(c), absorbed as the cipher text arrived */
+  sha3_256_inc_finalize(kr+KYBER_SYMBYTES, &state->h);
+
+  /* Overwrite pre-k with z on re-encryption failure */
+  cmov(kr, sk+KYBER_SECRETKEYBYTES-KYBER_SYMBYTES, KYBER_SYMBYTES, fail);
+
+  /* hash concatenation of pre-k and H(c) to k */
+  kdf(ss, kr, 2*KYBER_SYMBYTES);
+#endif
+  return 0;
+}
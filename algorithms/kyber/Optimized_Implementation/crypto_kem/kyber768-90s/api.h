@@ -8,6 +8,9 @@
 #define CRYPTO_CIPHERTEXTBYTES KYBER_CIPHERTEXTBYTES
 #define CRYPTO_BYTES           KYBER_SSBYTES
 
+/* Keygen coins d || z, the compact form of a secret key */
+#define CRYPTO_KEYPAIRCOINBYTES (2*KYBER_SYMBYTES)
+
 #if   (KYBER_K == 2)
 #ifdef KYBER_90S
 #define CRYPTO_ALGNAME "Kyber512-90s"
@@ -31,6 +34,11 @@
 #define crypto_kem_keypair KYBER_NAMESPACE(_keypair)
 int crypto_kem_keypair(unsigned char *pk, unsigned char *sk);
 
+#define crypto_kem_keypair_derand KYBER_NAMESPACE(_keypair_derand)
+int crypto_kem_keypair_derand(unsigned char *pk,
+                              unsigned char *sk,
+                              const unsigned char *coins);
+
 #define crypto_kem_enc KYBER_NAMESPACE(_enc)
 int crypto_kem_enc(unsigned char *ct,
                    unsigned char *ss,
@@ -6,23 +6,62 @@
 #endif
 
 //#define KYBER_90S	/* Uncomment this if you want the 90S variant */
+//#define KYBER_LOWMEM	/* Uncomment this to generate the matrix row by row, see indcpa.c */
+//#define KYBER_COMPACT	/* Set by the build of Additional_Implementations/compact */
+//#define KYBER_AVX512	/* Set by the build of Additional_Implementations/avx512 */
+//#define KYBER_SIMD	/* Set by the build of Additional_Implementations/simd */
+//#define KYBER_FUSED	/* Uncomment this to compare the re-encryption in place in decapsulation, see kem.c */
+
+#if defined(KYBER_90S) && (defined(KYBER_LOWMEM) || defined(KYBER_COMPACT) || defined(KYBER_AVX512) || defined(KYBER_SIMD) || defined(KYBER_FUSED))
+#error "KYBER_LOWMEM, KYBER_COMPACT, KYBER_AVX512, KYBER_SIMD and KYBER_FUSED are only implemented for the SHAKE variant"
+#endif
 
 /* Don't change parameters below this line */
 #if   (KYBER_K == 2)
 #ifdef KYBER_90S
 #define KYBER_NAMESPACE(s) pqcrystals_kyber512_90s_ref##s
+#elif defined(KYBER_LOWMEM)
+#define KYBER_NAMESPACE(s) pqcrystals_kyber512_lowmem_ref##s
+#elif defined(KYBER_COMPACT)
+#define KYBER_NAMESPACE(s) pqcrystals_kyber512_compact_ref##s
+#elif defined(KYBER_AVX512)
+#define KYBER_NAMESPACE(s) pqcrystals_kyber512_avx512##s
+#elif defined(KYBER_SIMD)
+#define KYBER_NAMESPACE(s) pqcrystals_kyber512_simd##s
+#elif defined(KYBER_FUSED)
+#define KYBER_NAMESPACE(s) pqcrystals_kyber512_fused_ref##s
 #else
 #define KYBER_NAMESPACE(s) pqcrystals_kyber512_ref##s
 #endif
 #elif (KYBER_K == 3)
 #ifdef KYBER_90S
 #define KYBER_NAMESPACE(s) pqcrystals_kyber768_90s_ref##s
+#elif defined(KYBER_LOWMEM)
+#define KYBER_NAMESPACE(s) pqcrystals_kyber768_lowmem_ref##s
+#elif defined(KYBER_COMPACT)
+#define KYBER_NAMESPACE(s) pqcrystals_kyber768_compact_ref##s
+#elif defined(KYBER_AVX512)
+#define KYBER_NAMESPACE(s) pqcrystals_kyber768_avx512##s
+#elif defined(KYBER_SIMD)
+#define KYBER_NAMESPACE(s) pqcrystals_kyber768_simd##s
+#elif defined(KYBER_FUSED)
+#define KYBER_NAMESPACE(s) pqcrystals_kyber768_fused_ref##s
 #else
 #define KYBER_NAMESPACE(s) pqcrystals_kyber768_ref##s
 #endif
 #elif (KYBER_K == 4)
 #ifdef KYBER_90S
 #define KYBER_NAMESPACE(s) pqcrystals_kyber1024_90s_ref##s
+#elif defined(KYBER_LOWMEM)
+#define KYBER_NAMESPACE(s) pqcrystals_kyber1024_lowmem_ref##s
+#elif defined(KYBER_COMPACT)
+#define KYBER_NAMESPACE(s) pqcrystals_kyber1024_compact_ref##s
+#elif defined(KYBER_AVX512)
+#define KYBER_NAMESPACE(s) pqcrystals_kyber1024_avx512##s
+#elif defined(KYBER_SIMD)
+#define KYBER_NAMESPACE(s) pqcrystals_kyber1024_simd##s
+#elif defined(KYBER_FUSED)
+#define KYBER_NAMESPACE(s) pqcrystals_kyber1024_fused_ref##s
 #else
 #define KYBER_NAMESPACE(s) pqcrystals_kyber1024_ref##s
 #endif
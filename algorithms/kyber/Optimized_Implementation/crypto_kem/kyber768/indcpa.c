@@ -176,59 +176,97 @@ static unsigned int rej_uniform(int16_t *r,
 // Not static for benchmarking
 void gen_matrix(polyvec *a, const uint8_t seed[KYBER_SYMBYTES], int transposed)
 {
-  unsigned int ctr, i, j, k;
+  unsigned int i;
+
+  for(i=0;i<KYBER_K;i++)
+    gen_matrix_row(&a[i], seed, i, transposed);
+}
+
+/*************************************************
+* Name:        gen_matrix_row
+*
+* Description: Deterministically generate row i of matrix A (or of the
+*              transpose of A) from a seed, as gen_matrix does for every row.
+*              With KYBER_LOWMEM, indcpa_keypair_derand and indcpa_enc
+*              call this right before multiplying each row, so only one row
+*              of the matrix is ever on the stack
+*
+* Arguments:   - polyvec *a:          pointer to output row
+*              - const uint8_t *seed: pointer to input seed
+*              - unsigned int i:      index of the row
+*              - int transposed:      boolean deciding whether A or A^T
+*                                     is generated
+**************************************************/
+void gen_matrix_row(polyvec *a, const uint8_t seed[KYBER_SYMBYTES], unsigned int i, int transposed)
+{
+  unsigned int ctr, j, k;
   unsigned int buflen, off;
   uint8_t buf[GEN_MATRIX_NBLOCKS*XOF_BLOCKBYTES+2];
   xof_state state;
 
-  for(i=0;i<KYBER_K;i++) {
-    for(j=0;j<KYBER_K;j++) {
-      if(transposed)
-        xof_absorb(&state, seed, i, j);
-      else
-        xof_absorb(&state, seed, j, i);
-
-      xof_squeezeblocks(buf, GEN_MATRIX_NBLOCKS, &state);
-      buflen = GEN_MATRIX_NBLOCKS*XOF_BLOCKBYTES;
-      ctr = rej_uniform(a[i].vec[j].coeffs, KYBER_N, buf, buflen);
-
-      while(ctr < KYBER_N) {
-        off = buflen % 3;
-        for(k = 0; k < off; k++)
-          buf[k] = buf[buflen - off + k];
-        xof_squeezeblocks(buf + off, 1, &state);
-        buflen = off + XOF_BLOCKBYTES;
-        ctr += rej_uniform(a[i].vec[j].coeffs + ctr, KYBER_N - ctr, buf, buflen);
-      }
+  for(j=0;j<KYBER_K;j++) {
+    if(transposed)
+      xof_absorb(&state, seed, i, j);
+    else
+      xof_absorb(&state, seed, j, i);
+
+    xof_squeezeblocks(buf, GEN_MATRIX_NBLOCKS, &state);
+    buflen = GEN_MATRIX_NBLOCKS*XOF_BLOCKBYTES;
+    ctr = rej_uniform(a->vec[j].coeffs, KYBER_N, buf, buflen);
+
+    while(ctr < KYBER_N) {
+      off = buflen % 3;
+      for(k = 0; k < off; k++)
+        buf[k] = buf[buflen - off + k];
+      xof_squeezeblocks(buf + off, 1, &state);
+      buflen = off + XOF_BLOCKBYTES;
+      ctr += rej_uniform(a->vec[j].coeffs + ctr, KYBER_N - ctr, buf, buflen);
     }
   }
 }
 
 /*************************************************
-* Name:        indcpa_keypair
+* Name:        indcpa_keypair_derand
 *
 * Description: Generates public and private key for the CPA-secure
-*              public-key encryption scheme underlying Kyber
+*              public-key encryption scheme underlying Kyber,
+*              deterministically from coins
 *
 * Arguments:   - uint8_t *pk: pointer to output public key
 *                             (of length KYBER_INDCPA_PUBLICKEYBYTES bytes)
 *              - uint8_t *sk: pointer to output private key
                               (of length KYBER_INDCPA_SECRETKEYBYTES bytes)
+*              - const uint8_t *coins: pointer to input randomness
+*                             (of length KYBER_SYMBYTES bytes)
 **************************************************/
-void indcpa_keypair(uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
-                    uint8_t sk[KYBER_INDCPA_SECRETKEYBYTES])
+void indcpa_keypair_derand(uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
+                           uint8_t sk[KYBER_INDCPA_SECRETKEYBYTES],
+                           const uint8_t coins[KYBER_SYMBYTES])
 {
   unsigned int i;
   uint8_t buf[2*KYBER_SYMBYTES];
   const uint8_t *publicseed = buf;
   const uint8_t *noiseseed = buf+KYBER_SYMBYTES;
   uint8_t nonce = 0;
+#ifdef KYBER_LOWMEM
+  polyvec a, e, pkpv, skpv;
+#else
   polyvec a[KYBER_K], e, pkpv, skpv;
+#endif
 
-  randombytes(buf, KYBER_SYMBYTES);
-  hash_g(buf, buf, KYBER_SYMBYTES);
-
+#ifdef KYBER_MLKEM
+  /* FIPS 203 domain-separates the seeds by the module rank k */
+  for(i=0;i<KYBER_SYMBYTES;i++)
+    buf[i] = coins[i];
+  buf[KYBER_SYMBYTES] = KYBER_K;
+  hash_g(buf, buf, KYBER_SYMBYTES+1);
+#else
+  hash_g(buf, coins, KYBER_SYMBYTES);
+#endif
+
+#ifndef KYBER_LOWMEM
   gen_a(a, publicseed);
+#endif
 
   for(i=0;i<KYBER_K;i++)
     poly_getnoise_eta1(&skpv.vec[i], noiseseed, nonce++);
@@ -240,7 +278,12 @@ void indcpa_keypair(uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
 
   // matrix-vector multiplication
   for(i=0;i<KYBER_K;i++) {
+#ifdef KYBER_LOWMEM
+    gen_matrix_row(&a, publicseed, i, 0);
+    polyvec_pointwise_acc_montgomery(&pkpv.vec[i], &a, &skpv);
+#else
     polyvec_pointwise_acc_montgomery(&pkpv.vec[i], &a[i], &skpv);
+#endif
     poly_tomont(&pkpv.vec[i]);
   }
 
@@ -252,13 +295,13 @@ void indcpa_keypair(uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
 }
 
 /*************************************************
-* Name:        indcpa_enc
+* Name:        encrypt_polys
 *
-* Description: Encryption function of the CPA-secure
-*              public-key encryption scheme underlying Kyber.
+* Description: Encryption shared by indcpa_enc and indcpa_enc_cmp, up to
+*              (not including) compression of the ciphertext
 *
-* Arguments:   - uint8_t *c:           pointer to output ciphertext
-*                                      (of length KYBER_INDCPA_BYTES bytes)
+* Arguments:   - polyvec *bp:          pointer to output vector u
+*              - poly *v:              pointer to output polynomial v
 *              - const uint8_t *m:     pointer to input message
 *                                      (of length KYBER_INDCPA_MSGBYTES bytes)
 *              - const uint8_t *pk:    pointer to input public key
@@ -268,20 +311,27 @@ void indcpa_keypair(uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
 *                                      to deterministically generate all
 *                                      randomness
 **************************************************/
-void indcpa_enc(uint8_t c[KYBER_INDCPA_BYTES],
-                const uint8_t m[KYBER_INDCPA_MSGBYTES],
-                const uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
-                const uint8_t coins[KYBER_SYMBYTES])
+static void encrypt_polys(polyvec *bp,
+                          poly *v,
+                          const uint8_t m[KYBER_INDCPA_MSGBYTES],
+                          const uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
+                          const uint8_t coins[KYBER_SYMBYTES])
 {
   unsigned int i;
   uint8_t seed[KYBER_SYMBYTES];
   uint8_t nonce = 0;
-  polyvec sp, pkpv, ep, at[KYBER_K], bp;
-  poly v, k, epp;
+#ifdef KYBER_LOWMEM
+  polyvec sp, pkpv, ep, at;
+#else
+  polyvec sp, pkpv, ep, at[KYBER_K];
+#endif
+  poly k, epp;
 
   unpack_pk(&pkpv, seed, pk);
   poly_frommsg(&k, m);
+#ifndef KYBER_LOWMEM
   gen_at(at, seed);
+#endif
 
   for(i=0;i<KYBER_K;i++)
     poly_getnoise_eta1(sp.vec+i, coins, nonce++);
@@ -292,23 +342,104 @@ void indcpa_enc(uint8_t c[KYBER_INDCPA_BYTES],
   polyvec_ntt(&sp);
 
   // matrix-vector multiplication
-  for(i=0;i<KYBER_K;i++)
-    polyvec_pointwise_acc_montgomery(&bp.vec[i], &at[i], &sp);
+  for(i=0;i<KYBER_K;i++) {
+#ifdef KYBER_LOWMEM
+    gen_matrix_row(&at, seed, i, 1);
+    polyvec_pointwise_acc_montgomery(&bp->vec[i], &at, &sp);
+#else
+    polyvec_pointwise_acc_montgomery(&bp->vec[i], &at[i], &sp);
+#endif
+  }
+
+  polyvec_pointwise_acc_montgomery(v, &pkpv, &sp);
 
-  polyvec_pointwise_acc_montgomery(&v, &pkpv, &sp);
+  polyvec_invntt_tomont(bp);
+  poly_invntt_tomont(v);
 
-  polyvec_invntt_tomont(&bp);
-  poly_invntt_tomont(&v);
+  polyvec_add(bp, bp, &ep);
+  poly_add(v, v, &epp);
+  poly_add(v, v, &k);
+  polyvec_reduce(bp);
+  poly_reduce(v);
+}
 
-  polyvec_add(&bp, &bp, &ep);
-  poly_add(&v, &v, &epp);
-  poly_add(&v, &v, &k);
-  polyvec_reduce(&bp);
-  poly_reduce(&v);
+/*************************************************
+* Name:        indcpa_enc
+*
+* Description: Encryption function of the CPA-secure
+*              public-key encryption scheme underlying Kyber.
+*
+* Arguments:   - uint8_t *c:           pointer to output ciphertext
+*                                      (of length KYBER_INDCPA_BYTES bytes)
+*              - const uint8_t *m:     pointer to input message
+*                                      (of length KYBER_INDCPA_MSGBYTES bytes)
+*              - const uint8_t *pk:    pointer to input public key
+*                                      (of length KYBER_INDCPA_PUBLICKEYBYTES)
+*              - const uint8_t *coins: pointer to input random coins
+*                                      used as seed (of length KYBER_SYMBYTES)
+*                                      to deterministically generate all
+*                                      randomness
+**************************************************/
+void indcpa_enc(uint8_t c[KYBER_INDCPA_BYTES],
+                const uint8_t m[KYBER_INDCPA_MSGBYTES],
+                const uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
+                const uint8_t coins[KYBER_SYMBYTES])
+{
+  polyvec bp;
+  poly v;
 
+  encrypt_polys(&bp, &v, m, pk, coins);
   pack_ciphertext(c, &bp, &v);
 }
 
+/*************************************************
+* Name:        indcpa_enc_cmp
+*
+* Description: Re-encryption for decapsulation: encrypts m like indcpa_enc
+*              and compares each compressed polynomial with its part of c
+*              in constant time, without storing the re-encrypted
+*              ciphertext. Each part of c is absorbed into h right after
+*              it is compared, so c is read once for both.
+*
+* Arguments:   - const uint8_t *c:     pointer to ciphertext to compare with
+*                                      (of length KYBER_INDCPA_BYTES bytes)
+*              - const uint8_t *m:     pointer to input message
+*                                      (of length KYBER_INDCPA_MSGBYTES bytes)
+*              - const uint8_t *pk:    pointer to input public key
+*                                      (of length KYBER_INDCPA_PUBLICKEYBYTES)
+*              - const uint8_t *coins: pointer to input random coins
+*                                      (of length KYBER_SYMBYTES)
+*              - sha3_256incctx *h:    pointer to hash state c is absorbed
+*                                      into, or NULL
+*
+* Returns 0 if the re-encryption equals c, 1 otherwise (as verify)
+**************************************************/
+int indcpa_enc_cmp(const uint8_t c[KYBER_INDCPA_BYTES],
+                   const uint8_t m[KYBER_INDCPA_MSGBYTES],
+                   const uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
+                   const uint8_t coins[KYBER_SYMBYTES],
+                   sha3_256incctx *h)
+{
+  unsigned int i;
+  uint64_t rc = 0;
+  const size_t rowbytes = KYBER_POLYVECCOMPRESSEDBYTES/KYBER_K;
+  polyvec bp;
+  poly v;
+
+  encrypt_polys(&bp, &v, m, pk, coins);
+
+  for(i=0;i<KYBER_K;i++) {
+    rc |= polyvec_compress_poly_cmp(c+i*rowbytes, &bp.vec[i]);
+    if(h != NULL)
+      sha3_256_inc_absorb(h, c+i*rowbytes, rowbytes);
+  }
+  rc |= poly_compress_cmp(c+KYBER_POLYVECCOMPRESSEDBYTES, &v);
+  if(h != NULL)
+    sha3_256_inc_absorb(h, c+KYBER_POLYVECCOMPRESSEDBYTES, KYBER_POLYCOMPRESSEDBYTES);
+
+  return (-rc) >> 63;
+}
+
 /*************************************************
 * Name:        indcpa_dec
 *
@@ -6,32 +6,63 @@
 #include "symmetric.h"
 #include "verify.h"
 #include "indcpa.h"
+#include "polyvec.h"
 
 /*************************************************
-* Name:        crypto_kem_keypair
+* Name:        crypto_kem_keypair_derand
 *
 * Description: Generates public and private key
 *              for CCA-secure Kyber key encapsulation mechanism
+*              deterministically from coins d || z. Nothing else goes into
+*              the keys, so the coins are a compact form of the secret key
+*              that this function expands again
 *
 * Arguments:   - unsigned char *pk: pointer to output public key
 *                (an already allocated array of CRYPTO_PUBLICKEYBYTES bytes)
 *              - unsigned char *sk: pointer to output private key
 *                (an already allocated array of CRYPTO_SECRETKEYBYTES bytes)
+*              - const unsigned char *coins: pointer to input randomness
+*                (an already allocated array of CRYPTO_KEYPAIRCOINBYTES bytes)
 *
 * Returns 0 (success)
 **************************************************/
-int crypto_kem_keypair(unsigned char *pk, unsigned char *sk)
+int crypto_kem_keypair_derand(unsigned char *pk,
+                              unsigned char *sk,
+                              const unsigned char *coins)
 {
   size_t i;
-  indcpa_keypair(pk, sk);
+  indcpa_keypair_derand(pk, sk, coins);
   for(i=0;i<KYBER_INDCPA_PUBLICKEYBYTES;i++)
     sk[i+KYBER_INDCPA_SECRETKEYBYTES] = pk[i];
   hash_h(sk+KYBER_SECRETKEYBYTES-2*KYBER_SYMBYTES, pk, KYBER_PUBLICKEYBYTES);
   /* Value z for pseudo-random output on reject */
-  randombytes(sk+KYBER_SECRETKEYBYTES-KYBER_SYMBYTES, KYBER_SYMBYTES);
+  for(i=0;i<KYBER_SYMBYTES;i++)
+    sk[i+KYBER_SECRETKEYBYTES-KYBER_SYMBYTES] = coins[i+KYBER_SYMBYTES];
   return 0;
 }
 
+/*************************************************
+* Name:        crypto_kem_keypair
+*
+* Description: Generates public and private key
+*              for CCA-secure Kyber key encapsulation mechanism
+*
+* Arguments:   - unsigned char *pk: pointer to output public key
+*                (an already allocated array of CRYPTO_PUBLICKEYBYTES bytes)
+*              - unsigned char *sk: pointer to output private key
+*                (an already allocated array of CRYPTO_SECRETKEYBYTES bytes)
+*
+* Returns 0 (success)
+**************************************************/
+int crypto_kem_keypair(unsigned char *pk, unsigned char *sk)
+{
+  uint8_t coins[2*KYBER_SYMBYTES];
+  /* d, then z, drawn separately as before so the KATs are unchanged */
+  randombytes(coins, KYBER_SYMBYTES);
+  randombytes(coins+KYBER_SYMBYTES, KYBER_SYMBYTES);
+  return crypto_kem_keypair_derand(pk, sk, coins);
+}
+
 /*************************************************
 * Name:        crypto_kem_enc
 *
@@ -45,19 +76,30 @@ int crypto_kem_keypair(unsigned char *pk, unsigned char *sk)
 *              - const unsigned char *pk: pointer to input public key
 *                (an already allocated array of CRYPTO_PUBLICKEYBYTES bytes)
 *
-* Returns 0 (success)
+* Returns 0 on success, -1 if ML-KEM's modulus check rejects the public key
 **************************************************/
 int crypto_kem_enc(unsigned char *ct,
                    unsigned char *ss,
                    const unsigned char *pk)
 {
+#ifdef KYBER_MLKEM
+  size_t i;
+#endif
   uint8_t buf[2*KYBER_SYMBYTES];
   /* Will contain key, coins */
   uint8_t kr[2*KYBER_SYMBYTES];
 
+#ifdef KYBER_MLKEM
+  /* FIPS 203 input check, the encoded t must have every coefficient below q */
+  if(polyvec_check_modulus(pk))
+    return -1;
+#endif
+
   randombytes(buf, KYBER_SYMBYTES);
+#ifndef KYBER_MLKEM
   /* Don't release system RNG output */
   hash_h(buf, buf, KYBER_SYMBYTES);
+#endif
 
   /* Multitarget countermeasure for coins + contributory KEM */
   hash_h(buf+KYBER_SYMBYTES, pk, KYBER_PUBLICKEYBYTES);
@@ -66,10 +108,16 @@ int crypto_kem_enc(unsigned char *ct,
   /* coins are in kr+KYBER_SYMBYTES */
   indcpa_enc(ct, buf, pk, kr+KYBER_SYMBYTES);
 
+#ifdef KYBER_MLKEM
+  /* FIPS 203 takes the key from G as is, without hashing in H(c) */
+  for(i=0;i<KYBER_SSBYTES;i++)
+    ss[i] = kr[i];
+#else
   /* overwrite coins in kr with H(c) */
   hash_h(kr+KYBER_SYMBYTES, ct, KYBER_CIPHERTEXTBYTES);
   /* hash concatenation of pre-k and H(c) to k */
   kdf(ss, kr, 2*KYBER_SYMBYTES);
+#endif
   return 0;
 }
 
@@ -89,6 +137,10 @@ int crypto_kem_enc(unsigned char *ct,
 * Returns 0.
 *
 * On failure, ss will contain a pseudo-random value.
+*
+* With KYBER_FUSED, the re-encryption is compared with ct polynomial by
+* polynomial (indcpa_enc_cmp) instead of being written out and compared
+* with verify, and ct is absorbed into H(c) in the same pass.
 **************************************************/
 int crypto_kem_dec(unsigned char *ss,
                    const unsigned char *ct,
@@ -99,8 +151,12 @@ int crypto_kem_dec(unsigned char *ss,
   uint8_t buf[2*KYBER_SYMBYTES];
   /* Will contain key, coins */
   uint8_t kr[2*KYBER_SYMBYTES];
-  uint8_t cmp[KYBER_CIPHERTEXTBYTES];
   const uint8_t *pk = sk+KYBER_INDCPA_SECRETKEYBYTES;
+#ifndef KYBER_FUSED
+  uint8_t cmp[KYBER_CIPHERTEXTBYTES];
+#elif !defined(KYBER_MLKEM)
+  sha3_256incctx h;
+#endif
 
   indcpa_dec(buf, ct, sk);
 
@@ -109,18 +165,38 @@ int crypto_kem_dec(unsigned char *ss,
     buf[KYBER_SYMBYTES+i] = sk[KYBER_SECRETKEYBYTES-2*KYBER_SYMBYTES+i];
   hash_g(kr, buf, 2*KYBER_SYMBYTES);
 
+#ifndef KYBER_FUSED
   /* coins are in kr+KYBER_SYMBYTES */
   indcpa_enc(cmp, buf, pk, kr+KYBER_SYMBYTES);
 
   fail = verify(ct, cmp, KYBER_CIPHERTEXTBYTES);
+#elif defined(KYBER_MLKEM)
+  /* coins are in kr+KYBER_SYMBYTES, compared with ct as re-encrypted */
+  fail = indcpa_enc_cmp(ct, buf, pk, kr+KYBER_SYMBYTES, NULL);
+#else
+  /* coins are in kr+KYBER_SYMBYTES, compared with ct as re-encrypted while
+     ct is absorbed into H(c) in the same pass */
+  sha3_256_inc_init(&h);
+  fail = indcpa_enc_cmp(ct, buf, pk, kr+KYBER_SYMBYTES, &h);
+#endif
 
+#ifdef KYBER_MLKEM
+  /* Rejection key J(z || c), replaced by the key from G unless re-encryption failed */
+  rkprf(ss, sk+KYBER_SECRETKEYBYTES-KYBER_SYMBYTES, ct);
+  cmov(ss, kr, KYBER_SYMBYTES, !fail);
+#else
   /* overwrite coins in kr with H(c) */
+#ifdef KYBER_FUSED
+  sha3_256_inc_finalize(kr+KYBER_SYMBYTES, &h);
+#else
   hash_h(kr+KYBER_SYMBYTES, ct, KYBER_CIPHERTEXTBYTES);
+#endif
 
   /* Overwrite pre-k with z on re-encryption failure */
   cmov(kr, sk+KYBER_SECRETKEYBYTES-KYBER_SYMBYTES, KYBER_SYMBYTES, fail);
 
   /* hash concatenation of pre-k and H(c) to k */
   kdf(ss, kr, 2*KYBER_SYMBYTES);
+#endif
   return 0;
 }
@@ -62,57 +62,134 @@ void polyvec_compress(uint8_t r[KYBER_POLYVECCOMPRESSEDBYTES], polyvec *a)
 }
 
 /*************************************************
-* Name:        polyvec_decompress
+* Name:        polyvec_compress_poly_cmp
 *
-* Description: De-serialize and decompress vector of polynomials;
-*              approximate inverse of polyvec_compress
+* Description: Compresses one polynomial of a vector like polyvec_compress,
+*              but compares each byte with r instead of writing it, in
+*              constant time
 *
-* Arguments:   - polyvec *r:       pointer to output vector of polynomials
+* Arguments:   - const uint8_t *r: pointer to byte array to compare with
+*                                  (of length KYBER_POLYVECCOMPRESSEDBYTES/KYBER_K)
+*              - poly *a:          pointer to input polynomial
+*
+* Returns 0 if the bytes are equal, non-zero otherwise
+**************************************************/
+uint8_t polyvec_compress_poly_cmp(const uint8_t r[KYBER_POLYVECCOMPRESSEDBYTES/KYBER_K],
+                                  poly *a)
+{
+  unsigned int j,k;
+  uint8_t rc = 0;
+
+  poly_csubq(a);
+
+#if (KYBER_POLYVECCOMPRESSEDBYTES == (KYBER_K * 352))
+  uint16_t t[8];
+  for(j=0;j<KYBER_N/8;j++) {
+    for(k=0;k<8;k++)
+      t[k] = ((((uint32_t)a->coeffs[8*j+k] << 11) + KYBER_Q/2)
+              /KYBER_Q) & 0x7ff;
+
+    rc |= r[ 0] ^ (uint8_t)((t[0] >>  0));
+    rc |= r[ 1] ^ (uint8_t)((t[0] >>  8) | (t[1] << 3));
+    rc |= r[ 2] ^ (uint8_t)((t[1] >>  5) | (t[2] << 6));
+    rc |= r[ 3] ^ (uint8_t)((t[2] >>  2));
+    rc |= r[ 4] ^ (uint8_t)((t[2] >> 10) | (t[3] << 1));
+    rc |= r[ 5] ^ (uint8_t)((t[3] >>  7) | (t[4] << 4));
+    rc |= r[ 6] ^ (uint8_t)((t[4] >>  4) | (t[5] << 7));
+    rc |= r[ 7] ^ (uint8_t)((t[5] >>  1));
+    rc |= r[ 8] ^ (uint8_t)((t[5] >>  9) | (t[6] << 2));
+    rc |= r[ 9] ^ (uint8_t)((t[6] >>  6) | (t[7] << 5));
+    rc |= r[10] ^ (uint8_t)((t[7] >>  3));
+    r += 11;
+  }
+#elif (KYBER_POLYVECCOMPRESSEDBYTES == (KYBER_K * 320))
+  uint16_t t[4];
+  for(j=0;j<KYBER_N/4;j++) {
+    for(k=0;k<4;k++)
+      t[k] = ((((uint32_t)a->coeffs[4*j+k] << 10) + KYBER_Q/2)
+              / KYBER_Q) & 0x3ff;
+
+    rc |= r[0] ^ (uint8_t)((t[0] >> 0));
+    rc |= r[1] ^ (uint8_t)((t[0] >> 8) | (t[1] << 2));
+    rc |= r[2] ^ (uint8_t)((t[1] >> 6) | (t[2] << 4));
+    rc |= r[3] ^ (uint8_t)((t[2] >> 4) | (t[3] << 6));
+    rc |= r[4] ^ (uint8_t)((t[3] >> 2));
+    r += 5;
+  }
+#else
+#error "KYBER_POLYVECCOMPRESSEDBYTES needs to be in {320*KYBER_K, 352*KYBER_K}"
+#endif
+  return rc;
+}
+
+/*************************************************
+* Name:        polyvec_decompress_poly
+*
+* Description: De-serialize and decompress one polynomial of a compressed
+*              vector of polynomials, so a vector can be decompressed
+*              one polynomial at a time as its bytes arrive
+*
+* Arguments:   - poly *r:          pointer to output polynomial
 *              - const uint8_t *a: pointer to input byte array
-*                                  (of length KYBER_POLYVECCOMPRESSEDBYTES)
+*                                  (of length KYBER_POLYVECCOMPRESSEDBYTES/KYBER_K)
 **************************************************/
-void polyvec_decompress(polyvec *r,
-                        const uint8_t a[KYBER_POLYVECCOMPRESSEDBYTES])
+void polyvec_decompress_poly(poly *r,
+                             const uint8_t a[KYBER_POLYVECCOMPRESSEDBYTES/KYBER_K])
 {
-  unsigned int i,j,k;
+  unsigned int j,k;
 
 #if (KYBER_POLYVECCOMPRESSEDBYTES == (KYBER_K * 352))
   uint16_t t[8];
-  for(i=0;i<KYBER_K;i++) {
-    for(j=0;j<KYBER_N/8;j++) {
-      t[0] = (a[0] >> 0) | ((uint16_t)a[ 1] << 8);
-      t[1] = (a[1] >> 3) | ((uint16_t)a[ 2] << 5);
-      t[2] = (a[2] >> 6) | ((uint16_t)a[ 3] << 2) | ((uint16_t)a[4] << 10);
-      t[3] = (a[4] >> 1) | ((uint16_t)a[ 5] << 7);
-      t[4] = (a[5] >> 4) | ((uint16_t)a[ 6] << 4);
-      t[5] = (a[6] >> 7) | ((uint16_t)a[ 7] << 1) | ((uint16_t)a[8] << 9);
-      t[6] = (a[8] >> 2) | ((uint16_t)a[ 9] << 6);
-      t[7] = (a[9] >> 5) | ((uint16_t)a[10] << 3);
-      a += 11;
+  for(j=0;j<KYBER_N/8;j++) {
+    t[0] = (a[0] >> 0) | ((uint16_t)a[ 1] << 8);
+    t[1] = (a[1] >> 3) | ((uint16_t)a[ 2] << 5);
+    t[2] = (a[2] >> 6) | ((uint16_t)a[ 3] << 2) | ((uint16_t)a[4] << 10);
+    t[3] = (a[4] >> 1) | ((uint16_t)a[ 5] << 7);
+    t[4] = (a[5] >> 4) | ((uint16_t)a[ 6] << 4);
+    t[5] = (a[6] >> 7) | ((uint16_t)a[ 7] << 1) | ((uint16_t)a[8] << 9);
+    t[6] = (a[8] >> 2) | ((uint16_t)a[ 9] << 6);
+    t[7] = (a[9] >> 5) | ((uint16_t)a[10] << 3);
+    a += 11;
 
-      for(k=0;k<8;k++)
-        r->vec[i].coeffs[8*j+k] = ((uint32_t)(t[k] & 0x7FF)*KYBER_Q + 1024) >> 11;
-    }
+    for(k=0;k<8;k++)
+      r->coeffs[8*j+k] = ((uint32_t)(t[k] & 0x7FF)*KYBER_Q + 1024) >> 11;
   }
 #elif (KYBER_POLYVECCOMPRESSEDBYTES == (KYBER_K * 320))
   uint16_t t[4];
-  for(i=0;i<KYBER_K;i++) {
-    for(j=0;j<KYBER_N/4;j++) {
-      t[0] = (a[0] >> 0) | ((uint16_t)a[1] << 8);
-      t[1] = (a[1] >> 2) | ((uint16_t)a[2] << 6);
-      t[2] = (a[2] >> 4) | ((uint16_t)a[3] << 4);
-      t[3] = (a[3] >> 6) | ((uint16_t)a[4] << 2);
-      a += 5;
+  for(j=0;j<KYBER_N/4;j++) {
+    t[0] = (a[0] >> 0) | ((uint16_t)a[1] << 8);
+    t[1] = (a[1] >> 2) | ((uint16_t)a[2] << 6);
+    t[2] = (a[2] >> 4) | ((uint16_t)a[3] << 4);
+    t[3] = (a[3] >> 6) | ((uint16_t)a[4] << 2);
+    a += 5;
 
-      for(k=0;k<4;k++)
-        r->vec[i].coeffs[4*j+k] = ((uint32_t)(t[k] & 0x3FF)*KYBER_Q + 512) >> 10;
-    }
+    for(k=0;k<4;k++)
+      r->coeffs[4*j+k] = ((uint32_t)(t[k] & 0x3FF)*KYBER_Q + 512) >> 10;
   }
 #else
 #error "KYBER_POLYVECCOMPRESSEDBYTES needs to be in {320*KYBER_K, 352*KYBER_K}"
 #endif
 }
 
+/*************************************************
+* Name:        polyvec_decompress
+*
+* Description: De-serialize and decompress vector of polynomials;
+*              approximate inverse of polyvec_compress
+*
+* Arguments:   - polyvec *r:       pointer to output vector of polynomials
+*              - const uint8_t *a: pointer to input byte array
+*                                  (of length KYBER_POLYVECCOMPRESSEDBYTES)
+**************************************************/
+void polyvec_decompress(polyvec *r,
+                        const uint8_t a[KYBER_POLYVECCOMPRESSEDBYTES])
+{
+  unsigned int i;
+
+  for(i=0;i<KYBER_K;i++)
+    polyvec_decompress_poly(&r->vec[i], a+i*(KYBER_POLYVECCOMPRESSEDBYTES/KYBER_K));
+}
+
 /*************************************************
 * Name:        polyvec_tobytes
 *
@@ -146,6 +223,32 @@ void polyvec_frombytes(polyvec *r, const uint8_t a[KYBER_POLYVECBYTES])
     poly_frombytes(&r->vec[i], a+i*KYBER_POLYBYTES);
 }
 
+/*************************************************
+* Name:        polyvec_check_modulus
+*
+* Description: Modulus check of FIPS 203 on a serialized vector of
+*              polynomials: ByteEncode12(ByteDecode12(a)) == a holds
+*              exactly when every 12-bit coefficient is below q
+*
+* Arguments:   - const uint8_t *a: pointer to input byte array
+*                                  (of length KYBER_POLYVECBYTES)
+*
+* Returns 0 if every coefficient is below q, -1 otherwise
+**************************************************/
+int polyvec_check_modulus(const uint8_t a[KYBER_POLYVECBYTES])
+{
+  unsigned int i;
+  uint16_t t0, t1;
+
+  for(i=0;i<KYBER_POLYVECBYTES/3;i++) {
+    t0 = (a[3*i+0] >> 0) | ((uint16_t)(a[3*i+1] & 0xF) << 8);
+    t1 = (a[3*i+1] >> 4) | ((uint16_t)a[3*i+2] << 4);
+    if(t0 >= KYBER_Q || t1 >= KYBER_Q)
+      return -1;
+  }
+  return 0;
+}
+
 /*************************************************
 * Name:        polyvec_ntt
 *
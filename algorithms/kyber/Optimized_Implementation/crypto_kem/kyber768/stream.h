@@ -0,0 +1,58 @@
+#ifndef STREAM_H
+#define STREAM_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "params.h"
+#include "poly.h"
+#include "fips202.h"
+
+/*
+ * Streaming encapsulation and decapsulation: the public key or ciphertext is
+ * passed in chunks as it arrives, and the work that doesn't depend on later
+ * bytes is done right away. The results are the same as those of
+ * crypto_kem_enc and crypto_kem_dec on the whole input.
+ */
+
+typedef struct {
+  size_t len;
+  sha3_256incctx h;
+  uint8_t pk[KYBER_PUBLICKEYBYTES];
+} crypto_kem_enc_state;
+
+typedef struct {
+  size_t len;
+  unsigned int rows;
+  const uint8_t *sk;
+#ifdef KYBER_MLKEM
+  shake256incctx j;
+#else
+  sha3_256incctx h;
+#endif
+  poly mp;
+  uint8_t ct[KYBER_CIPHERTEXTBYTES];
+} crypto_kem_dec_state;
+
+#define crypto_kem_enc_init KYBER_NAMESPACE(_enc_init)
+int crypto_kem_enc_init(crypto_kem_enc_state *state);
+#define crypto_kem_enc_update KYBER_NAMESPACE(_enc_update)
+int crypto_kem_enc_update(crypto_kem_enc_state *state,
+                          const unsigned char *pk,
+                          size_t pklen);
+#define crypto_kem_enc_final KYBER_NAMESPACE(_enc_final)
+int crypto_kem_enc_final(unsigned char *ct,
+                         unsigned char *ss,
+                         crypto_kem_enc_state *state);
+
+#define crypto_kem_dec_init KYBER_NAMESPACE(_dec_init)
+int crypto_kem_dec_init(crypto_kem_dec_state *state,
+                        const unsigned char *sk);
+#define crypto_kem_dec_update KYBER_NAMESPACE(_dec_update)
+int crypto_kem_dec_update(crypto_kem_dec_state *state,
+                          const unsigned char *ct,
+                          size_t ctlen);
+#define crypto_kem_dec_final KYBER_NAMESPACE(_dec_final)
+int crypto_kem_dec_final(unsigned char *ss,
+                         crypto_kem_dec_state *state);
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef XDH_API_H
+#define XDH_API_H
+
+#ifndef XDH_CURVE
+  #define XDH_CURVE 25519
+#endif
+
+#if XDH_CURVE == 25519
+  #define CRYPTO_ALGNAME "X25519"
+  #define XDH_NAMESPACE(s) x25519##s
+  #define CURVE_ID EVP_PKEY_X25519
+  #define CRYPTO_SECRETKEYBYTES 32
+  #define CRYPTO_PUBLICKEYBYTES 32
+  #define CRYPTO_CIPHERTEXTBYTES 32
+  #define CRYPTO_BYTES 32
+#elif XDH_CURVE == 448
+  #define CRYPTO_ALGNAME "X448"
+  #define XDH_NAMESPACE(s) x448##s
+  #define CURVE_ID EVP_PKEY_X448
+  #define CRYPTO_SECRETKEYBYTES 56
+  #define CRYPTO_PUBLICKEYBYTES 56
+  #define CRYPTO_CIPHERTEXTBYTES 56
+  #define CRYPTO_BYTES 56
+#else
+  #error "Unsupported XDH_CURVE (use 25519 or 448)"
+#endif
+
+#define crypto_kem_keypair XDH_NAMESPACE(_keypair)
+int crypto_kem_keypair(unsigned char* pk, unsigned char* sk);
+#define crypto_kem_enc XDH_NAMESPACE(_enc)
+int crypto_kem_enc(unsigned char* ct, unsigned char* ss, const unsigned char* pk);
+#define crypto_kem_dec XDH_NAMESPACE(_dec)
+int crypto_kem_dec(unsigned char* ss, const unsigned char* ct, const unsigned char* sk);
+
+#endif
@@ -0,0 +1,142 @@
+#include "api.h"
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include <string.h>
+#include <stdlib.h>
+
+/*
+ * Per-thread OpenSSL objects, kept the same way as in the ECDH wrapper: the
+ * keygen context and the last private key we decapsulated with, together with
+ * its derive context. Peer public keys are imported on every encapsulation.
+ * They are never freed, which is at most one set per thread.
+ */
+typedef struct {
+    EVP_PKEY_CTX *keygen;
+
+    unsigned char sk[CRYPTO_SECRETKEYBYTES];
+    EVP_PKEY *priv;
+    EVP_PKEY_CTX *derive;
+} xdh_cache_t;
+
+static __thread xdh_cache_t cache;
+
+/* Fetch the keygen context on first use */
+static int cache_init(void)
+{
+    if (cache.keygen != NULL)
+        return 0;
+
+    EVP_PKEY_CTX *keygen = EVP_PKEY_CTX_new_id(CURVE_ID, NULL);
+    if (keygen == NULL || EVP_PKEY_keygen_init(keygen) <= 0) {
+        EVP_PKEY_CTX_free(keygen);
+        return -1;
+    }
+
+    cache.keygen = keygen;
+    return 0;
+}
+
+/* Make pkey the cached private key, with a derive context bound to it */
+static int cache_set_private(EVP_PKEY *pkey, const unsigned char *sk)
+{
+    EVP_PKEY_CTX *derive = EVP_PKEY_CTX_new(pkey, NULL);
+    if (derive == NULL || EVP_PKEY_derive_init(derive) <= 0) {
+        EVP_PKEY_CTX_free(derive);
+        EVP_PKEY_free(pkey);
+        return -1;
+    }
+
+    EVP_PKEY_CTX_free(cache.derive);
+    EVP_PKEY_free(cache.priv);
+    cache.derive = derive;
+    cache.priv = pkey;
+    memcpy(cache.sk, sk, CRYPTO_SECRETKEYBYTES);
+    return 0;
+}
+
+/* Derive into ss. Every u-coordinate is a valid X25519/X448 public key, so
+ * there is nothing to validate beyond OpenSSL's all-zero secret check. */
+static int derive(EVP_PKEY_CTX *ctx, EVP_PKEY *peer, unsigned char *ss)
+{
+    size_t ss_len = CRYPTO_BYTES;
+
+    if (EVP_PKEY_derive_set_peer_ex(ctx, peer, 0) <= 0
+        || EVP_PKEY_derive(ctx, ss, &ss_len) <= 0)
+        return -1;
+    return 0;
+}
+
+/* Generate keypair */
+int crypto_kem_keypair(unsigned char *pk, unsigned char *sk)
+{
+    EVP_PKEY *keypair = NULL;
+    size_t pk_len = CRYPTO_PUBLICKEYBYTES;
+    size_t sk_len = CRYPTO_SECRETKEYBYTES;
+
+    if (cache_init() != 0 || EVP_PKEY_keygen(cache.keygen, &keypair) <= 0)
+        return -1;
+
+    /* Export public and private key to buffers */
+    if (EVP_PKEY_get_raw_public_key(keypair, pk, &pk_len) <= 0
+        || EVP_PKEY_get_raw_private_key(keypair, sk, &sk_len) <= 0) {
+        EVP_PKEY_free(keypair);
+        return -1;
+    }
+
+    /* The owner of a fresh keypair is the one who decapsulates with it next */
+    return cache_set_private(keypair, sk);
+}
+
+/* Encapsulate */
+int crypto_kem_enc(unsigned char *ct, unsigned char *ss, const unsigned char *pk)
+{
+    EVP_PKEY *eph_keypair = NULL;
+    EVP_PKEY_CTX *ctx = NULL;
+    size_t ct_len = CRYPTO_CIPHERTEXTBYTES;
+    int result = -1;
+
+    if (cache_init() != 0)
+        return -1;
+
+    /* Import peer public key */
+    EVP_PKEY *peer = EVP_PKEY_new_raw_public_key(CURVE_ID, NULL, pk, CRYPTO_PUBLICKEYBYTES);
+    if (peer == NULL)
+        return -1;
+
+    /* Generate ephemeral keypair and compute the shared secret with the peer's public key */
+    if (EVP_PKEY_keygen(cache.keygen, &eph_keypair) > 0
+        && (ctx = EVP_PKEY_CTX_new(eph_keypair, NULL)) != NULL
+        && EVP_PKEY_derive_init(ctx) > 0
+        && derive(ctx, peer, ss) == 0
+        /* Export ephemeral public key to buffer to be sent to peer */
+        && EVP_PKEY_get_raw_public_key(eph_keypair, ct, &ct_len) > 0)
+        result = 0;
+
+    EVP_PKEY_CTX_free(ctx);
+    EVP_PKEY_free(eph_keypair);
+    EVP_PKEY_free(peer);
+    return result;
+}
+
+/* Decapsulate */
+int crypto_kem_dec(unsigned char *ss, const unsigned char *ct, const unsigned char *sk)
+{
+    if (cache_init() != 0)
+        return -1;
+
+    /* Import private key from buffer, unless it is the one we used last time */
+    if (cache.priv == NULL || CRYPTO_memcmp(cache.sk, sk, CRYPTO_SECRETKEYBYTES) != 0) {
+        EVP_PKEY *priv = EVP_PKEY_new_raw_private_key(CURVE_ID, NULL, sk, CRYPTO_SECRETKEYBYTES);
+        if (priv == NULL || cache_set_private(priv, sk) != 0)
+            return -1;
+    }
+
+    /* Import peer public key and compute the shared secret with the cached derive context */
+    EVP_PKEY *peer = EVP_PKEY_new_raw_public_key(CURVE_ID, NULL, ct, CRYPTO_CIPHERTEXTBYTES);
+    if (peer == NULL)
+        return -1;
+
+    int result = derive(cache.derive, peer, ss);
+    EVP_PKEY_free(peer);
+    return result;
+}
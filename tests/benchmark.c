@@ -1,7 +1,12 @@
 #include "benchmark.h"
+#include <stdio.h>
 #include <stdlib.h>
+#include <math.h>
 #include <string.h>
 #include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
 
 /**
  * @brief Benchmarks a KEM fn with warmup and measurement, storing results in data array.
@@ -32,6 +37,78 @@ void benchmark(function_t fn, uint64_t* data, size_t warmup_iters, size_t measur
     }
 }
 
+/**
+ * @brief Same as benchmark(), but passes a context pointer to every call.
+ *
+ * Used when one binary benchmarks several KEMs and the operation needs to
+ * know which one it is running (see interleaved.c).
+ *
+ * @param fn Function pointer to the operation to benchmark.
+ * @param ctx Context passed to fn on every call.
+ * @param data Array to store timing measurements (at least measure_iters long).
+ */
+void benchmark_ctx(function_ctx_t fn, void* ctx, uint64_t* data, size_t warmup_iters, size_t measure_iters) {
+    struct timespec start, end;
+
+    for (size_t i = 0; i < warmup_iters; i++)
+        fn(ctx);
+
+    // Measurement phase
+    for (size_t i = 0; i < measure_iters; i++) {
+
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        fn(ctx);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+
+        data[i] = (end.tv_sec - start.tv_sec) * NS_PER_SEC + (end.tv_nsec - start.tv_nsec);
+    }
+}
+
+/**
+ * @brief Reads the CPU's cycle counter, with fences so it does not drift into the measured code.
+ *
+ * Used where per-call differences of a few cycles matter (see leakage.c); the
+ * benchmarks themselves report CLOCK_MONOTONIC nanoseconds.
+ */
+uint64_t cycles(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_lfence();
+    uint64_t t = __rdtsc();
+    _mm_lfence();
+    return t;
+#elif defined(__aarch64__)
+    uint64_t t;
+    __asm__ volatile("isb; mrs %0, cntvct_el0" : "=r"(t));
+    return t;
+#else
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * NS_PER_SEC + t.tv_nsec;
+#endif
+}
+
+/**
+ * @brief Reads CLOCK_MONOTONIC in nanoseconds, for the tools that time single calls.
+ */
+uint64_t now_ns(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * NS_PER_SEC + t.tv_nsec;
+}
+
+/**
+ * @brief Advances a xorshift64* generator and returns its next output.
+ *
+ * Not for keys: the tools use it for reproducible workloads (key picks,
+ * arrival times, random ciphertexts) from a fixed seed. The state must not be 0.
+ */
+uint64_t next_random(uint64_t* state) {
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * 0x2545F4914F6CDD1Dull;
+}
+
 /**
  * @brief Comparison function for qsort to sort uint64_t in ascending order.
  *
@@ -69,4 +146,41 @@ size_t remove_outliers(uint64_t* data, size_t data_len, uint8_t outlier_percenta
     memmove(data, data + remove, new_len * sizeof(*data));
 
     return new_len;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Calculates and prints comprehensive statistics for timing measurements.
+ *
+ * Computes mean, standard deviation, median, and various percentiles from the
+ * timing data and displays them in a formatted output.
+ *
+ * @param operation Name of the operation being measured (e.g., "KeyGen").
+ * @param data Sorted array of timing measurements in microseconds.
+ * @param n Number of elements in the data array.
+ */
+void print_distribution(const char* label, uint64_t* data, size_t data_len) {
+
+    // Sum and calculate mean
+    double sum = 0;
+    for (size_t i = 0; i < data_len; i++)
+        sum += data[i];
+    double mean = sum / data_len;
+
+    // Calcular variance and stdev
+    double var = 0;
+    for (size_t i = 0; i < data_len; i++)
+        var += pow(data[i] - mean, 2);
+    double stdev = sqrt(var / data_len);
+
+    // Printing operations (couldn't be bothered thx chat)
+    printf("\n%s:\n", label);
+    printf("  Samples:    %7d (after outlier removal)\n", data_len);
+    printf("  Median:     %7d ns (%d ops/sec)\n", data[data_len / 2], NS_PER_SEC / data[data_len / 2]);
+    printf("  Mean:       %7d ns\n", (uint64_t)mean);
+    printf("  Std Dev:    %7d ns\n", (uint64_t)stdev);
+    printf("  10th %%ile:  %7d ns\n", data[(size_t)(data_len * 0.10)]);
+    printf("  25th %%ile:  %7d ns\n", data[(size_t)(data_len * 0.25)]);
+    printf("  75th %%ile:  %7d ns\n", data[(size_t)(data_len * 0.75)]);
+    printf("  90th %%ile:  %7d ns\n", data[(size_t)(data_len * 0.90)]);
+    printf("  95th %%ile:  %7d ns\n", data[(size_t)(data_len * 0.95)]);
+}
@@ -9,10 +9,19 @@
 
 // Benchmark funcs
 typedef void (*function_t)();
+typedef void (*function_ctx_t)(void*);
 void benchmark(function_t operation, uint64_t* data, size_t warmup_iters, size_t measure_iters);
+void benchmark_ctx(function_ctx_t operation, void* ctx, uint64_t* data, size_t warmup_iters, size_t measure_iters);
+
+// Cycle counter (TSC on x86, virtual counter on arm64, ns elsewhere), serialized around the read
+uint64_t cycles(void);
+
+// CLOCK_MONOTONIC in ns, and xorshift64* for reproducible workloads (not for keys)
+uint64_t now_ns(void);
+uint64_t next_random(uint64_t* state);
 
 // Data processing funcs
 size_t remove_outliers(uint64_t* data, size_t data_len, uint8_t outlier_percentage);
-void print_stats(const char* label, uint64_t* data, size_t data_len);
+void print_distribution(const char* label, uint64_t* data, size_t data_len);
 
 #endif
\ No newline at end of file
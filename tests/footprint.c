@@ -0,0 +1,248 @@
+#define _GNU_SOURCE
+#include "footprint.h"
+#include <pthread.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+#ifdef __linux__
+#include <link.h>
+#endif
+#ifdef __GLIBC__
+#include <malloc.h>
+#include <stdatomic.h>
+#endif
+
+#define STACK_BYTES (8 << 20)
+#define STACK_PATTERN 0xA5
+#define PAINT_MARGIN 256
+
+/* ------------------------------------------------------------------------ */
+/* Heap: the malloc family is replaced by wrappers around glibc's own        */
+/* allocator that count while a measurement is running. Other libraries      */
+/* (OpenSSL) bind to these too, since symbols in the executable interpose.   */
+/* ------------------------------------------------------------------------ */
+
+#ifdef __GLIBC__
+extern void* __libc_malloc(size_t size);
+extern void* __libc_calloc(size_t count, size_t size);
+extern void* __libc_realloc(void* ptr, size_t size);
+extern void* __libc_memalign(size_t alignment, size_t size);
+extern void* __libc_valloc(size_t size);
+extern void* __libc_pvalloc(size_t size);
+extern void __libc_free(void* ptr);
+
+static atomic_int heap_counting;
+static atomic_size_t heap_allocations;
+static atomic_size_t heap_bytes;
+static atomic_long heap_live;
+static atomic_long heap_peak;
+
+static void heap_allocated(void* ptr, size_t requested, size_t released) {
+    if (ptr == NULL || !atomic_load_explicit(&heap_counting, memory_order_relaxed))
+        return;
+    atomic_fetch_add_explicit(&heap_allocations, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&heap_bytes, requested, memory_order_relaxed);
+    long live = atomic_fetch_add_explicit(&heap_live, (long)(malloc_usable_size(ptr) - released), memory_order_relaxed)
+        + (long)(malloc_usable_size(ptr) - released);
+    long peak = atomic_load_explicit(&heap_peak, memory_order_relaxed);
+    while (live > peak && !atomic_compare_exchange_weak_explicit(&heap_peak, &peak, live, memory_order_relaxed, memory_order_relaxed))
+        ;
+}
+
+void* malloc(size_t size) {
+    void* ptr = __libc_malloc(size);
+    heap_allocated(ptr, size, 0);
+    return ptr;
+}
+
+void* calloc(size_t count, size_t size) {
+    void* ptr = __libc_calloc(count, size);
+    heap_allocated(ptr, count * size, 0);
+    return ptr;
+}
+
+void* realloc(void* ptr, size_t size) {
+    size_t released = malloc_usable_size(ptr);
+    void* result = __libc_realloc(ptr, size);
+    heap_allocated(result, size, result != NULL ? released : 0);
+    return result;
+}
+
+void* memalign(size_t alignment, size_t size) {
+    void* ptr = __libc_memalign(alignment, size);
+    heap_allocated(ptr, size, 0);
+    return ptr;
+}
+
+void* aligned_alloc(size_t alignment, size_t size) {
+    return memalign(alignment, size);
+}
+
+int posix_memalign(void** ptr, size_t alignment, size_t size) {
+    if (alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0)
+        return 22; // EINVAL
+    *ptr = memalign(alignment, size);
+    return *ptr == NULL && size != 0 ? 12 : 0; // ENOMEM
+}
+
+void* valloc(size_t size) {
+    void* ptr = __libc_valloc(size);
+    heap_allocated(ptr, size, 0);
+    return ptr;
+}
+
+void* pvalloc(size_t size) {
+    void* ptr = __libc_pvalloc(size);
+    heap_allocated(ptr, size, 0);
+    return ptr;
+}
+
+void free(void* ptr) {
+    if (ptr != NULL && atomic_load_explicit(&heap_counting, memory_order_relaxed))
+        atomic_fetch_sub_explicit(&heap_live, (long)malloc_usable_size(ptr), memory_order_relaxed);
+    __libc_free(ptr);
+}
+
+static void heap_start(void) {
+    atomic_store(&heap_allocations, 0);
+    atomic_store(&heap_bytes, 0);
+    atomic_store(&heap_live, 0);
+    atomic_store(&heap_peak, 0);
+    atomic_store(&heap_counting, 1);
+}
+
+static void heap_stop(footprint_t* footprint) {
+    atomic_store(&heap_counting, 0);
+    footprint->heap_allocations = atomic_load(&heap_allocations);
+    footprint->heap_bytes = atomic_load(&heap_bytes);
+    footprint->heap_peak_bytes = atomic_load(&heap_peak);
+}
+
+int footprint_heap_supported(void) {
+    return 1;
+}
+#else
+static void heap_start(void) {
+}
+
+static void heap_stop(footprint_t* footprint) {
+    footprint->heap_allocations = 0;
+    footprint->heap_bytes = 0;
+    footprint->heap_peak_bytes = 0;
+}
+
+int footprint_heap_supported(void) {
+    return 0;
+}
+#endif
+
+/* ------------------------------------------------------------------------ */
+/* Stack: the measured call runs on a thread whose stack we allocate, so it  */
+/* can be painted below the caller's frame and scanned afterwards for the    */
+/* deepest byte that changed.                                                */
+/* ------------------------------------------------------------------------ */
+
+typedef struct {
+    function_t fn;
+    unsigned char* stack;
+    size_t used;
+    footprint_t footprint;
+} measurement_t;
+
+// Paints from the bottom of the stack up to a little below this function's own frame
+static __attribute__((noinline)) void stack_paint(unsigned char* bottom) {
+    volatile unsigned char* p = bottom;
+    unsigned char* end = (unsigned char*)__builtin_frame_address(0) - PAINT_MARGIN;
+    while ((unsigned char*)p < end)
+        *p++ = STACK_PATTERN;
+}
+
+static void* measurement_main(void* raw_measurement) {
+    measurement_t* measurement = raw_measurement;
+
+    measurement->fn();
+    stack_paint(measurement->stack);
+    heap_start();
+    measurement->fn();
+    heap_stop(&measurement->footprint);
+
+    unsigned char* p = measurement->stack;
+    unsigned char* top = __builtin_frame_address(0);
+    while (p < top && *p == STACK_PATTERN)
+        p++;
+    measurement->used = top - p;
+    return NULL;
+}
+
+static void measure_stack(measurement_t* measurement) {
+    pthread_attr_t attr;
+    pthread_t thread;
+
+    measurement->stack = mmap(NULL, STACK_BYTES, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    pthread_attr_init(&attr);
+    pthread_attr_setstack(&attr, measurement->stack, STACK_BYTES);
+    pthread_create(&thread, &attr, measurement_main, measurement);
+    pthread_join(thread, NULL);
+    pthread_attr_destroy(&attr);
+    munmap(measurement->stack, STACK_BYTES);
+}
+
+static void empty(void) {
+}
+
+void footprint_measure(function_t fn, footprint_t* footprint) {
+    // The empty call gives the stack used by the harness itself, which is subtracted
+    measurement_t baseline = { .fn = empty };
+    measurement_t measurement = { .fn = fn };
+    measure_stack(&baseline);
+    measure_stack(&measurement);
+
+    *footprint = measurement.footprint;
+    footprint->stack_bytes = measurement.used > baseline.used ? measurement.used - baseline.used : 0;
+}
+
+/* ------------------------------------------------------------------------ */
+/* Statics: the linker marks where .data and .bss start and end, and the     */
+/* PT_TLS header gives the thread-local block every thread gets a copy of.  */
+/* The test binaries keep their own buffers on the heap, so this is the     */
+/* libraries'.                                                              */
+/* ------------------------------------------------------------------------ */
+
+#ifdef __linux__
+extern char __data_start[], _edata[], __bss_start[], _end[];
+
+size_t footprint_static_data(void) {
+    return _edata - __data_start;
+}
+
+size_t footprint_static_bss(void) {
+    return _end - __bss_start;
+}
+
+// The executable is the first object dl_iterate_phdr reports
+static int find_tls(struct dl_phdr_info* info, size_t size, void* raw_tls_bytes) {
+    size_t* tls_bytes = raw_tls_bytes;
+    for (size_t i = 0; i < info->dlpi_phnum; i++)
+        if (info->dlpi_phdr[i].p_type == PT_TLS)
+            *tls_bytes = info->dlpi_phdr[i].p_memsz;
+    return 1;
+}
+
+size_t footprint_static_tls(void) {
+    size_t tls_bytes = 0;
+    dl_iterate_phdr(find_tls, &tls_bytes);
+    return tls_bytes;
+}
+#else
+size_t footprint_static_data(void) {
+    return 0;
+}
+
+size_t footprint_static_bss(void) {
+    return 0;
+}
+
+size_t footprint_static_tls(void) {
+    return 0;
+}
+#endif
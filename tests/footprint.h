@@ -0,0 +1,32 @@
+#ifndef _FOOTPRINT_H_
+#define _FOOTPRINT_H_
+#include "benchmark.h"
+#include <stddef.h>
+
+// Memory used by one call of an operation
+typedef struct {
+    size_t stack_bytes;      // deepest stack use, found by painting the stack beforehand
+    size_t heap_allocations; // malloc/calloc/realloc/aligned allocation calls
+    size_t heap_bytes;       // bytes requested by those calls
+    size_t heap_peak_bytes;  // peak heap in use above the level before the call
+} footprint_t;
+
+/**
+ * @brief Measures the stack and heap used by one call of fn.
+ *
+ * fn runs once to warm up lazily initialised state, then once measured, both
+ * on a fresh thread with a painted stack. Heap use is counted by the malloc
+ * family in footprint.c, which replaces libc's, so allocations made by other
+ * threads during the call (e.g. a hybrid KEM's helper) are counted too.
+ */
+void footprint_measure(function_t fn, footprint_t* footprint);
+
+// Whether heap use is counted on this platform (it needs glibc's __libc_* allocator)
+int footprint_heap_supported(void);
+
+// Size of the binary's .data, .bss and per-thread TLS block, i.e. the statics of the linked libraries (0 where unknown)
+size_t footprint_static_data(void);
+size_t footprint_static_bss(void);
+size_t footprint_static_tls(void);
+
+#endif
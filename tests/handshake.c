@@ -0,0 +1,692 @@
+#define _GNU_SOURCE
+#include "benchmark.h"
+#include "kem.h"
+#include <errno.h>
+#include <inttypes.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <openssl/sha.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+// Test configuration
+#define DEFAULT_CONCURRENCY "1,2,4,8,16"
+#define DEFAULT_DURATION_MS 1000
+#define DEFAULT_MODES "oneshot,stream"
+#define WARMUP_PERCENTAGE 20
+#define MAX_CONCURRENCY_LEVELS 16
+#define LISTEN_BACKLOG 1024
+#define MAX_EVENTS 64
+#define CONFIRM_EVERY 64 // handshakes per connection between shared secret checks
+#define CONFIRM_BYTES SHA256_DIGEST_LENGTH
+
+static void sleep_us(long us) {
+    struct timespec t = { .tv_sec = us / US_PER_SEC, .tv_nsec = (us % US_PER_SEC) * (NS_PER_SEC / US_PER_SEC) };
+    while (nanosleep(&t, &t) != 0 && errno == EINTR)
+        ;
+}
+
+/**
+ * @brief Hash of a shared secret that the server sends after the ct and the client
+ * compares with its own. Done on every CONFIRM_EVERY-th handshake of a connection,
+ * starting with the first, so both sides know which ones without a flag on the wire.
+ */
+static void confirm_tag(unsigned char* tag, const unsigned char* ss, size_t ss_len) {
+    SHA256(ss, ss_len, tag);
+}
+
+/* ------------------------------------------------------------------------ */
+/* Wire: how messages are sent, shared by server and clients. Segments with */
+/* gaps make a message arrive in pieces, as over a real link, so streaming  */
+/* enc/dec has something to overlap with.                                   */
+/* ------------------------------------------------------------------------ */
+
+typedef struct {
+    int stream;     // pass the pk/ct to the streaming API chunk by chunk as it is read
+    size_t segment; // bytes per write, 0 for whole messages
+    long gap_us;    // pause between segments
+} wire_t;
+
+/**
+ * @brief Writes up to len bytes in segments, pausing between them.
+ *
+ * @return Bytes written, short if a non-blocking socket fills up, or -1 on error.
+ */
+static ssize_t write_segments(int fd, const unsigned char* buf, size_t len, const wire_t* wire) {
+    size_t done = 0;
+    while (done < len) {
+        size_t chunk = wire->segment > 0 && wire->segment < len - done ? wire->segment : len - done;
+        if (done > 0 && wire->gap_us > 0)
+            sleep_us(wire->gap_us);
+        ssize_t n = write(fd, buf + done, chunk);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n < 0)
+            return done > 0 || errno == EAGAIN ? (ssize_t)done : -1;
+        done += n;
+        if ((size_t)n < chunk)
+            break;
+    }
+    return done;
+}
+
+/* ------------------------------------------------------------------------ */
+/* Server: a pool of workers, each with its own epoll set. The listening     */
+/* socket is in every set with EPOLLEXCLUSIVE, so one worker wakes per       */
+/* connection and then owns it. Each request is a public key, answered with  */
+/* the ciphertext from encapsulating to it. A failed encapsulation is        */
+/* counted and closes the connection instead of sending a ciphertext.        */
+/* ------------------------------------------------------------------------ */
+
+typedef struct {
+    int fd;
+    int writing; // 0 while reading the pk, 1 while sending the ct
+    size_t done;
+    size_t reply_len; // ct, plus the confirm tag on sampled handshakes
+    size_t handshakes;
+    unsigned char* pk;
+    unsigned char* ct;
+    void* state; // streaming enc state, NULL in one-shot mode
+} connection_t;
+
+typedef struct {
+    const kem_t* kem;
+    const wire_t* wire;
+    int listen_fd;
+    int stop_fd; // eventfd, readable once the server shuts down
+    size_t workers_len;
+    pthread_t* workers;
+    atomic_size_t enc_failures;
+} server_t;
+
+static void connection_close(int epoll_fd, connection_t* conn) {
+    epoll_ctl(epoll_fd, EPOLL_CTL_DEL, conn->fd, NULL);
+    close(conn->fd);
+    free(conn->pk);
+    free(conn->state);
+    free(conn);
+}
+
+static void server_accept(const server_t* server, int epoll_fd) {
+    for (;;) {
+        int fd = accept4(server->listen_fd, NULL, NULL, SOCK_NONBLOCK);
+        if (fd < 0)
+            return; // EAGAIN, or another worker took it
+
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one)); // fails harmlessly on Unix sockets
+
+        connection_t* conn = calloc(1, sizeof(*conn));
+        conn->fd = fd;
+        conn->pk = malloc(server->kem->public_key_bytes + server->kem->ciphertext_bytes + CONFIRM_BYTES);
+        conn->ct = conn->pk + server->kem->public_key_bytes;
+        if (server->wire->stream && server->kem->enc_init != NULL) {
+            conn->state = malloc(server->kem->enc_state_bytes);
+            server->kem->enc_init(conn->state);
+        }
+
+        struct epoll_event event = { .events = EPOLLIN, .data.ptr = conn };
+        epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event);
+    }
+}
+
+/**
+ * @brief Makes progress on one connection: reads the pk, encapsulates, writes the ct.
+ *
+ * The ct is written straight after encapsulating, and EPOLLOUT is only
+ * requested when the socket buffer is full, so small messages take no extra
+ * epoll round trip. When streaming, every chunk of the pk goes to enc_update
+ * as it is read. Gaps between segments block the worker.
+ */
+static void server_handle(server_t* server, int epoll_fd, connection_t* conn, unsigned char* ss) {
+    const kem_t* kem = server->kem;
+
+    if (!conn->writing) {
+        ssize_t n = read(conn->fd, conn->pk + conn->done, kem->public_key_bytes - conn->done);
+        if (n == 0 || (n < 0 && errno != EAGAIN && errno != EINTR)) {
+            connection_close(epoll_fd, conn);
+            return;
+        }
+        if (n < 0)
+            return;
+        if (conn->state != NULL)
+            kem->enc_update(conn->state, conn->pk + conn->done, n);
+        if ((conn->done += n) < kem->public_key_bytes)
+            return;
+
+        int failed;
+        if (conn->state != NULL) {
+            failed = kem->enc_final(conn->ct, ss, conn->state);
+            kem->enc_init(conn->state);
+        } else {
+            failed = kem->enc(conn->ct, ss, conn->pk);
+        }
+        if (failed != 0) {
+            atomic_fetch_add(&server->enc_failures, 1);
+            connection_close(epoll_fd, conn);
+            return;
+        }
+        conn->reply_len = kem->ciphertext_bytes;
+        if (conn->handshakes++ % CONFIRM_EVERY == 0) {
+            confirm_tag(conn->ct + kem->ciphertext_bytes, ss, kem->shared_secret_bytes);
+            conn->reply_len += CONFIRM_BYTES;
+        }
+        conn->writing = 1;
+        conn->done = 0;
+    }
+
+    ssize_t n = write_segments(conn->fd, conn->ct + conn->done, conn->reply_len - conn->done, server->wire);
+    if (n < 0) {
+        connection_close(epoll_fd, conn);
+        return;
+    }
+    if (n > 0)
+        conn->done += n;
+
+    struct epoll_event event = { .events = EPOLLIN, .data.ptr = conn };
+    if (conn->done == conn->reply_len) {
+        conn->writing = 0;
+        conn->done = 0;
+        epoll_ctl(epoll_fd, EPOLL_CTL_MOD, conn->fd, &event);
+    } else {
+        event.events = EPOLLOUT;
+        epoll_ctl(epoll_fd, EPOLL_CTL_MOD, conn->fd, &event);
+    }
+}
+
+static void* server_worker(void* raw_server) {
+    server_t* server = raw_server;
+    unsigned char* ss = malloc(server->kem->shared_secret_bytes);
+    struct epoll_event events[MAX_EVENTS];
+
+    int epoll_fd = epoll_create1(0);
+    struct epoll_event event = { .events = EPOLLIN | EPOLLEXCLUSIVE, .data.ptr = (void*)&server->listen_fd };
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, server->listen_fd, &event);
+    event = (struct epoll_event){ .events = EPOLLIN, .data.ptr = (void*)&server->stop_fd };
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, server->stop_fd, &event);
+
+    // Connections still open at shutdown are leaked, the process exits soon after
+    for (;;) {
+        int events_len = epoll_wait(epoll_fd, events, MAX_EVENTS, -1);
+        for (int i = 0; i < events_len; i++) {
+            if (events[i].data.ptr == &server->stop_fd) {
+                close(epoll_fd);
+                free(ss);
+                return NULL;
+            } else if (events[i].data.ptr == &server->listen_fd) {
+                server_accept(server, epoll_fd);
+            } else {
+                server_handle(server, epoll_fd, events[i].data.ptr, ss);
+            }
+        }
+    }
+}
+
+static void server_start(server_t* server, const kem_t* kem, const wire_t* wire, int listen_fd, size_t workers_len) {
+    server->kem = kem;
+    server->wire = wire;
+    server->listen_fd = listen_fd;
+    server->stop_fd = eventfd(0, EFD_NONBLOCK);
+    server->workers_len = workers_len;
+    server->workers = malloc(workers_len * sizeof(pthread_t));
+    atomic_init(&server->enc_failures, 0);
+    for (size_t i = 0; i < workers_len; i++)
+        pthread_create(&server->workers[i], NULL, server_worker, server);
+}
+
+static void server_stop(server_t* server) {
+    uint64_t one = 1;
+    if (write(server->stop_fd, &one, sizeof(one)) < 0)
+        perror("eventfd");
+    for (size_t i = 0; i < server->workers_len; i++)
+        pthread_join(server->workers[i], NULL);
+    close(server->stop_fd);
+    free(server->workers);
+}
+
+/* ------------------------------------------------------------------------ */
+/* Transports                                                               */
+/* ------------------------------------------------------------------------ */
+
+typedef struct {
+    const char* name;
+    int domain;
+    struct sockaddr_storage addr;
+    socklen_t addr_len;
+} transport_t;
+
+/**
+ * @brief Binds a listening socket on loopback (TCP) or in /tmp (Unix) and records its address.
+ *
+ * @return The listening socket, or -1 on failure.
+ */
+static int transport_listen(transport_t* transport) {
+    int fd = socket(transport->domain, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    if (fd < 0)
+        return -1;
+
+    if (transport->domain == AF_INET) {
+        struct sockaddr_in* addr = (struct sockaddr_in*)&transport->addr;
+        int one = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        addr->sin_family = AF_INET;
+        addr->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr->sin_port = 0; // let the kernel pick, read back below
+        transport->addr_len = sizeof(*addr);
+    } else {
+        struct sockaddr_un* addr = (struct sockaddr_un*)&transport->addr;
+        addr->sun_family = AF_UNIX;
+        snprintf(addr->sun_path, sizeof(addr->sun_path), "/tmp/kem-handshake-%d.sock", (int)getpid());
+        unlink(addr->sun_path);
+        transport->addr_len = sizeof(*addr);
+    }
+
+    if (bind(fd, (struct sockaddr*)&transport->addr, transport->addr_len) < 0
+        || listen(fd, LISTEN_BACKLOG) < 0
+        || getsockname(fd, (struct sockaddr*)&transport->addr, &transport->addr_len) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static void transport_close(transport_t* transport, int listen_fd) {
+    close(listen_fd);
+    if (transport->domain == AF_UNIX)
+        unlink(((struct sockaddr_un*)&transport->addr)->sun_path);
+}
+
+/* ------------------------------------------------------------------------ */
+/* Clients: one blocking connection per thread, running handshakes back to  */
+/* back. A handshake is keygen, send pk, receive ct, decapsulate, timed     */
+/* from the client's side. The tail is the time from the last byte of the   */
+/* ct to the shared secret, which streaming dec shortens. Sampled           */
+/* handshakes then read the server's confirm tag, outside the timing.       */
+/* ------------------------------------------------------------------------ */
+
+enum { PHASE_WARMUP, PHASE_MEASURE, PHASE_STOP };
+
+typedef struct {
+    const kem_t* kem;
+    const transport_t* transport;
+    const wire_t* wire;
+    atomic_int* phase;
+    uint64_t* latencies;
+    uint64_t* tails;
+    size_t latencies_len;
+    size_t latencies_cap;
+    size_t confirmed;  // handshakes whose shared secret was compared with the server's
+    size_t mismatches; // ... and differed
+    int failed;
+} client_t;
+
+static int write_all(int fd, const unsigned char* buf, size_t len, const wire_t* wire) {
+    while (len > 0) {
+        ssize_t n = write_segments(fd, buf, len, wire);
+        if (n <= 0)
+            return -1;
+        buf += n;
+        len -= n;
+    }
+    return 0;
+}
+
+/**
+ * @brief Reads the ct, passing every chunk to dec_update when state is set.
+ *
+ * @param last Set to the time the last byte was read.
+ */
+static int read_ct(int fd, unsigned char* ct, const kem_t* kem, void* state, uint64_t* last) {
+    size_t done = 0;
+    while (done < kem->ciphertext_bytes) {
+        ssize_t n = read(fd, ct + done, kem->ciphertext_bytes - done);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return -1;
+        *last = now_ns();
+        if (state != NULL)
+            kem->dec_update(state, ct + done, n);
+        done += n;
+    }
+    return 0;
+}
+
+static int read_all(int fd, unsigned char* buf, size_t len) {
+    while (len > 0) {
+        ssize_t n = read(fd, buf, len);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return -1;
+        buf += n;
+        len -= n;
+    }
+    return 0;
+}
+
+static void* client_main(void* raw_client) {
+    client_t* client = raw_client;
+    const kem_t* kem = client->kem;
+    unsigned char* pk = malloc(kem->public_key_bytes);
+    unsigned char* sk = malloc(kem->secret_key_bytes);
+    unsigned char* ct = malloc(kem->ciphertext_bytes);
+    unsigned char* ss = malloc(kem->shared_secret_bytes);
+    void* state = client->wire->stream && kem->dec_init != NULL ? malloc(kem->dec_state_bytes) : NULL;
+
+    int fd = socket(client->transport->domain, SOCK_STREAM, 0);
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    if (connect(fd, (const struct sockaddr*)&client->transport->addr, client->transport->addr_len) < 0)
+        client->failed = 1;
+
+    int phase;
+    for (size_t handshakes = 0; !client->failed && (phase = atomic_load(client->phase)) != PHASE_STOP; handshakes++) {
+        uint64_t start = now_ns(), last = 0;
+        kem->keypair(pk, sk);
+        if (state != NULL)
+            kem->dec_init(state, sk);
+        if (write_all(fd, pk, kem->public_key_bytes, client->wire) != 0 || read_ct(fd, ct, kem, state, &last) != 0) {
+            client->failed = 1;
+            break;
+        }
+        int failed = state != NULL ? kem->dec_final(ss, state) : kem->dec(ss, ct, sk);
+        uint64_t end = now_ns();
+
+        if (handshakes % CONFIRM_EVERY == 0) {
+            unsigned char tag[CONFIRM_BYTES], expected[CONFIRM_BYTES];
+            if (read_all(fd, tag, CONFIRM_BYTES) != 0) {
+                client->failed = 1;
+                break;
+            }
+            confirm_tag(expected, ss, kem->shared_secret_bytes);
+            client->confirmed++;
+            client->mismatches += memcmp(tag, expected, CONFIRM_BYTES) != 0;
+        }
+        if (failed != 0) {
+            client->failed = 1;
+            break;
+        }
+
+        // Only handshakes that start and finish inside the measurement window count
+        if (phase != PHASE_MEASURE || atomic_load(client->phase) != PHASE_MEASURE)
+            continue;
+        if (client->latencies_len == client->latencies_cap) {
+            client->latencies_cap = client->latencies_cap ? 2 * client->latencies_cap : 1024;
+            client->latencies = realloc(client->latencies, client->latencies_cap * sizeof(uint64_t));
+            client->tails = realloc(client->tails, client->latencies_cap * sizeof(uint64_t));
+        }
+        client->tails[client->latencies_len] = end - last;
+        client->latencies[client->latencies_len++] = end - start;
+    }
+
+    close(fd);
+    free(state);
+    free(pk);
+    free(sk);
+    free(ct);
+    free(ss);
+    return NULL;
+}
+
+static void sleep_ms(long ms) {
+    struct timespec t = { .tv_sec = ms / MS_PER_SEC, .tv_nsec = (ms % MS_PER_SEC) * (NS_PER_SEC / MS_PER_SEC) };
+    while (nanosleep(&t, &t) != 0 && errno == EINTR)
+        ;
+}
+
+/**
+ * @brief Runs concurrency clients against the server for duration_ms, then prints and returns 0.
+ *
+ * Returns -1 instead if a client or an encapsulation failed, or a sampled
+ * shared secret differed between client and server.
+ */
+static int run_level(server_t* server, const transport_t* transport, const wire_t* wire, size_t concurrency,
+    long duration_ms) {
+    const kem_t* kem = server->kem;
+    atomic_int phase = PHASE_WARMUP;
+    client_t* clients = calloc(concurrency, sizeof(client_t));
+    pthread_t* threads = malloc(concurrency * sizeof(pthread_t));
+
+    for (size_t i = 0; i < concurrency; i++) {
+        clients[i] = (client_t){ .kem = kem, .transport = transport, .wire = wire, .phase = &phase };
+        pthread_create(&threads[i], NULL, client_main, &clients[i]);
+    }
+
+    sleep_ms(duration_ms * WARMUP_PERCENTAGE / 100);
+    uint64_t start = now_ns();
+    atomic_store(&phase, PHASE_MEASURE);
+    sleep_ms(duration_ms);
+    atomic_store(&phase, PHASE_STOP);
+    uint64_t elapsed = now_ns() - start;
+
+    // Merge every client's latencies
+    size_t latencies_len = 0, confirmed = 0, mismatches = 0;
+    int failed = 0;
+    for (size_t i = 0; i < concurrency; i++) {
+        pthread_join(threads[i], NULL);
+        latencies_len += clients[i].latencies_len;
+        confirmed += clients[i].confirmed;
+        mismatches += clients[i].mismatches;
+        failed |= clients[i].failed;
+    }
+    // A failed encapsulation closes the connection before the client reads EOF, so it is counted by now
+    size_t enc_failures = atomic_exchange(&server->enc_failures, 0);
+    uint64_t* latencies = malloc((latencies_len + 1) * sizeof(uint64_t));
+    uint64_t* tails = malloc((latencies_len + 1) * sizeof(uint64_t));
+    size_t offset = 0;
+    for (size_t i = 0; i < concurrency; i++) {
+        memcpy(latencies + offset, clients[i].latencies, clients[i].latencies_len * sizeof(uint64_t));
+        memcpy(tails + offset, clients[i].tails, clients[i].latencies_len * sizeof(uint64_t));
+        offset += clients[i].latencies_len;
+        free(clients[i].latencies);
+        free(clients[i].tails);
+    }
+    free(clients);
+    free(threads);
+
+    if (failed || latencies_len == 0 || mismatches > 0) {
+        printf("ERROR: %s over %s failed at concurrency %zu (%zu failed encapsulations, %zu of %zu checked shared "
+               "secrets differ)\n",
+            kem->name, transport->name, concurrency, enc_failures, mismatches, confirmed);
+        free(latencies);
+        free(tails);
+        return -1;
+    }
+
+    // remove_outliers with 0% only sorts
+    remove_outliers(latencies, latencies_len, 0);
+    remove_outliers(tails, latencies_len, 0);
+    double rate = latencies_len * (double)NS_PER_SEC / elapsed;
+    uint64_t p50 = latencies[(size_t)(latencies_len * 0.50)];
+    uint64_t p90 = latencies[(size_t)(latencies_len * 0.90)];
+    uint64_t p99 = latencies[(size_t)(latencies_len * 0.99)];
+    uint64_t p999 = latencies[(size_t)(latencies_len * 0.999)];
+    uint64_t tail_p50 = tails[(size_t)(latencies_len * 0.50)];
+    uint64_t tail_p99 = tails[(size_t)(latencies_len * 0.99)];
+    const char* mode = wire->stream ? "stream" : "oneshot";
+
+    printf("%-28s %-5s %-7s %5zu %12.0f %10" PRIu64 " %10" PRIu64 " %10" PRIu64 " %10" PRIu64 " %10.1f %10.1f\n",
+        kem->name, transport->name, mode, concurrency, rate, p50 / 1000, p90 / 1000, p99 / 1000, p999 / 1000,
+        tail_p50 / 1e3, tail_p99 / 1e3);
+
+    // CSV output to stderr for collection
+    fprintf(stderr, "%s,%s,%s,%zu,%.0f,%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%" PRIu64 "\n",
+        kem->name, transport->name, mode, concurrency, rate, p50, p90, p99, p999, tail_p50, tail_p99);
+
+    free(latencies);
+    free(tails);
+    return 0;
+}
+
+/**
+ * @brief Checks that a KEM round-trips before putting it behind a socket, and
+ * that its streaming API, if any, gives the same shared secret.
+ */
+static int validate(const kem_t* kem) {
+    unsigned char* pk = malloc(kem->public_key_bytes);
+    unsigned char* sk = malloc(kem->secret_key_bytes);
+    unsigned char* ct = malloc(kem->ciphertext_bytes);
+    unsigned char* ss = malloc(kem->shared_secret_bytes);
+    unsigned char* ss_check = malloc(kem->shared_secret_bytes);
+
+    kem->keypair(pk, sk);
+    kem->enc(ct, ss, pk);
+    kem->dec(ss_check, ct, sk);
+    int result = memcmp(ss, ss_check, kem->shared_secret_bytes);
+
+    if (result == 0 && kem->enc_init != NULL) {
+        void* state = malloc(kem->enc_state_bytes);
+        kem->enc_init(state);
+        kem->enc_update(state, pk, kem->public_key_bytes / 3);
+        kem->enc_update(state, pk + kem->public_key_bytes / 3, kem->public_key_bytes - kem->public_key_bytes / 3);
+        kem->enc_final(ct, ss, state);
+        kem->dec(ss_check, ct, sk);
+        result = memcmp(ss, ss_check, kem->shared_secret_bytes);
+        free(state);
+    }
+    if (result == 0 && kem->dec_init != NULL) {
+        void* state = malloc(kem->dec_state_bytes);
+        kem->dec_init(state, sk);
+        kem->dec_update(state, ct, kem->ciphertext_bytes / 3);
+        kem->dec_update(state, ct + kem->ciphertext_bytes / 3, kem->ciphertext_bytes - kem->ciphertext_bytes / 3);
+        kem->dec_final(ss_check, state);
+        result = memcmp(ss, ss_check, kem->shared_secret_bytes);
+        free(state);
+    }
+
+    free(pk);
+    free(sk);
+    free(ct);
+    free(ss);
+    free(ss_check);
+    return result;
+}
+
+/**
+ * @brief End-to-end handshake throughput and latency over loopback sockets.
+ *
+ * For every selected KEM and transport, an epoll server with a pool of worker
+ * threads answers public keys with ciphertexts, while a growing number of
+ * client threads run handshakes back to back on persistent connections. This
+ * adds the syscalls, copies and socket buffering of multi-kilobyte keys that
+ * the per-operation benchmarks leave out.
+ *
+ * KEMs with a streaming API also run in stream mode, where enc and/or dec
+ * (whichever the library streams) take the pk or ct chunk by chunk as it is
+ * read. -s and -g write messages in paced segments, so the chunks arrive
+ * apart; the tail columns time the last byte of the ct to the shared secret.
+ * Every CONFIRM_EVERY-th handshake of a connection, the server sends a hash of
+ * its shared secret after the ct and the client compares it with its own.
+ *
+ * Usage: ./handshake [-c 1,2,4] [-d ms] [-w workers] [-t tcp|unix|both] [-m oneshot,stream] [-s bytes] [-g us]
+ *        [name ...]
+ */
+int main(int argc, char** argv) {
+    const char* concurrency_arg = DEFAULT_CONCURRENCY;
+    long duration_ms = DEFAULT_DURATION_MS;
+    long workers = sysconf(_SC_NPROCESSORS_ONLN);
+    const char* transport_arg = "both";
+    const char* modes_arg = DEFAULT_MODES;
+    wire_t wire = { 0 };
+
+    int opt;
+    while ((opt = getopt(argc, argv, "c:d:w:t:m:s:g:")) != -1) {
+        switch (opt) {
+        case 'c': concurrency_arg = optarg; break;
+        case 'd': duration_ms = atol(optarg); break;
+        case 'w': workers = atol(optarg); break;
+        case 't': transport_arg = optarg; break;
+        case 'm': modes_arg = optarg; break;
+        case 's': wire.segment = atol(optarg); break;
+        case 'g': wire.gap_us = atol(optarg); break;
+        default:
+            fprintf(stderr,
+                "Usage: %s [-c 1,2,4] [-d ms] [-w workers] [-t tcp|unix|both] [-m oneshot,stream] [-s bytes] [-g us] "
+                "[name ...]\n",
+                argv[0]);
+            return -1;
+        }
+    }
+    int oneshot = strstr(modes_arg, "oneshot") != NULL;
+    int stream = strstr(modes_arg, "stream") != NULL;
+    if (workers < 1)
+        workers = 1;
+
+    size_t concurrency[MAX_CONCURRENCY_LEVELS];
+    size_t concurrency_len = 0;
+    char* levels = strdup(concurrency_arg);
+    for (char* level = strtok(levels, ","); level != NULL && concurrency_len < MAX_CONCURRENCY_LEVELS; level = strtok(NULL, ","))
+        if (atol(level) > 0)
+            concurrency[concurrency_len++] = atol(level);
+    free(levels);
+
+    transport_t transports[2];
+    size_t transports_len = 0;
+    if (strcmp(transport_arg, "unix") != 0)
+        transports[transports_len++] = (transport_t){ .name = "tcp", .domain = AF_INET };
+    if (strcmp(transport_arg, "tcp") != 0)
+        transports[transports_len++] = (transport_t){ .name = "unix", .domain = AF_UNIX };
+
+    // Select KEMs by name, or all of them
+    const kem_t* selected[kem_registry_len];
+    size_t selected_len = kem_select(argc - optind, argv + optind, selected);
+    if (selected_len == 0)
+        return -1;
+
+    // A client that disconnects mid-write must not kill the server
+    signal(SIGPIPE, SIG_IGN);
+
+    // Header and static data
+    printf("=====================================\n");
+    printf("PQC KEM Loopback Handshake Benchmark\n");
+    printf("=====================================\n");
+    printf("Workers:     %7ld threads\n", workers);
+    printf("Duration:    %7ld ms per level (+%d%% warmup)\n", duration_ms, WARMUP_PERCENTAGE);
+    if (wire.segment > 0)
+        printf("Segments:    %7zu bytes, %ld us apart\n", wire.segment, wire.gap_us);
+    printf("=====================================\n");
+    printf("%-28s %-5s %-7s %5s %12s %10s %10s %10s %10s %10s %10s\n", "Algorithm", "Link", "Mode", "Conc",
+        "Handshakes/s", "p50 (us)", "p90 (us)", "p99 (us)", "p99.9 (us)", "Tail p50", "Tail p99");
+
+    int result = 0;
+    for (size_t i = 0; i < selected_len; i++) {
+        if (validate(selected[i]) != 0) {
+            printf("ERROR: Shared secrets don't match for %s!\n", selected[i]->name);
+            return -1;
+        }
+
+        for (size_t t = 0; t < transports_len; t++) {
+            int listen_fd = transport_listen(&transports[t]);
+            if (listen_fd < 0) {
+                perror(transports[t].name);
+                return -1;
+            }
+
+            // A server per mode, since connections set up their streaming state at accept
+            for (int s = 0; s <= 1; s++) {
+                if (s ? !stream || (selected[i]->enc_init == NULL && selected[i]->dec_init == NULL) : !oneshot)
+                    continue;
+                wire.stream = s;
+                server_t server;
+                server_start(&server, selected[i], &wire, listen_fd, workers);
+                for (size_t c = 0; c < concurrency_len; c++)
+                    result |= run_level(&server, &transports[t], &wire, concurrency[c], duration_ms);
+                server_stop(&server);
+            }
+            transport_close(&transports[t], listen_fd);
+        }
+    }
+
+    return result;
+}
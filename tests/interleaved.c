@@ -0,0 +1,163 @@
+#include "benchmark.h"
+#include "kem.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Test configuration
+#define WARMUP_ITERATIONS 1000
+#define MEASUREMENT_ITERATIONS 10000
+#define BLOCK_ITERATIONS 100
+#define OUTLIER_PERCENTAGE 10
+
+#define OPERATIONS 3
+
+// Per-KEM buffers and timings
+typedef struct {
+    const kem_t* kem;
+    unsigned char* pk;
+    unsigned char* sk;
+    unsigned char* ct;
+    unsigned char* ss;
+    uint64_t* timings[OPERATIONS];
+} kem_state_t;
+
+/**
+ * @brief Generates a new keypair into the state's pk and sk buffers.
+ */
+void keygen(void* raw_state) {
+    kem_state_t* state = raw_state;
+    state->kem->keypair(state->pk, state->sk);
+}
+
+/**
+ * @brief Encapsulates against the state's pk into its ct and ss buffers.
+ */
+void enc(void* raw_state) {
+    kem_state_t* state = raw_state;
+    state->kem->enc(state->ct, state->ss, state->pk);
+}
+
+/**
+ * @brief Decapsulates the state's ct with its sk into its ss buffer.
+ */
+void dec(void* raw_state) {
+    kem_state_t* state = raw_state;
+    state->kem->dec(state->ss, state->ct, state->sk);
+}
+
+static const function_ctx_t operations[OPERATIONS] = { keygen, enc, dec };
+static const char* operation_labels[OPERATIONS] = { "KeyGen", "Encapsulation", "Decapsulation" };
+
+/**
+ * @brief Checks that a KEM round-trips, so broken variants are not timed.
+ *
+ * @return 0 when encapsulation and decapsulation agree on the shared secret.
+ */
+int validate(kem_state_t* state) {
+    unsigned char* ss_check = malloc(state->kem->shared_secret_bytes);
+    keygen(state);
+    enc(state);
+    state->kem->dec(ss_check, state->ct, state->sk);
+    int result = memcmp(state->ss, ss_check, state->kem->shared_secret_bytes);
+    free(ss_check);
+    return result;
+}
+
+/**
+ * @brief Benchmarks every selected KEM in one process, interleaving them.
+ *
+ * Measurements are taken in blocks of BLOCK_ITERATIONS: each round runs one
+ * block of every operation of every KEM, and the KEM order is rotated between
+ * rounds. All variants therefore see the same thermal and frequency conditions,
+ * which sequential runs of the *.test binaries cannot guarantee.
+ *
+ * Usage: ./interleaved [name ...]   (no names selects every registered KEM)
+ */
+int main(int argc, char** argv) {
+    // Select KEMs by name, or all of them
+    const kem_t* selected[kem_registry_len];
+    size_t states_len = kem_select(argc - 1, argv + 1, selected);
+    if (states_len == 0)
+        return -1;
+
+    kem_state_t states[states_len];
+    for (size_t i = 0; i < states_len; i++) {
+        kem_state_t* state = &states[i];
+        state->kem = selected[i];
+        state->pk = malloc(selected[i]->public_key_bytes);
+        state->sk = malloc(selected[i]->secret_key_bytes);
+        state->ct = malloc(selected[i]->ciphertext_bytes);
+        state->ss = malloc(selected[i]->shared_secret_bytes);
+        for (size_t op = 0; op < OPERATIONS; op++)
+            state->timings[op] = malloc(MEASUREMENT_ITERATIONS * sizeof(uint64_t));
+
+        if (validate(state) != 0) {
+            printf("ERROR: Shared secrets don't match for %s!\n", selected[i]->name);
+            return -1;
+        }
+    }
+
+    // Header and static data
+    printf("=====================================\n");
+    printf("PQC KEM Interleaved Benchmark\n");
+    printf("Following Paquin et al. (2020) & Becker et al. (2024)\n");
+    printf("=====================================\n");
+    for (size_t i = 0; i < states_len; i++) {
+        printf("Algorithm:   %s (%s)\n", states[i].kem->name, states[i].kem->algname);
+        if (states[i].kem->backend != NULL)
+            printf("Backend:     %s\n", states[i].kem->backend());
+    }
+    printf("=====================================\n");
+    printf("Warmup:      %7d iterations\n", WARMUP_ITERATIONS);
+    printf("Measurement: %7d iterations\n", MEASUREMENT_ITERATIONS);
+    printf("Block:       %7d iterations\n", BLOCK_ITERATIONS);
+    printf("Outliers:    Remove top/bottom %7d%%\n", OUTLIER_PERCENTAGE);
+    printf("=====================================\n");
+
+    // Warmup every KEM before the first measured round
+    for (size_t i = 0; i < states_len; i++)
+        for (size_t op = 0; op < OPERATIONS; op++)
+            benchmark_ctx(operations[op], &states[i], NULL, WARMUP_ITERATIONS, 0);
+
+    // Interleaved measurement rounds
+    size_t rounds = MEASUREMENT_ITERATIONS / BLOCK_ITERATIONS;
+    for (size_t round = 0; round < rounds; round++) {
+        for (size_t i = 0; i < states_len; i++) {
+            kem_state_t* state = &states[(round + i) % states_len];
+            for (size_t op = 0; op < OPERATIONS; op++)
+                benchmark_ctx(operations[op], state, state->timings[op] + round * BLOCK_ITERATIONS, 0, BLOCK_ITERATIONS);
+        }
+    }
+
+    // Per-KEM results
+    size_t measured = rounds * BLOCK_ITERATIONS;
+    for (size_t i = 0; i < states_len; i++) {
+        kem_state_t* state = &states[i];
+        uint64_t medians[OPERATIONS];
+
+        printf("\n=====================================\n");
+        printf("%s\n", state->kem->name);
+        printf("=====================================\n");
+        for (size_t op = 0; op < OPERATIONS; op++) {
+            size_t timings_len = remove_outliers(state->timings[op], measured, OUTLIER_PERCENTAGE);
+            print_distribution(operation_labels[op], state->timings[op], timings_len);
+            medians[op] = state->timings[op][timings_len / 2];
+        }
+
+        // CSV output to stderr for collection, same timing columns as results.csv
+        fprintf(stderr, "%s,%7zu,%7zu,%7zu,%7" PRIu64 ",%7" PRIu64 ",%7" PRIu64 ",%.2f\n",
+            state->kem->name,
+            state->kem->public_key_bytes,
+            state->kem->secret_key_bytes,
+            state->kem->ciphertext_bytes,
+            medians[1],
+            medians[2],
+            medians[1] + medians[2],
+            1000000.f / (float)(medians[1] + medians[2])
+        );
+    }
+
+    return 0;
+}
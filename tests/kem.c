@@ -0,0 +1,134 @@
+#define _GNU_SOURCE
+#include "kem.h"
+
+#ifdef KEM_LIST
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Registry - KEM_LIST is passed in by the Makefile as KEM(kyber_768) KEM(hqc_128) ...
+#define KEM(id) extern const kem_t id;
+KEM_LIST
+#undef KEM
+
+#define KEM(id) &id,
+const kem_t* const kem_registry[] = { KEM_LIST };
+#undef KEM
+
+const size_t kem_registry_len = sizeof(kem_registry) / sizeof(*kem_registry);
+
+/**
+ * @brief Selects registry entries by name, or all of them if no names are given.
+ *
+ * Entries keep their registry order. If nothing matches, the available names
+ * are printed.
+ *
+ * @param names_len Number of names, e.g. argc - optind.
+ * @param names Names to select, e.g. argv + optind.
+ * @param selected Receives the entries, room for kem_registry_len of them.
+ * @return Number of entries selected.
+ */
+size_t kem_select(int names_len, char* const* names, const kem_t** selected) {
+    size_t selected_len = 0;
+    for (size_t i = 0; i < kem_registry_len; i++) {
+        int match = names_len == 0;
+        for (int n = 0; n < names_len; n++)
+            match |= strcmp(names[n], kem_registry[i]->name) == 0;
+        if (match)
+            selected[selected_len++] = kem_registry[i];
+    }
+
+    if (selected_len == 0) {
+        printf("No KEM selected. Available:\n");
+        for (size_t i = 0; i < kem_registry_len; i++)
+            printf("  %s\n", kem_registry[i]->name);
+    }
+    return selected_len;
+}
+
+/**
+ * @brief Checks that keypair_derand expands coins back into the key they were generated as.
+ *
+ * The secret key is regenerated from coins, as the compact stores do before
+ * every use, and must decapsulate an encapsulation to pk.
+ *
+ * @return 0 if the shared secrets match, -1 otherwise.
+ */
+int kem_check_derand(const kem_t* kem, const unsigned char* coins, const unsigned char* pk) {
+    unsigned char* scratch = malloc(kem->public_key_bytes + kem->secret_key_bytes + kem->ciphertext_bytes + 2 * kem->shared_secret_bytes);
+    if (scratch == NULL)
+        return -1;
+    unsigned char* regenerated_pk = scratch;
+    unsigned char* sk = regenerated_pk + kem->public_key_bytes;
+    unsigned char* ct = sk + kem->secret_key_bytes;
+    unsigned char* ss = ct + kem->ciphertext_bytes;
+    unsigned char* ss_check = ss + kem->shared_secret_bytes;
+
+    int rc = kem->keypair_derand(regenerated_pk, sk, coins) != 0 || kem->enc(ct, ss, pk) != 0
+          || kem->dec(ss_check, ct, sk) != 0 || memcmp(ss, ss_check, kem->shared_secret_bytes) != 0 ? -1 : 0;
+
+    explicit_bzero(sk, kem->secret_key_bytes);
+    free(scratch);
+    return rc;
+}
+
+#else
+#include "api.h"
+
+// A hybrid has no derand or streaming entry points of its own, so its entry
+// must not pick up those of a component (see algorithms/hybrid/api.h)
+#if defined(HYBRID_TLS_KEM_H) && (defined(CRYPTO_KEYPAIRCOINBYTES) || defined(CRYPTO_ENCSTATEBYTES) || \
+                                  defined(CRYPTO_DECSTATEBYTES) || defined(CRYPTO_BACKEND))
+#error "hybrid api.h leaks a component's optional entry points"
+#endif
+
+// The streaming API takes its own state types, kem_t takes void*
+#ifdef CRYPTO_ENCSTATEBYTES
+static int enc_init(void* state) { return crypto_kem_enc_init(state); }
+static int enc_update(void* state, const unsigned char* pk, size_t pk_len) { return crypto_kem_enc_update(state, pk, pk_len); }
+static int enc_final(unsigned char* ct, unsigned char* ss, void* state) { return crypto_kem_enc_final(ct, ss, state); }
+#endif
+#ifdef CRYPTO_DECSTATEBYTES
+static int dec_init(void* state, const unsigned char* sk) { return crypto_kem_dec_init(state, sk); }
+static int dec_update(void* state, const unsigned char* ct, size_t ct_len) { return crypto_kem_dec_update(state, ct, ct_len); }
+static int dec_final(unsigned char* ss, void* state) { return crypto_kem_dec_final(ss, state); }
+#endif
+
+/**
+ * @brief Registry entry for the KEM variant whose api.h is on the include path.
+ *
+ * KEM_ID is the C identifier of the entry and KEM_NAME the name it is reported
+ * under, both passed in by the Makefile.
+ */
+const kem_t KEM_ID = {
+    .name = KEM_NAME,
+    .algname = CRYPTO_ALGNAME,
+    .public_key_bytes = CRYPTO_PUBLICKEYBYTES,
+    .secret_key_bytes = CRYPTO_SECRETKEYBYTES,
+    .ciphertext_bytes = CRYPTO_CIPHERTEXTBYTES,
+    .shared_secret_bytes = CRYPTO_BYTES,
+    .keypair = crypto_kem_keypair,
+    .enc = crypto_kem_enc,
+    .dec = crypto_kem_dec,
+#ifdef CRYPTO_KEYPAIRCOINBYTES
+    .keypair_coin_bytes = CRYPTO_KEYPAIRCOINBYTES,
+    .keypair_derand = crypto_kem_keypair_derand,
+#endif
+#ifdef CRYPTO_ENCSTATEBYTES
+    .enc_state_bytes = CRYPTO_ENCSTATEBYTES,
+    .enc_init = enc_init,
+    .enc_update = enc_update,
+    .enc_final = enc_final,
+#endif
+#ifdef CRYPTO_DECSTATEBYTES
+    .dec_state_bytes = CRYPTO_DECSTATEBYTES,
+    .dec_init = dec_init,
+    .dec_update = dec_update,
+    .dec_final = dec_final,
+#endif
+#ifdef CRYPTO_BACKEND
+    .backend = CRYPTO_BACKEND,
+#endif
+};
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef _KEM_H_
+#define _KEM_H_
+#include <stddef.h>
+
+// Registry entry for one KEM variant. Entries are defined in kem.c, which is
+// compiled once per variant against that variant's api.h, so their names only
+// depend on the namespaced crypto_kem_* symbols exported by each library.
+typedef struct {
+    const char* name;
+    const char* algname;
+    size_t public_key_bytes;
+    size_t secret_key_bytes;
+    size_t ciphertext_bytes;
+    size_t shared_secret_bytes;
+    int (*keypair)(unsigned char* pk, unsigned char* sk);
+    int (*enc)(unsigned char* ct, unsigned char* ss, const unsigned char* pk);
+    int (*dec)(unsigned char* ss, const unsigned char* ct, const unsigned char* sk);
+    // Keygen from given coins, which are then a compact form of the secret
+    // key. NULL (and 0 coin bytes) if the library has no such keygen.
+    size_t keypair_coin_bytes;
+    int (*keypair_derand)(unsigned char* pk, unsigned char* sk, const unsigned char* coins);
+    // Streaming enc and dec, fed the public key or ciphertext in chunks as it
+    // arrives. States are caller-allocated; NULL (and 0 state bytes) for a
+    // direction the library can't stream.
+    size_t enc_state_bytes;
+    int (*enc_init)(void* state);
+    int (*enc_update)(void* state, const unsigned char* pk, size_t pk_len);
+    int (*enc_final)(unsigned char* ct, unsigned char* ss, void* state);
+    size_t dec_state_bytes;
+    int (*dec_init)(void* state, const unsigned char* sk);
+    int (*dec_update)(void* state, const unsigned char* ct, size_t ct_len);
+    int (*dec_final)(unsigned char* ss, void* state);
+    const char* (*backend)(void); // NULL unless the library dispatches at runtime
+} kem_t;
+
+// Every entry the Makefile lists in KEM_LIST, defined in kem-registry.o
+// (kem.c compiled with KEM_LIST instead of an api.h)
+extern const kem_t* const kem_registry[];
+extern const size_t kem_registry_len;
+
+size_t kem_select(int names_len, char* const* names, const kem_t** selected);
+
+// Regenerates the secret key from coins and checks it decapsulates an
+// encapsulation to pk, so a wrong keypair_derand is caught (0 if it does)
+int kem_check_derand(const kem_t* kem, const unsigned char* coins, const unsigned char* pk);
+
+#endif
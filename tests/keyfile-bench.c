@@ -0,0 +1,268 @@
+#include "benchmark.h"
+#include "kem.h"
+#include "keyfile.h"
+#include <errno.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <time.h>
+#include <unistd.h>
+
+// Test configuration
+#define DEFAULT_OPERATIONS 20000
+#define DEFAULT_THREADS 1
+#define DEFAULT_ADVICES "random,willneed"
+#define MAX_ADVICES 4
+#define MAX_THREADS 256
+#define WORKLOAD_SEED 0x5EEDu
+
+static const char* advice_names[] = {
+    [KEYFILE_NORMAL] = "normal",
+    [KEYFILE_RANDOM] = "random",
+    [KEYFILE_SEQUENTIAL] = "sequential",
+    [KEYFILE_WILLNEED] = "willneed",
+};
+
+// Decapsulations prepared up front, so the timed run touches records only through lookups
+typedef struct {
+    const kem_t* kem;
+    size_t operations_len;
+    uint64_t* ids;
+    unsigned char* cts;
+    unsigned char* sss;
+} workload_t;
+
+typedef struct {
+    const workload_t* workload;
+    const keyfile_t* file;
+    int copy;
+    size_t first;
+    size_t last;
+    uint64_t* latencies;
+    int failed;
+} worker_t;
+
+/**
+ * @brief Picks operations_len uniformly random ids from the index and encapsulates to each.
+ */
+static int workload_init(workload_t* workload, const kem_t* kem, const keyfile_t* file, size_t operations_len) {
+    const size_t count = keyfile_header(file)->count;
+    workload->kem = kem;
+    workload->operations_len = operations_len;
+    workload->ids = malloc(operations_len * sizeof(uint64_t));
+    workload->cts = malloc(operations_len * kem->ciphertext_bytes);
+    workload->sss = malloc(operations_len * kem->shared_secret_bytes);
+    if (workload->ids == NULL || workload->cts == NULL || workload->sss == NULL)
+        return -1;
+
+    uint64_t state = WORKLOAD_SEED;
+    for (size_t i = 0; i < operations_len; i++) {
+        const keyfile_entry_t* entry = keyfile_entry(file, next_random(&state) % count);
+        workload->ids[i] = entry->id;
+        if (kem->enc(workload->cts + i * kem->ciphertext_bytes, workload->sss + i * kem->shared_secret_bytes,
+                keyfile_pk(file, entry->record))
+            != 0)
+            return -1;
+    }
+    return 0;
+}
+
+static void workload_free(workload_t* workload) {
+    free(workload->ids);
+    free(workload->cts);
+    free(workload->sss);
+}
+
+/**
+ * @brief Looks up and decapsulates operations [first, last), timing each from id to shared secret.
+ *
+ * The key is used in place in the mapping, or copied out with pread when copy
+ * is set. Compact keys are expanded into a per-worker buffer first.
+ */
+static void* run_worker(void* arg) {
+    worker_t* worker = arg;
+    const workload_t* workload = worker->workload;
+    const kem_t* kem = workload->kem;
+    const keyfile_header_t* header = keyfile_header(worker->file);
+
+    unsigned char* record = malloc(header->key_bytes + header->pk_bytes);
+    unsigned char* pk = malloc(kem->public_key_bytes);
+    unsigned char* sk = malloc(kem->secret_key_bytes);
+    unsigned char* ss = malloc(kem->shared_secret_bytes);
+
+    for (size_t i = worker->first; i < worker->last && !worker->failed; i++) {
+        const unsigned char* ct = workload->cts + i * kem->ciphertext_bytes;
+
+        uint64_t start = now_ns();
+        long found = keyfile_find(worker->file, workload->ids[i]);
+        if (found < 0) {
+            worker->failed = 1;
+            break;
+        }
+        const unsigned char* key = keyfile_key(worker->file, found);
+        if (worker->copy) {
+            worker->failed |= keyfile_read(worker->file, found, record) != 0;
+            key = record;
+        }
+        if (header->compact) {
+            kem->keypair_derand(pk, sk, key);
+            key = sk;
+        }
+        kem->dec(ss, ct, key);
+        worker->latencies[i] = now_ns() - start;
+
+        worker->failed |= memcmp(ss, workload->sss + i * kem->shared_secret_bytes, kem->shared_secret_bytes) != 0;
+    }
+
+    free(record);
+    free(pk);
+    free(sk);
+    free(ss);
+    return NULL;
+}
+
+/**
+ * @brief Random decapsulations against a key file built by keyfile-build, straight from the mapping.
+ *
+ * Each madvise hint is run once with keys used in place (mmap) and once with
+ * records copied out by pread, for comparison. Threads share one mapping, as
+ * workers of a KEM service would. With -d the file's cached pages are dropped
+ * before each run, so major faults show the cost of a cold store.
+ *
+ * Usage: ./keyfile-bench [-o operations] [-t threads] [-a random,willneed] [-d] file
+ */
+int main(int argc, char** argv) {
+    size_t operations_len = DEFAULT_OPERATIONS;
+    long threads_len = DEFAULT_THREADS;
+    const char* advices_arg = DEFAULT_ADVICES;
+    int cold = 0;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "o:t:a:d")) != -1) {
+        switch (opt) {
+        case 'o': operations_len = atol(optarg); break;
+        case 't': threads_len = atol(optarg); break;
+        case 'a': advices_arg = optarg; break;
+        case 'd': cold = 1; break;
+        default:
+            fprintf(stderr, "Usage: %s [-o operations] [-t threads] [-a random,willneed] [-d] file\n", argv[0]);
+            return -1;
+        }
+    }
+    if (optind + 1 != argc || operations_len == 0 || threads_len < 1 || threads_len > MAX_THREADS) {
+        fprintf(stderr, "Usage: %s [-o operations] [-t threads] [-a random,willneed] [-d] file\n", argv[0]);
+        return -1;
+    }
+    const char* path = argv[optind];
+
+    keyfile_advice_t advices[MAX_ADVICES];
+    size_t advices_len = 0;
+    char* list = strdup(advices_arg);
+    for (char* name = strtok(list, ","); name != NULL && advices_len < MAX_ADVICES; name = strtok(NULL, ",")) {
+        size_t a = 0;
+        while (a < sizeof(advice_names) / sizeof(*advice_names) && strcmp(name, advice_names[a]) != 0)
+            a++;
+        if (a == sizeof(advice_names) / sizeof(*advice_names)) {
+            fprintf(stderr, "Unknown advice %s (use normal, random, sequential or willneed)\n", name);
+            return -1;
+        }
+        advices[advices_len++] = a;
+    }
+    free(list);
+
+    // The file names its KEM, which has to be in this binary's registry
+    keyfile_t* file = keyfile_open(path, KEYFILE_NORMAL, 0);
+    if (file == NULL) {
+        printf("ERROR: Could not open %s: %s\n", path, strerror(errno));
+        return -1;
+    }
+    const kem_t* kem = NULL;
+    for (size_t i = 0; i < kem_registry_len; i++)
+        if (keyfile_matches(file, kem_registry[i]))
+            kem = kem_registry[i];
+    if (kem == NULL) {
+        printf("ERROR: %s was built for %.48s, which is not in the registry\n", path, keyfile_header(file)->kem);
+        return -1;
+    }
+
+    const keyfile_header_t header = *keyfile_header(file);
+    const char* form = header.compact ? "compact" : "expanded";
+    workload_t workload;
+    if (workload_init(&workload, kem, file, operations_len) != 0) {
+        printf("ERROR: Could not prepare ciphertexts for %s\n", kem->name);
+        return -1;
+    }
+    keyfile_close(file);
+
+    // Header and static data
+    printf("=====================================\n");
+    printf("PQC KEM Key File Benchmark\n");
+    printf("=====================================\n");
+    printf("KEM:         %s (%s records)\n", kem->name, form);
+    printf("Keys:        %" PRIu64 " (%" PRIu64 " B records)\n", header.count, header.record_bytes);
+    printf("Operations:  %zu decapsulations per run\n", operations_len);
+    printf("Threads:     %ld\n", threads_len);
+    printf("Cache:       %s\n", cold ? "dropped before each run" : "as left by the previous run");
+    printf("=====================================\n");
+    printf("%-6s %-10s %10s %10s %10s %10s %10s %10s\n", "Access", "Advice", "Ops/s", "p50 (us)", "p90 (us)", "p99 (us)",
+        "Major/op", "Minor/op");
+
+    uint64_t* latencies = malloc(operations_len * sizeof(uint64_t));
+    for (size_t a = 0; a < advices_len; a++) {
+        for (int copy = 0; copy <= 1; copy++) {
+            file = keyfile_open(path, advices[a], cold);
+            if (file == NULL) {
+                printf("ERROR: Could not open %s: %s\n", path, strerror(errno));
+                return -1;
+            }
+
+            pthread_t threads[MAX_THREADS];
+            worker_t workers[MAX_THREADS];
+            struct rusage before, after;
+            getrusage(RUSAGE_SELF, &before);
+            uint64_t start = now_ns();
+            for (long t = 0; t < threads_len; t++) {
+                workers[t] = (worker_t) { .workload = &workload, .file = file, .copy = copy,
+                    .first = operations_len * t / threads_len, .last = operations_len * (t + 1) / threads_len,
+                    .latencies = latencies };
+                pthread_create(&threads[t], NULL, run_worker, &workers[t]);
+            }
+            int failed = 0;
+            for (long t = 0; t < threads_len; t++) {
+                pthread_join(threads[t], NULL);
+                failed |= workers[t].failed;
+            }
+            uint64_t elapsed = now_ns() - start;
+            getrusage(RUSAGE_SELF, &after);
+            keyfile_close(file);
+
+            if (failed) {
+                printf("ERROR: Lookup failed or shared secrets don't match for %s!\n", kem->name);
+                return -1;
+            }
+
+            // remove_outliers with 0% only sorts
+            remove_outliers(latencies, operations_len, 0);
+            const char* access = copy ? "pread" : "mmap";
+            double ops_per_sec = operations_len / (elapsed / 1e9);
+            double major = (double)(after.ru_majflt - before.ru_majflt) / operations_len;
+            double minor = (double)(after.ru_minflt - before.ru_minflt) / operations_len;
+
+            printf("%-6s %-10s %10.0f %10.1f %10.1f %10.1f %10.3f %10.3f\n", access, advice_names[advices[a]], ops_per_sec,
+                latencies[operations_len / 2] / 1e3, latencies[(size_t)(operations_len * 0.90)] / 1e3,
+                latencies[(size_t)(operations_len * 0.99)] / 1e3, major, minor);
+
+            // CSV output to stderr for collection
+            fprintf(stderr, "%s,%s,%s,%s,%d,%ld,%.0f,%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%.4f,%.4f\n", kem->name, form,
+                access, advice_names[advices[a]], cold, threads_len, ops_per_sec, latencies[operations_len / 2],
+                latencies[(size_t)(operations_len * 0.90)], latencies[(size_t)(operations_len * 0.99)], major, minor);
+        }
+    }
+
+    free(latencies);
+    workload_free(&workload);
+    return 0;
+}
@@ -0,0 +1,118 @@
+#include "benchmark.h"
+#include "kem.h"
+#include "keyfile.h"
+#include <errno.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// Build configuration
+#define DEFAULT_KEYS 100000
+#define MAX_THREADS 256
+
+typedef struct {
+    keyfile_t* file;
+    size_t first;
+    size_t last;
+    int rc;
+} slice_t;
+
+static void* generate_slice(void* arg) {
+    slice_t* slice = arg;
+    slice->rc = keyfile_generate(slice->file, slice->first, slice->last);
+    return NULL;
+}
+
+/**
+ * @brief Writes a key file of freshly generated keypairs for one KEM, for keyfile-bench.
+ *
+ * Keygen is split over threads by record range; the index is sorted once all
+ * records are written.
+ *
+ * Usage: ./keyfile-build [-n keys] [-c] [-t threads] -o file name
+ */
+int main(int argc, char** argv) {
+    size_t keys_len = DEFAULT_KEYS;
+    int compact = 0;
+    long threads_len = sysconf(_SC_NPROCESSORS_ONLN);
+    const char* path = NULL;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "n:ct:o:")) != -1) {
+        switch (opt) {
+        case 'n': keys_len = atol(optarg); break;
+        case 'c': compact = 1; break;
+        case 't': threads_len = atol(optarg); break;
+        case 'o': path = optarg; break;
+        default:
+            fprintf(stderr, "Usage: %s [-n keys] [-c] [-t threads] -o file name\n", argv[0]);
+            return -1;
+        }
+    }
+    if (path == NULL || optind + 1 != argc || keys_len == 0 || threads_len < 1) {
+        fprintf(stderr, "Usage: %s [-n keys] [-c] [-t threads] -o file name\n", argv[0]);
+        return -1;
+    }
+    if (threads_len > MAX_THREADS)
+        threads_len = MAX_THREADS;
+    if ((size_t)threads_len > keys_len)
+        threads_len = keys_len;
+
+    const kem_t* selected[kem_registry_len];
+    if (kem_select(1, argv + optind, selected) == 0)
+        return -1;
+    const kem_t* kem = selected[0];
+    if (compact && kem->keypair_derand == NULL) {
+        printf("ERROR: %s has no keygen from coins, so no compact records\n", kem->name);
+        return -1;
+    }
+
+    keyfile_t* file = keyfile_create(path, kem, compact, keys_len);
+    if (file == NULL) {
+        printf("ERROR: Could not create %s: %s\n", path, strerror(errno));
+        return -1;
+    }
+    const keyfile_header_t* header = keyfile_header(file);
+
+    printf("=====================================\n");
+    printf("PQC KEM Key File Builder\n");
+    printf("=====================================\n");
+    printf("KEM:         %s (%s records)\n", kem->name, compact ? "compact" : "expanded");
+    printf("Keys:        %zu\n", keys_len);
+    printf("Record:      %" PRIu64 " B (%" PRIu64 " B key, %" PRIu64 " B public key)\n", header->record_bytes,
+        header->key_bytes, header->pk_bytes);
+    printf("File:        %.1f MiB\n", (header->index_offset + keys_len * sizeof(keyfile_entry_t)) / 1048576.0);
+    printf("Threads:     %ld\n", threads_len);
+    printf("=====================================\n");
+
+    uint64_t start = now_ns();
+    pthread_t threads[MAX_THREADS];
+    slice_t slices[MAX_THREADS];
+    for (long t = 0; t < threads_len; t++) {
+        slices[t] = (slice_t) { .file = file, .first = keys_len * t / threads_len, .last = keys_len * (t + 1) / threads_len };
+        pthread_create(&threads[t], NULL, generate_slice, &slices[t]);
+    }
+    int rc = 0;
+    for (long t = 0; t < threads_len; t++) {
+        pthread_join(threads[t], NULL);
+        rc |= slices[t].rc;
+    }
+    uint64_t generated = now_ns();
+
+    if (rc != 0 || keyfile_finish(file) != 0) {
+        printf("ERROR: Could not generate %s\n", path);
+        keyfile_close(file);
+        unlink(path);
+        return -1;
+    }
+    uint64_t finished = now_ns();
+    keyfile_close(file);
+
+    printf("Keygen:      %.2f s (%.0f keys/s)\n", (generated - start) / 1e9, keys_len / ((generated - start) / 1e9));
+    printf("Index+sync:  %.2f s\n", (finished - generated) / 1e9);
+    return 0;
+}
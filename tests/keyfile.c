@@ -0,0 +1,232 @@
+#define _GNU_SOURCE
+#include "keyfile.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define ROUND_UP(x, a) (((x) + (a)-1) / (a) * (a))
+
+struct keyfile {
+    const kem_t* kem; // only set when created
+    int fd;
+    unsigned char* base;
+    size_t size;
+    const keyfile_header_t* header;
+    keyfile_entry_t* index;
+};
+
+static unsigned char* record_at(const keyfile_t* file, size_t record) {
+    return file->base + file->header->records_offset + record * file->header->record_bytes;
+}
+
+static int compare_entries(const void* a, const void* b) {
+    uint64_t x = ((const keyfile_entry_t*)a)->id, y = ((const keyfile_entry_t*)b)->id;
+    return (x > y) - (x < y);
+}
+
+static void keyfile_unmap(keyfile_t* file) {
+    if (file->base != NULL && file->base != MAP_FAILED)
+        munmap(file->base, file->size);
+    if (file->fd >= 0)
+        close(file->fd);
+    free(file);
+}
+
+keyfile_t* keyfile_create(const char* path, const kem_t* kem, int compact, size_t count) {
+    if ((compact && kem->keypair_derand == NULL) || strlen(kem->name) >= sizeof(((keyfile_header_t*)0)->kem) || count == 0) {
+        errno = EINVAL;
+        return NULL;
+    }
+
+    keyfile_header_t header = { .version = KEYFILE_VERSION, .compact = compact, .count = count };
+    memcpy(header.magic, KEYFILE_MAGIC, sizeof(header.magic));
+    strcpy(header.kem, kem->name);
+    header.pk_bytes = kem->public_key_bytes;
+    header.key_bytes = compact ? kem->keypair_coin_bytes : kem->secret_key_bytes;
+    header.record_bytes = ROUND_UP(header.key_bytes + header.pk_bytes, KEYFILE_ALIGN);
+    header.records_offset = KEYFILE_PAGE;
+    header.index_offset = ROUND_UP(header.records_offset + count * header.record_bytes, KEYFILE_PAGE);
+
+    keyfile_t* file = calloc(1, sizeof(keyfile_t));
+    if (file == NULL)
+        return NULL;
+    file->kem = kem;
+    file->size = header.index_offset + count * sizeof(keyfile_entry_t);
+
+    // Secret keys, so only the owner may read them
+    file->fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0600);
+    if (file->fd < 0 || (errno = posix_fallocate(file->fd, 0, file->size)) != 0) {
+        keyfile_unmap(file);
+        return NULL;
+    }
+    file->base = mmap(NULL, file->size, PROT_READ | PROT_WRITE, MAP_SHARED, file->fd, 0);
+    if (file->base == MAP_FAILED) {
+        keyfile_unmap(file);
+        return NULL;
+    }
+
+    memcpy(file->base, &header, sizeof(header));
+    file->header = (const keyfile_header_t*)file->base;
+    file->index = (keyfile_entry_t*)(file->base + header.index_offset);
+    return file;
+}
+
+int keyfile_generate(keyfile_t* file, size_t first, size_t last) {
+    const kem_t* kem = file->kem;
+    const keyfile_header_t* header = file->header;
+    unsigned char* sk = header->compact ? malloc(kem->secret_key_bytes) : NULL;
+    if (header->compact && sk == NULL)
+        return -1;
+
+    int rc = 0;
+    for (size_t record = first; record < last && rc == 0; record++) {
+        unsigned char* key = record_at(file, record);
+        unsigned char* pk = key + header->key_bytes;
+        if (header->compact) {
+            // Coins are secret like the key they stand for, so they come from the OS
+            rc = getentropy(key, header->key_bytes) != 0 || kem->keypair_derand(pk, sk, key) != 0 ? -1 : 0;
+            // The file keeps only the coins, so check once per range that they expand to a working key
+            if (rc == 0 && record == first)
+                rc = kem_check_derand(kem, key, pk);
+        } else {
+            rc = kem->keypair(pk, key) != 0 ? -1 : 0;
+        }
+    }
+
+    free(sk);
+    return rc;
+}
+
+int keyfile_finish(keyfile_t* file) {
+    const size_t count = file->header->count;
+    keyfile_entry_t* index = file->index;
+
+    for (size_t i = 0; i < count; i++) {
+        index[i].record = i;
+        if (getentropy(&index[i].id, sizeof(index[i].id)) != 0)
+            return -1;
+    }
+
+    // Ids must be unique for keyfile_find; draw again until they are (rarely needed)
+    for (;;) {
+        qsort(index, count, sizeof(keyfile_entry_t), compare_entries);
+        int duplicates = 0;
+        for (size_t i = 1; i < count; i++) {
+            if (index[i].id == index[i - 1].id) {
+                if (getentropy(&index[i].id, sizeof(index[i].id)) != 0)
+                    return -1;
+                duplicates = 1;
+            }
+        }
+        if (!duplicates)
+            break;
+    }
+
+    return msync(file->base, file->size, MS_SYNC);
+}
+
+keyfile_t* keyfile_open(const char* path, keyfile_advice_t advice, int cold) {
+    static const int advices[] = {
+        [KEYFILE_NORMAL] = MADV_NORMAL,
+        [KEYFILE_RANDOM] = MADV_RANDOM,
+        [KEYFILE_SEQUENTIAL] = MADV_SEQUENTIAL,
+        [KEYFILE_WILLNEED] = MADV_WILLNEED,
+    };
+
+    keyfile_t* file = calloc(1, sizeof(keyfile_t));
+    if (file == NULL)
+        return NULL;
+
+    struct stat st;
+    file->fd = open(path, O_RDONLY);
+    if (file->fd < 0 || fstat(file->fd, &st) != 0) {
+        keyfile_unmap(file);
+        return NULL;
+    }
+    if ((size_t)st.st_size < KEYFILE_PAGE) {
+        keyfile_unmap(file);
+        errno = EINVAL;
+        return NULL;
+    }
+    file->size = st.st_size;
+
+    // Only drops clean pages that nothing else has mapped
+    if (cold)
+        posix_fadvise(file->fd, 0, 0, POSIX_FADV_DONTNEED);
+
+    file->base = mmap(NULL, file->size, PROT_READ, MAP_SHARED, file->fd, 0);
+    if (file->base == MAP_FAILED) {
+        keyfile_unmap(file);
+        return NULL;
+    }
+
+    const keyfile_header_t* header = (const keyfile_header_t*)file->base;
+    file->header = header;
+    if (memcmp(header->magic, KEYFILE_MAGIC, sizeof(header->magic)) != 0 || header->version != KEYFILE_VERSION
+        || header->record_bytes % KEYFILE_ALIGN != 0 || header->record_bytes < header->key_bytes + header->pk_bytes
+        || header->records_offset % KEYFILE_PAGE != 0 || header->index_offset % KEYFILE_PAGE != 0
+        || header->index_offset < header->records_offset + header->count * header->record_bytes
+        || file->size < header->index_offset + header->count * sizeof(keyfile_entry_t)) {
+        keyfile_unmap(file);
+        errno = EINVAL;
+        return NULL;
+    }
+    file->index = (keyfile_entry_t*)(file->base + header->index_offset);
+
+    // Every lookup goes through the index, so it should stay resident
+    madvise(file->base + header->records_offset, header->index_offset - header->records_offset, advices[advice]);
+    madvise(file->base + header->index_offset, file->size - header->index_offset, MADV_WILLNEED);
+    return file;
+}
+
+int keyfile_matches(const keyfile_t* file, const kem_t* kem) {
+    const keyfile_header_t* header = file->header;
+    size_t key_bytes = header->compact ? kem->keypair_coin_bytes : kem->secret_key_bytes;
+    return strncmp(header->kem, kem->name, sizeof(header->kem)) == 0 && header->pk_bytes == kem->public_key_bytes
+        && header->key_bytes == key_bytes && (!header->compact || kem->keypair_derand != NULL);
+}
+
+const keyfile_header_t* keyfile_header(const keyfile_t* file) {
+    return file->header;
+}
+
+const keyfile_entry_t* keyfile_entry(const keyfile_t* file, size_t i) {
+    return &file->index[i];
+}
+
+long keyfile_find(const keyfile_t* file, uint64_t id) {
+    size_t low = 0, high = file->header->count;
+    while (low < high) {
+        size_t mid = (low + high) / 2;
+        if (file->index[mid].id < id)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    if (low == file->header->count || file->index[low].id != id)
+        return -1;
+    return (long)file->index[low].record;
+}
+
+const unsigned char* keyfile_key(const keyfile_t* file, size_t record) {
+    return record_at(file, record);
+}
+
+const unsigned char* keyfile_pk(const keyfile_t* file, size_t record) {
+    return record_at(file, record) + file->header->key_bytes;
+}
+
+int keyfile_read(const keyfile_t* file, size_t record, unsigned char* buf) {
+    const keyfile_header_t* header = file->header;
+    size_t len = header->key_bytes + header->pk_bytes;
+    off_t offset = header->records_offset + record * header->record_bytes;
+    return pread(file->fd, buf, len, offset) == (ssize_t)len ? 0 : -1;
+}
+
+void keyfile_close(keyfile_t* file) {
+    keyfile_unmap(file);
+}
@@ -0,0 +1,115 @@
+#ifndef _KEYFILE_H_
+#define _KEYFILE_H_
+#include "kem.h"
+#include <stddef.h>
+#include <stdint.h>
+
+// On-disk store of many keypairs for one KEM, mapped into memory so workers
+// decapsulate straight from the page cache without copying keys out.
+//
+// Layout (native byte order):
+//   header   one page, keyfile_header_t
+//   records  count fixed-size records of key || pk, each padded to a multiple
+//            of KEYFILE_ALIGN bytes, starting on a page boundary
+//   index    count keyfile_entry_t sorted by id, starting on a page boundary
+//
+// The key is either the library's secret key (expanded) or its keygen coins
+// (compact, see kem_t.keypair_derand), which have to be expanded before use.
+#define KEYFILE_MAGIC "PQCKEYF1"
+#define KEYFILE_VERSION 1
+#define KEYFILE_ALIGN 64
+#define KEYFILE_PAGE 4096
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t compact;
+    char kem[48]; // registry name, NUL-terminated
+    uint64_t count;
+    uint64_t pk_bytes;
+    uint64_t key_bytes;
+    uint64_t record_bytes;
+    uint64_t records_offset;
+    uint64_t index_offset;
+} keyfile_header_t;
+
+typedef struct {
+    uint64_t id;
+    uint64_t record;
+} keyfile_entry_t;
+
+// madvise hint for the records; the index is always hinted WILLNEED
+typedef enum {
+    KEYFILE_NORMAL,
+    KEYFILE_RANDOM,
+    KEYFILE_SEQUENTIAL,
+    KEYFILE_WILLNEED,
+} keyfile_advice_t;
+
+typedef struct keyfile keyfile_t;
+
+/**
+ * @brief Creates (or truncates) path with room for count records and maps it for writing.
+ *
+ * @param compact Store keygen coins instead of secret keys; the KEM must have keypair_derand.
+ * @return The file, or NULL on error (errno is set).
+ */
+keyfile_t* keyfile_create(const char* path, const kem_t* kem, int compact, size_t count);
+
+/**
+ * @brief Generates the keypairs of records [first, last). Disjoint ranges may be generated concurrently.
+ *
+ * The first compact record of the range is checked with kem_check_derand.
+ *
+ * @return 0 on success, -1 if keygen, the entropy source or that check failed.
+ */
+int keyfile_generate(keyfile_t* file, size_t first, size_t last);
+
+/**
+ * @brief Gives every record a random 64-bit id, writes the sorted index and flushes the file.
+ *
+ * @return 0 on success, -1 on error.
+ */
+int keyfile_finish(keyfile_t* file);
+
+/**
+ * @brief Maps an existing file read-only and applies advice to its records.
+ *
+ * @param cold Ask the kernel to drop the file's cached pages first, so the run starts from disk.
+ * @return The file, or NULL if it cannot be mapped or is not a key file (errno is set).
+ */
+keyfile_t* keyfile_open(const char* path, keyfile_advice_t advice, int cold);
+
+/**
+ * @brief Checks that the file was built for kem, with matching key sizes.
+ */
+int keyfile_matches(const keyfile_t* file, const kem_t* kem);
+
+const keyfile_header_t* keyfile_header(const keyfile_t* file);
+
+/**
+ * @brief Index entry i (in id order), e.g. to pick ids for a workload.
+ */
+const keyfile_entry_t* keyfile_entry(const keyfile_t* file, size_t i);
+
+/**
+ * @brief Binary search of the index.
+ *
+ * @return Record number of id, or -1 if the file has no such id.
+ */
+long keyfile_find(const keyfile_t* file, uint64_t id);
+
+// Pointers into the mapping, valid until keyfile_close
+const unsigned char* keyfile_key(const keyfile_t* file, size_t record);
+const unsigned char* keyfile_pk(const keyfile_t* file, size_t record);
+
+/**
+ * @brief Copies a record (key || pk) into buf with pread, for comparison with the mapping.
+ *
+ * @return 0 on success, -1 on error.
+ */
+int keyfile_read(const keyfile_t* file, size_t record, unsigned char* buf);
+
+void keyfile_close(keyfile_t* file);
+
+#endif
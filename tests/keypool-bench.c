@@ -0,0 +1,213 @@
+#include "benchmark.h"
+#include "kem.h"
+#include "keypool.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// Test configuration
+#define DEFAULT_DURATION_MS 2000
+#define DEFAULT_LOAD 0.5
+#define DEFAULT_CAPACITY 64
+#define DEFAULT_REFILLS "none,0.5,1,2,max"
+#define CALIBRATION_ITERATIONS 200
+#define MAX_REFILLS 16
+#define REFILL_NONE -1.0
+#define REFILL_MAX 0.0
+
+typedef struct {
+    const kem_t* kem;
+    unsigned char* pk;
+    unsigned char* sk;
+    unsigned char* ct;
+    unsigned char* ss;
+    unsigned char* ss_check;
+} kem_state_t;
+
+// Sleeps (never spins) so the idle time is left to the refill threads
+static void sleep_until(uint64_t deadline) {
+    struct timespec t = { .tv_sec = deadline / NS_PER_SEC, .tv_nsec = deadline % NS_PER_SEC };
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &t, NULL) != 0)
+        ;
+}
+
+/**
+ * @brief Closed-loop median of keygen, or of keygen + enc + dec when full is set.
+ */
+static uint64_t calibrate(kem_state_t* state, int full) {
+    uint64_t timings[CALIBRATION_ITERATIONS];
+    for (size_t i = 0; i < CALIBRATION_ITERATIONS; i++) {
+        uint64_t start = now_ns();
+        state->kem->keypair(state->pk, state->sk);
+        if (full) {
+            state->kem->enc(state->ct, state->ss, state->pk);
+            state->kem->dec(state->ss_check, state->ct, state->sk);
+        }
+        timings[i] = now_ns() - start;
+    }
+    remove_outliers(timings, CALIBRATION_ITERATIONS, 0);
+    return timings[CALIBRATION_ITERATIONS / 2];
+}
+
+/**
+ * @brief Runs paced handshakes, popping keypairs from pool (or generating them when pool is NULL).
+ *
+ * @return Number of handshakes whose keypair was generated inline, or -1 if a shared secret mismatched.
+ */
+static long run_handshakes(kem_state_t* state, keypool_t* pool, double rate, uint64_t* latencies, size_t handshakes_len) {
+    const kem_t* kem = state->kem;
+    uint64_t interval = (uint64_t)(NS_PER_SEC / rate);
+    uint64_t next = now_ns();
+    long misses = 0;
+
+    for (size_t i = 0; i < handshakes_len; i++) {
+        next += interval;
+        sleep_until(next);
+
+        // Critical path: obtain the ephemeral keypair, then the exchange itself
+        uint64_t start = now_ns();
+        if (pool != NULL)
+            misses += keypool_pop(pool, state->pk, state->sk);
+        else
+            kem->keypair(state->pk, state->sk);
+        kem->enc(state->ct, state->ss, state->pk);
+        kem->dec(state->ss_check, state->ct, state->sk);
+        latencies[i] = now_ns() - start;
+
+        if (memcmp(state->ss, state->ss_check, kem->shared_secret_bytes) != 0)
+            return -1;
+    }
+    return pool != NULL ? misses : (long)handshakes_len;
+}
+
+/**
+ * @brief Handshake critical-path latency with and without a pre-generated keypair pool.
+ *
+ * One thread runs handshakes (keygen or pop, enc, dec) at a fixed rate that
+ * keeps it load busy without a pool, and sleeps in between. A refill thread
+ * at SCHED_IDLE priority refills the pool in that idle time, at a multiple of
+ * the handshake rate ("max" for no limit). The pool starts full, so a refill
+ * rate below the handshake rate shows up as pool misses once it drains.
+ *
+ * Usage: ./keypool-bench [-l load] [-r none,0.5,1,max] [-s capacity] [-d ms] [name ...]
+ */
+int main(int argc, char** argv) {
+    double load = DEFAULT_LOAD;
+    const char* refills_arg = DEFAULT_REFILLS;
+    size_t capacity = DEFAULT_CAPACITY;
+    long duration_ms = DEFAULT_DURATION_MS;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "l:r:s:d:")) != -1) {
+        switch (opt) {
+        case 'l': load = atof(optarg); break;
+        case 'r': refills_arg = optarg; break;
+        case 's': capacity = atol(optarg); break;
+        case 'd': duration_ms = atol(optarg); break;
+        default:
+            fprintf(stderr, "Usage: %s [-l load] [-r none,0.5,1,max] [-s capacity] [-d ms] [name ...]\n", argv[0]);
+            return -1;
+        }
+    }
+    if (load <= 0 || load >= 1 || capacity == 0) {
+        fprintf(stderr, "Load must be between 0 and 1, capacity positive\n");
+        return -1;
+    }
+
+    double refills[MAX_REFILLS];
+    size_t refills_len = 0;
+    char* list = strdup(refills_arg);
+    for (char* refill = strtok(list, ","); refill != NULL && refills_len < MAX_REFILLS; refill = strtok(NULL, ","))
+        refills[refills_len++] = strcmp(refill, "none") == 0 ? REFILL_NONE : strcmp(refill, "max") == 0 ? REFILL_MAX : atof(refill);
+    free(list);
+
+    // Select KEMs by name, or all of them
+    const kem_t* selected[kem_registry_len];
+    size_t selected_len = kem_select(argc - optind, argv + optind, selected);
+    if (selected_len == 0)
+        return -1;
+
+    // Header and static data
+    printf("=====================================\n");
+    printf("PQC KEM Keypair Pool Benchmark\n");
+    printf("=====================================\n");
+    printf("Load:        %7.2f of one core without a pool\n", load);
+    printf("Capacity:    %7zu keypairs (starts full)\n", capacity);
+    printf("Duration:    %7ld ms per refill rate\n", duration_ms);
+    printf("=====================================\n");
+
+    for (size_t i = 0; i < selected_len; i++) {
+        const kem_t* kem = selected[i];
+        kem_state_t state = {
+            .kem = kem,
+            .pk = malloc(kem->public_key_bytes),
+            .sk = malloc(kem->secret_key_bytes),
+            .ct = malloc(kem->ciphertext_bytes),
+            .ss = malloc(kem->shared_secret_bytes),
+            .ss_check = malloc(kem->shared_secret_bytes),
+        };
+
+        uint64_t keygen_median = calibrate(&state, 0);
+        uint64_t handshake_median = calibrate(&state, 1);
+        double rate = load * NS_PER_SEC / handshake_median;
+        size_t handshakes_len = (size_t)(rate * duration_ms / MS_PER_SEC) + 1;
+        uint64_t* latencies = malloc(handshakes_len * sizeof(uint64_t));
+
+        printf("\n%s (keygen %" PRIu64 " ns, handshake %" PRIu64 " ns, %.0f handshakes/s)\n",
+            kem->name, keygen_median, handshake_median, rate);
+        printf("%-10s %10s %10s %10s %10s %8s\n", "Refill", "p50 (us)", "p90 (us)", "p99 (us)", "max (us)", "Misses");
+
+        for (size_t r = 0; r < refills_len; r++) {
+            keypool_t* pool = NULL;
+            if (refills[r] != REFILL_NONE) {
+                pool = keypool_new(kem, capacity, 1, refills[r] * rate);
+                if (pool == NULL) {
+                    printf("ERROR: Could not create a keypair pool for %s\n", kem->name);
+                    return -1;
+                }
+                keypool_fill(pool);
+            }
+
+            long misses = run_handshakes(&state, pool, rate, latencies, handshakes_len);
+            if (pool != NULL)
+                keypool_free(pool);
+            if (misses < 0) {
+                printf("ERROR: Shared secrets don't match for %s!\n", kem->name);
+                return -1;
+            }
+
+            // remove_outliers with 0% only sorts
+            remove_outliers(latencies, handshakes_len, 0);
+            char label[16];
+            if (refills[r] == REFILL_NONE)
+                snprintf(label, sizeof(label), "none");
+            else if (refills[r] == REFILL_MAX)
+                snprintf(label, sizeof(label), "max");
+            else
+                snprintf(label, sizeof(label), "%.2fx", refills[r]);
+
+            printf("%-10s %10.1f %10.1f %10.1f %10.1f %7.1f%%\n", label,
+                latencies[handshakes_len / 2] / 1e3, latencies[(size_t)(handshakes_len * 0.90)] / 1e3,
+                latencies[(size_t)(handshakes_len * 0.99)] / 1e3, latencies[handshakes_len - 1] / 1e3,
+                100.0 * misses / handshakes_len);
+
+            // CSV output to stderr for collection
+            fprintf(stderr, "%s,%s,%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%.4f\n",
+                kem->name, label, latencies[handshakes_len / 2], latencies[(size_t)(handshakes_len * 0.90)],
+                latencies[(size_t)(handshakes_len * 0.99)], latencies[handshakes_len - 1],
+                (double)misses / handshakes_len);
+        }
+
+        free(latencies);
+        free(state.pk);
+        free(state.sk);
+        free(state.ct);
+        free(state.ss);
+        free(state.ss_check);
+    }
+
+    return 0;
+}
@@ -0,0 +1,215 @@
+#define _GNU_SOURCE
+#include "keypool.h"
+#include "benchmark.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define CACHE_LINE 64
+#define FULL_BACKOFF_NS (NS_PER_SEC / MS_PER_SEC)
+#define STOP_CHECK_NS (10 * NS_PER_SEC / MS_PER_SEC)
+
+// Ring slot: its sequence number says whose turn it is (Vyukov's bounded MPMC queue)
+typedef struct {
+    _Alignas(CACHE_LINE) atomic_size_t sequence;
+} slot_t;
+
+struct keypool {
+    const kem_t* kem;
+    size_t mask;
+    size_t keypair_bytes;
+    slot_t* slots;
+    unsigned char* keypairs; // pk || sk per slot
+
+    _Alignas(CACHE_LINE) atomic_size_t push_pos;
+    _Alignas(CACHE_LINE) atomic_size_t pop_pos;
+    _Alignas(CACHE_LINE) atomic_int stop;
+
+    uint64_t refill_interval; // ns between keypairs per refill thread, 0 for no limit
+    size_t threads_len;
+    pthread_t* threads;
+};
+
+// Sleeps until deadline in short steps, so a stopping pool is not kept waiting
+static void sleep_until(keypool_t* pool, uint64_t deadline) {
+    for (uint64_t now = now_ns(); now < deadline && !atomic_load_explicit(&pool->stop, memory_order_relaxed); now = now_ns()) {
+        uint64_t until = deadline - now > STOP_CHECK_NS ? now + STOP_CHECK_NS : deadline;
+        struct timespec t = { .tv_sec = until / NS_PER_SEC, .tv_nsec = until % NS_PER_SEC };
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &t, NULL);
+    }
+}
+
+/**
+ * @brief Copies a keypair into the next free slot.
+ *
+ * @return 0 on success, -1 if the ring is full.
+ */
+static int try_push(keypool_t* pool, const unsigned char* pk, const unsigned char* sk) {
+    size_t pos = atomic_load_explicit(&pool->push_pos, memory_order_relaxed);
+    slot_t* slot;
+    for (;;) {
+        slot = &pool->slots[pos & pool->mask];
+        intptr_t diff = (intptr_t)atomic_load_explicit(&slot->sequence, memory_order_acquire) - (intptr_t)pos;
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&pool->push_pos, &pos, pos + 1, memory_order_relaxed, memory_order_relaxed))
+                break;
+        } else if (diff < 0) {
+            return -1;
+        } else {
+            pos = atomic_load_explicit(&pool->push_pos, memory_order_relaxed);
+        }
+    }
+
+    unsigned char* keypair = pool->keypairs + (pos & pool->mask) * pool->keypair_bytes;
+    memcpy(keypair, pk, pool->kem->public_key_bytes);
+    memcpy(keypair + pool->kem->public_key_bytes, sk, pool->kem->secret_key_bytes);
+    atomic_store_explicit(&slot->sequence, pos + 1, memory_order_release);
+    return 0;
+}
+
+/**
+ * @brief Whether the next push would find a free slot. Only a hint while other threads push.
+ */
+static int has_room(keypool_t* pool) {
+    size_t pos = atomic_load_explicit(&pool->push_pos, memory_order_relaxed);
+    size_t sequence = atomic_load_explicit(&pool->slots[pos & pool->mask].sequence, memory_order_acquire);
+    return (intptr_t)sequence - (intptr_t)pos >= 0;
+}
+
+/**
+ * @brief Copies the oldest keypair out of the ring and wipes the secret key left in the slot.
+ *
+ * @return 0 on success, -1 if the ring is empty.
+ */
+static int try_pop(keypool_t* pool, unsigned char* pk, unsigned char* sk) {
+    size_t pos = atomic_load_explicit(&pool->pop_pos, memory_order_relaxed);
+    slot_t* slot;
+    for (;;) {
+        slot = &pool->slots[pos & pool->mask];
+        intptr_t diff = (intptr_t)atomic_load_explicit(&slot->sequence, memory_order_acquire) - (intptr_t)(pos + 1);
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&pool->pop_pos, &pos, pos + 1, memory_order_relaxed, memory_order_relaxed))
+                break;
+        } else if (diff < 0) {
+            return -1;
+        } else {
+            pos = atomic_load_explicit(&pool->pop_pos, memory_order_relaxed);
+        }
+    }
+
+    unsigned char* keypair = pool->keypairs + (pos & pool->mask) * pool->keypair_bytes;
+    memcpy(pk, keypair, pool->kem->public_key_bytes);
+    memcpy(sk, keypair + pool->kem->public_key_bytes, pool->kem->secret_key_bytes);
+    explicit_bzero(keypair + pool->kem->public_key_bytes, pool->kem->secret_key_bytes);
+    atomic_store_explicit(&slot->sequence, pos + pool->mask + 1, memory_order_release);
+    return 0;
+}
+
+/**
+ * @brief Refill thread: generates keypairs at the pool's rate and waits while the ring is full.
+ *
+ * SCHED_IDLE makes it run only on otherwise idle CPU time, so refilling never
+ * delays a handshake thread. The KEM has no batch keygen in this tree, so
+ * keypairs are generated one at a time.
+ */
+static void* refill_main(void* raw_pool) {
+    keypool_t* pool = raw_pool;
+    struct sched_param param = { 0 };
+    pthread_setschedparam(pthread_self(), SCHED_IDLE, &param);
+
+    unsigned char* pk = malloc(pool->kem->public_key_bytes);
+    unsigned char* sk = malloc(pool->kem->secret_key_bytes);
+    uint64_t next = now_ns();
+
+    while (!atomic_load_explicit(&pool->stop, memory_order_relaxed)) {
+        if (pool->refill_interval != 0) {
+            // Do not make up for time spent waiting on a full ring with a burst
+            uint64_t now = now_ns();
+            next = next + pool->refill_interval < now ? now : next + pool->refill_interval;
+            sleep_until(pool, next);
+        }
+
+        pool->kem->keypair(pk, sk);
+        while (try_push(pool, pk, sk) != 0 && !atomic_load_explicit(&pool->stop, memory_order_relaxed))
+            sleep_until(pool, now_ns() + FULL_BACKOFF_NS);
+    }
+
+    explicit_bzero(sk, pool->kem->secret_key_bytes);
+    free(pk);
+    free(sk);
+    return NULL;
+}
+
+keypool_t* keypool_new(const kem_t* kem, size_t capacity, size_t refill_threads, double refill_rate) {
+    size_t slots_len = 1;
+    while (slots_len < capacity)
+        slots_len *= 2;
+
+    keypool_t* pool = aligned_alloc(CACHE_LINE, sizeof(keypool_t));
+    if (pool == NULL)
+        return NULL;
+    memset(pool, 0, sizeof(*pool));
+    pool->kem = kem;
+    pool->mask = slots_len - 1;
+    pool->keypair_bytes = kem->public_key_bytes + kem->secret_key_bytes;
+    pool->slots = aligned_alloc(CACHE_LINE, slots_len * sizeof(slot_t));
+    pool->keypairs = malloc(slots_len * pool->keypair_bytes);
+    pool->refill_interval = refill_rate > 0 ? (uint64_t)(refill_threads * (double)NS_PER_SEC / refill_rate) : 0;
+    pool->threads = malloc(refill_threads * sizeof(pthread_t));
+    if (pool->slots == NULL || pool->keypairs == NULL || pool->threads == NULL) {
+        keypool_free(pool);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < slots_len; i++)
+        atomic_init(&pool->slots[i].sequence, i);
+    atomic_init(&pool->push_pos, 0);
+    atomic_init(&pool->pop_pos, 0);
+    atomic_init(&pool->stop, 0);
+
+    for (; pool->threads_len < refill_threads; pool->threads_len++) {
+        if (pthread_create(&pool->threads[pool->threads_len], NULL, refill_main, pool) != 0) {
+            keypool_free(pool);
+            return NULL;
+        }
+    }
+    return pool;
+}
+
+void keypool_fill(keypool_t* pool) {
+    unsigned char* pk = malloc(pool->kem->public_key_bytes);
+    unsigned char* sk = malloc(pool->kem->secret_key_bytes);
+    // A keypair is only lost if a refill thread takes the last slot during keygen
+    while (has_room(pool)) {
+        pool->kem->keypair(pk, sk);
+        if (try_push(pool, pk, sk) != 0)
+            break;
+    }
+    explicit_bzero(sk, pool->kem->secret_key_bytes);
+    free(pk);
+    free(sk);
+}
+
+int keypool_pop(keypool_t* pool, unsigned char* pk, unsigned char* sk) {
+    if (try_pop(pool, pk, sk) == 0)
+        return 0;
+    pool->kem->keypair(pk, sk);
+    return 1;
+}
+
+void keypool_free(keypool_t* pool) {
+    atomic_store(&pool->stop, 1);
+    for (size_t i = 0; i < pool->threads_len; i++)
+        pthread_join(pool->threads[i], NULL);
+    free(pool->threads);
+    free(pool->slots);
+    // Secret keys still in the ring, popped slots are already wiped
+    if (pool->keypairs != NULL)
+        explicit_bzero(pool->keypairs, (pool->mask + 1) * pool->keypair_bytes);
+    free(pool->keypairs);
+    free(pool);
+}
@@ -0,0 +1,41 @@
+#ifndef _KEYPOOL_H_
+#define _KEYPOOL_H_
+#include "kem.h"
+#include <stddef.h>
+
+// Pool of pre-generated ephemeral keypairs for one KEM. Background threads at
+// SCHED_IDLE priority keep a lock-free ring topped up, so a handshake pops a
+// ready keypair instead of running keygen on its critical path.
+typedef struct keypool keypool_t;
+
+/**
+ * @brief Creates a pool and starts its refill threads. The ring starts empty.
+ *
+ * @param capacity Keypairs held at most, rounded up to a power of two.
+ * @param refill_threads Background threads generating keypairs.
+ * @param refill_rate Keypairs per second over all refill threads, 0 for as fast as they can.
+ * @return The pool, or NULL if allocation or thread creation fails.
+ */
+keypool_t* keypool_new(const kem_t* kem, size_t capacity, size_t refill_threads, double refill_rate);
+
+/**
+ * @brief Fills the ring from the calling thread, e.g. before a server starts accepting.
+ */
+void keypool_fill(keypool_t* pool);
+
+/**
+ * @brief Takes a keypair from the ring, or generates one inline if it is empty.
+ *
+ * The slot's copy of the secret key is wiped as it leaves the ring.
+ * Safe to call from any number of threads.
+ *
+ * @return 0 if the keypair came from the ring, 1 if it was generated inline.
+ */
+int keypool_pop(keypool_t* pool, unsigned char* pk, unsigned char* sk);
+
+/**
+ * @brief Stops the refill threads, wipes the keypairs left in the ring and frees the pool.
+ */
+void keypool_free(keypool_t* pool);
+
+#endif
@@ -0,0 +1,219 @@
+#include "benchmark.h"
+#include "kem.h"
+#include "keystore.h"
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// Test configuration
+#define DEFAULT_KEYS 10000
+#define DEFAULT_OPERATIONS 20000
+#define DEFAULT_CACHES "0,0.01,0.1"
+#define DEFAULT_ZIPF 1.0
+#define MAX_CACHES 16
+#define WORKLOAD_SEED 0x5EEDu
+
+// Which key each operation uses: Zipf-distributed ranks over a shuffled order of ids
+typedef struct {
+    size_t keys_len;
+    double* cdf;
+    size_t* id_of_rank;
+    uint64_t state; // next_random, seeded per store so every store sees the same sequence of keys
+} workload_t;
+
+static void workload_init(workload_t* workload, size_t keys_len, double zipf) {
+    workload->keys_len = keys_len;
+    workload->cdf = malloc(keys_len * sizeof(double));
+    workload->id_of_rank = malloc(keys_len * sizeof(size_t));
+    workload->state = WORKLOAD_SEED;
+
+    double sum = 0;
+    for (size_t rank = 0; rank < keys_len; rank++) {
+        sum += 1.0 / pow((double)(rank + 1), zipf);
+        workload->cdf[rank] = sum;
+        workload->id_of_rank[rank] = rank;
+    }
+    for (size_t rank = 0; rank < keys_len; rank++)
+        workload->cdf[rank] /= sum;
+
+    // The hottest keys should not simply be the first ones generated
+    for (size_t rank = keys_len - 1; rank > 0; rank--) {
+        size_t other = next_random(&workload->state) % (rank + 1);
+        size_t id = workload->id_of_rank[rank];
+        workload->id_of_rank[rank] = workload->id_of_rank[other];
+        workload->id_of_rank[other] = id;
+    }
+}
+
+static size_t workload_next(workload_t* workload) {
+    double u = (next_random(&workload->state) >> 11) * 0x1.0p-53;
+    size_t low = 0, high = workload->keys_len - 1;
+    while (low < high) {
+        size_t mid = (low + high) / 2;
+        if (workload->cdf[mid] < u)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    return workload->id_of_rank[low];
+}
+
+static void workload_free(workload_t* workload) {
+    free(workload->cdf);
+    free(workload->id_of_rank);
+}
+
+/**
+ * @brief Fills a store with keys_len keys, then decapsulates operations_len ciphertexts with keys drawn from workload.
+ *
+ * Encapsulation happens outside the timed region; latencies holds the time of
+ * keystore_dec alone.
+ *
+ * @return Number of operations that had to expand their key, or -1 if a key could not be
+ *         generated (see keystore_generate) or a shared secret mismatched.
+ */
+static long run_store(keystore_t* store, const kem_t* kem, workload_t* workload, unsigned char* pks,
+    size_t keys_len, uint64_t* latencies, size_t operations_len) {
+    unsigned char* ct = malloc(kem->ciphertext_bytes);
+    unsigned char* ss = malloc(kem->shared_secret_bytes);
+    unsigned char* ss_check = malloc(kem->shared_secret_bytes);
+    long expansions = 0;
+
+    for (size_t i = 0; i < keys_len && expansions == 0; i++)
+        expansions = keystore_generate(store, pks + i * kem->public_key_bytes) < 0 ? -1 : 0;
+
+    workload->state = WORKLOAD_SEED;
+    for (size_t i = 0; i < operations_len && expansions >= 0; i++) {
+        size_t id = workload_next(workload);
+        kem->enc(ct, ss, pks + id * kem->public_key_bytes);
+
+        uint64_t start = now_ns();
+        expansions += keystore_dec(store, id, ss_check, ct);
+        latencies[i] = now_ns() - start;
+
+        if (memcmp(ss, ss_check, kem->shared_secret_bytes) != 0) {
+            expansions = -1;
+            break;
+        }
+    }
+
+    free(ct);
+    free(ss);
+    free(ss_check);
+    return expansions;
+}
+
+/**
+ * @brief Memory per parked key against decapsulation latency, for expanded and compact secret keys.
+ *
+ * Each KEM gets one store of expanded secret keys and, if its library can
+ * generate keys from given coins, one compact store per LRU size (as a
+ * fraction of the keys). Decapsulations pick their key from a Zipf
+ * distribution, so a small LRU catches most of them when the exponent is
+ * high. Bytes per key include the LRU and its index.
+ *
+ * Usage: ./keystore-bench [-n keys] [-o operations] [-c 0,0.01,0.1] [-z zipf] [name ...]
+ */
+int main(int argc, char** argv) {
+    size_t keys_len = DEFAULT_KEYS;
+    size_t operations_len = DEFAULT_OPERATIONS;
+    const char* caches_arg = DEFAULT_CACHES;
+    double zipf = DEFAULT_ZIPF;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "n:o:c:z:")) != -1) {
+        switch (opt) {
+        case 'n': keys_len = atol(optarg); break;
+        case 'o': operations_len = atol(optarg); break;
+        case 'c': caches_arg = optarg; break;
+        case 'z': zipf = atof(optarg); break;
+        default:
+            fprintf(stderr, "Usage: %s [-n keys] [-o operations] [-c 0,0.01,0.1] [-z zipf] [name ...]\n", argv[0]);
+            return -1;
+        }
+    }
+    if (keys_len == 0 || operations_len == 0 || zipf < 0) {
+        fprintf(stderr, "Keys and operations must be positive, the Zipf exponent not negative\n");
+        return -1;
+    }
+
+    double caches[MAX_CACHES];
+    size_t caches_len = 0;
+    char* list = strdup(caches_arg);
+    for (char* cache = strtok(list, ","); cache != NULL && caches_len < MAX_CACHES; cache = strtok(NULL, ","))
+        caches[caches_len++] = atof(cache);
+    free(list);
+
+    // Select KEMs by name, or all of them
+    const kem_t* selected[kem_registry_len];
+    size_t selected_len = kem_select(argc - optind, argv + optind, selected);
+    if (selected_len == 0)
+        return -1;
+
+    // Header and static data
+    printf("=====================================\n");
+    printf("PQC KEM Key Store Benchmark\n");
+    printf("=====================================\n");
+    printf("Keys:        %7zu per store\n", keys_len);
+    printf("Operations:  %7zu decapsulations per store\n", operations_len);
+    printf("Zipf:        %7.2f\n", zipf);
+    printf("=====================================\n");
+
+    workload_t workload;
+    workload_init(&workload, keys_len, zipf);
+    uint64_t* latencies = malloc(operations_len * sizeof(uint64_t));
+
+    for (size_t i = 0; i < selected_len; i++) {
+        const kem_t* kem = selected[i];
+        unsigned char* pks = malloc(keys_len * kem->public_key_bytes);
+
+        printf("\n%s (secret key %zu B, keygen coins %zu B)\n", kem->name, kem->secret_key_bytes, kem->keypair_coin_bytes);
+        printf("%-10s %8s %10s %9s %10s %10s %10s\n", "Store", "LRU", "B/key", "Hit rate", "p50 (us)", "p90 (us)", "p99 (us)");
+
+        // Expanded first, then compact with each LRU size
+        size_t stores_len = kem->keypair_derand != NULL ? caches_len + 1 : 1;
+        for (size_t s = 0; s < stores_len; s++) {
+            int compact = s > 0;
+            size_t cache_capacity = compact ? (size_t)(caches[s - 1] * keys_len) : 0;
+            keystore_t* store = keystore_new(kem, keys_len, compact, cache_capacity);
+            if (store == NULL) {
+                printf("ERROR: Could not create a key store for %s\n", kem->name);
+                return -1;
+            }
+
+            long expansions = run_store(store, kem, &workload, pks, keys_len, latencies, operations_len);
+            double bytes_per_key = (double)keystore_bytes(store) / keys_len;
+            keystore_free(store);
+            if (expansions < 0) {
+                printf("ERROR: Shared secrets don't match for %s!\n", kem->name);
+                return -1;
+            }
+
+            // remove_outliers with 0% only sorts
+            remove_outliers(latencies, operations_len, 0);
+            const char* label = compact ? "compact" : "expanded";
+            double hit_rate = 1.0 - (double)expansions / operations_len;
+
+            printf("%-10s %8zu %10.1f %8.1f%% %10.1f %10.1f %10.1f\n", label, cache_capacity, bytes_per_key, 100.0 * hit_rate,
+                latencies[operations_len / 2] / 1e3, latencies[(size_t)(operations_len * 0.90)] / 1e3,
+                latencies[(size_t)(operations_len * 0.99)] / 1e3);
+
+            // CSV output to stderr for collection
+            fprintf(stderr, "%s,%s,%zu,%.1f,%.4f,%" PRIu64 ",%" PRIu64 ",%" PRIu64 "\n",
+                kem->name, label, cache_capacity, bytes_per_key, hit_rate, latencies[operations_len / 2],
+                latencies[(size_t)(operations_len * 0.90)], latencies[(size_t)(operations_len * 0.99)]);
+        }
+        if (kem->keypair_derand == NULL)
+            printf("(no keygen from coins, so no compact store)\n");
+
+        free(pks);
+    }
+
+    free(latencies);
+    workload_free(&workload);
+    return 0;
+}
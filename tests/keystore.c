@@ -0,0 +1,184 @@
+#define _GNU_SOURCE
+#include "keystore.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define NO_SLOT UINT32_MAX
+
+// LRU of expanded keys: slots form a doubly linked list from most to least
+// recently used, and slot_of maps a key id to its slot (or NO_SLOT)
+typedef struct {
+    size_t capacity;
+    size_t len;
+    unsigned char* sks;
+    uint32_t* id;
+    uint32_t* prev;
+    uint32_t* next;
+    uint32_t head;
+    uint32_t tail;
+    uint32_t* slot_of;
+} lru_t;
+
+struct keystore {
+    const kem_t* kem;
+    size_t capacity;
+    size_t len;
+    int compact;
+    size_t key_bytes;
+    unsigned char* keys; // coins or secret key per id
+    lru_t lru;
+    unsigned char* pk; // keypair_derand writes the public key too
+    unsigned char* sk; // expansion target when there is no LRU
+};
+
+static void lru_unlink(lru_t* lru, uint32_t slot) {
+    if (lru->prev[slot] != NO_SLOT)
+        lru->next[lru->prev[slot]] = lru->next[slot];
+    else
+        lru->head = lru->next[slot];
+    if (lru->next[slot] != NO_SLOT)
+        lru->prev[lru->next[slot]] = lru->prev[slot];
+    else
+        lru->tail = lru->prev[slot];
+}
+
+static void lru_push_front(lru_t* lru, uint32_t slot) {
+    lru->prev[slot] = NO_SLOT;
+    lru->next[slot] = lru->head;
+    if (lru->head != NO_SLOT)
+        lru->prev[lru->head] = slot;
+    else
+        lru->tail = slot;
+    lru->head = slot;
+}
+
+/**
+ * @brief Returns the expanded key id, expanding it into the least recently used slot on a miss.
+ *
+ * @param expanded Set to 1 if the key had to be expanded.
+ */
+static const unsigned char* lru_get(keystore_t* store, uint32_t id, int* expanded) {
+    lru_t* lru = &store->lru;
+    const size_t sk_bytes = store->kem->secret_key_bytes;
+    uint32_t slot = lru->slot_of[id];
+
+    if (slot != NO_SLOT) {
+        lru_unlink(lru, slot);
+        lru_push_front(lru, slot);
+        *expanded = 0;
+        return lru->sks + slot * sk_bytes;
+    }
+
+    if (lru->len < lru->capacity) {
+        slot = lru->len++;
+    } else {
+        slot = lru->tail;
+        lru_unlink(lru, slot);
+        lru->slot_of[lru->id[slot]] = NO_SLOT;
+    }
+    store->kem->keypair_derand(store->pk, lru->sks + slot * sk_bytes, store->keys + id * store->key_bytes);
+    lru->id[slot] = id;
+    lru->slot_of[id] = slot;
+    lru_push_front(lru, slot);
+    *expanded = 1;
+    return lru->sks + slot * sk_bytes;
+}
+
+keystore_t* keystore_new(const kem_t* kem, size_t capacity, int compact, size_t cache_capacity) {
+    if (compact && kem->keypair_derand == NULL)
+        return NULL;
+    if (capacity >= NO_SLOT || !compact)
+        cache_capacity = 0;
+
+    keystore_t* store = calloc(1, sizeof(keystore_t));
+    if (store == NULL)
+        return NULL;
+    store->kem = kem;
+    store->capacity = capacity;
+    store->compact = compact;
+    store->key_bytes = compact ? kem->keypair_coin_bytes : kem->secret_key_bytes;
+    store->keys = malloc(capacity * store->key_bytes);
+    store->pk = malloc(kem->public_key_bytes);
+    store->sk = malloc(kem->secret_key_bytes);
+    if (store->keys == NULL || store->pk == NULL || store->sk == NULL) {
+        keystore_free(store);
+        return NULL;
+    }
+
+    lru_t* lru = &store->lru;
+    lru->capacity = cache_capacity;
+    lru->head = lru->tail = NO_SLOT;
+    if (cache_capacity > 0) {
+        lru->sks = malloc(cache_capacity * kem->secret_key_bytes);
+        lru->id = malloc(cache_capacity * sizeof(uint32_t));
+        lru->prev = malloc(cache_capacity * sizeof(uint32_t));
+        lru->next = malloc(cache_capacity * sizeof(uint32_t));
+        lru->slot_of = malloc(capacity * sizeof(uint32_t));
+        if (lru->sks == NULL || lru->id == NULL || lru->prev == NULL || lru->next == NULL || lru->slot_of == NULL) {
+            keystore_free(store);
+            return NULL;
+        }
+        memset(lru->slot_of, 0xFF, capacity * sizeof(uint32_t));
+    }
+    return store;
+}
+
+long keystore_generate(keystore_t* store, unsigned char* pk) {
+    if (store->len == store->capacity)
+        return -1;
+
+    unsigned char* key = store->keys + store->len * store->key_bytes;
+    if (store->compact) {
+        // Coins are secret like the key they stand for, so they come from the OS
+        if (getentropy(key, store->key_bytes) != 0)
+            return -1;
+        store->kem->keypair_derand(pk, store->sk, key);
+        // The store keeps only the coins, so check once that they expand to a working key
+        if (store->len == 0 && kem_check_derand(store->kem, key, pk) != 0)
+            return -1;
+    } else {
+        store->kem->keypair(pk, key);
+    }
+    return (long)store->len++;
+}
+
+int keystore_dec(keystore_t* store, size_t id, unsigned char* ss, const unsigned char* ct) {
+    if (id >= store->len)
+        return -1;
+
+    if (!store->compact) {
+        store->kem->dec(ss, ct, store->keys + id * store->key_bytes);
+        return 0;
+    }
+
+    int expanded = 1;
+    const unsigned char* sk = store->sk;
+    if (store->lru.capacity > 0)
+        sk = lru_get(store, (uint32_t)id, &expanded);
+    else
+        store->kem->keypair_derand(store->pk, store->sk, store->keys + id * store->key_bytes);
+    store->kem->dec(ss, ct, sk);
+    return expanded;
+}
+
+size_t keystore_bytes(const keystore_t* store) {
+    const lru_t* lru = &store->lru;
+    size_t bytes = store->capacity * store->key_bytes;
+    if (lru->capacity > 0)
+        bytes += lru->capacity * (store->kem->secret_key_bytes + 3 * sizeof(uint32_t)) + store->capacity * sizeof(uint32_t);
+    return bytes;
+}
+
+void keystore_free(keystore_t* store) {
+    free(store->lru.sks);
+    free(store->lru.id);
+    free(store->lru.prev);
+    free(store->lru.next);
+    free(store->lru.slot_of);
+    free(store->keys);
+    free(store->pk);
+    free(store->sk);
+    free(store);
+}
@@ -0,0 +1,49 @@
+#ifndef _KEYSTORE_H_
+#define _KEYSTORE_H_
+#include "kem.h"
+#include <stddef.h>
+
+// Store of parked secret keys for one KEM, as a key-management service would
+// hold them. Keys are kept either expanded (the library's secret key format)
+// or compact: only the coins of their keygen, which keypair_derand expands
+// again whenever the key is used. An LRU of expanded keys can sit in front of
+// the compact store, so frequently used keys skip the expansion.
+//
+// Not thread-safe; a service would shard stores across threads.
+typedef struct keystore keystore_t;
+
+/**
+ * @brief Creates an empty store.
+ *
+ * @param capacity Keys held at most.
+ * @param compact Keep keygen coins instead of expanded secret keys; the KEM must have keypair_derand.
+ * @param cache_capacity Expanded keys kept in the LRU, only used when compact.
+ * @return The store, or NULL if allocation fails or compact is not supported.
+ */
+keystore_t* keystore_new(const kem_t* kem, size_t capacity, int compact, size_t cache_capacity);
+
+/**
+ * @brief Generates a keypair, keeps its secret key and writes out the public key.
+ *
+ * The first compact key is checked with kem_check_derand, so a store whose
+ * coins would not expand back into working keys fails here.
+ *
+ * @return Id of the key, or -1 if the store is full, the entropy source failed or the check failed.
+ */
+long keystore_generate(keystore_t* store, unsigned char* pk);
+
+/**
+ * @brief Decapsulates ct with key id, expanding the key first if it is compact and not cached.
+ *
+ * @return 0 if no expansion was needed, 1 if the key was expanded, -1 if id is unknown.
+ */
+int keystore_dec(keystore_t* store, size_t id, unsigned char* ss, const unsigned char* ct);
+
+/**
+ * @brief Bytes the store holds for its keys: the keys themselves, the LRU and its index.
+ */
+size_t keystore_bytes(const keystore_t* store);
+
+void keystore_free(keystore_t* store);
+
+#endif
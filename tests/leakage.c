@@ -0,0 +1,284 @@
+#include "benchmark.h"
+#include "kem.h"
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// Test configuration
+#define DEFAULT_MEASUREMENTS 200000
+#define BATCH_MEASUREMENTS 10000
+#define POOL_SIZE 64
+#define WARMUP_ITERATIONS 100
+#define T_THRESHOLD 4.5
+#define T_THRESHOLD_DEFINITE 10.0
+
+// Cropping: measurements above these percentiles of the first batch are left
+// out of the cropped tests, which removes most interrupt and scheduling noise
+static const double crop_percentiles[] = { 0.50, 0.75, 0.90, 0.95, 0.99 };
+#define CROPS (sizeof(crop_percentiles) / sizeof(*crop_percentiles))
+#define T_TESTS (CROPS + 1)
+
+// Online Welch's t-test, one mean and variance per class (Welford's update)
+typedef struct {
+    double n[2];
+    double mean[2];
+    double m2[2];
+} welch_t;
+
+static void welch_push(welch_t* test, int cls, double x) {
+    test->n[cls]++;
+    double delta = x - test->mean[cls];
+    test->mean[cls] += delta / test->n[cls];
+    test->m2[cls] += delta * (x - test->mean[cls]);
+}
+
+static double welch_statistic(const welch_t* test) {
+    if (test->n[0] < 2 || test->n[1] < 2)
+        return 0;
+    double var0 = test->m2[0] / (test->n[0] - 1);
+    double var1 = test->m2[1] / (test->n[1] - 1);
+    double den = sqrt(var0 / test->n[0] + var1 / test->n[1]);
+    return den > 0 ? (test->mean[0] - test->mean[1]) / den : 0;
+}
+
+// next_random only picks classes and fills random ciphertexts, it needs no quality beyond that
+static uint64_t prng_state = 0x853C49E6748FEA9Bull;
+
+static void prng_fill(unsigned char* buf, size_t len) {
+    for (size_t i = 0; i < len; i++)
+        buf[i] = (unsigned char)(next_random(&prng_state) >> 56);
+}
+
+/*
+ * Each test decapsulates with inputs from two classes. Class 0 always gets the
+ * same (sk, ct), class 1 gets one drawn from a pool:
+ *   dec-ct  the fixed key with random bytes as ciphertext, so valid vs
+ *           rejected ciphertexts (Kyber's verify/cmov, HQC's decoder on
+ *           garbage)
+ *   dec-sk  other keypairs, each with a valid ciphertext of its own, so fixed
+ *           vs random secret keys
+ * Public data differs between the classes too, so variable time that only
+ * depends on it shows up as well: ECDH rejecting random points in dec-ct, its
+ * cached private key in dec-sk, and Kyber sampling the matrix from each key's
+ * public seed by rejection in dec-sk. A failing test needs a closer look
+ * before it counts as a secret-dependent leak.
+ */
+typedef enum { TEST_DEC_CT, TEST_DEC_SK } test_kind_t;
+static const char* test_names[] = { "dec-ct", "dec-sk" };
+#define TEST_KINDS (sizeof(test_names) / sizeof(*test_names))
+
+typedef struct {
+    const kem_t* kem;
+    test_kind_t kind;
+    unsigned char* sk[POOL_SIZE + 1]; // [0] is the fixed class
+    unsigned char* ct[POOL_SIZE + 1];
+    unsigned char* sk_work; // every input is copied here before it is timed
+    unsigned char* ct_work;
+    unsigned char* ss;
+} inputs_t;
+
+static void inputs_init(inputs_t* inputs, const kem_t* kem, test_kind_t kind) {
+    unsigned char* pk = malloc(kem->public_key_bytes);
+    inputs->kem = kem;
+    inputs->kind = kind;
+    inputs->ss = malloc(kem->shared_secret_bytes);
+    inputs->sk_work = malloc(kem->secret_key_bytes);
+    inputs->ct_work = malloc(kem->ciphertext_bytes);
+
+    for (size_t i = 0; i <= POOL_SIZE; i++) {
+        inputs->ct[i] = malloc(kem->ciphertext_bytes);
+        if (i == 0 || kind == TEST_DEC_SK) {
+            inputs->sk[i] = malloc(kem->secret_key_bytes);
+            kem->keypair(pk, inputs->sk[i]);
+            kem->enc(inputs->ct[i], inputs->ss, pk);
+        } else {
+            inputs->sk[i] = inputs->sk[0];
+            prng_fill(inputs->ct[i], kem->ciphertext_bytes);
+        }
+    }
+    free(pk);
+}
+
+// Fresh random ciphertexts for the next batch (dec-ct only)
+static void inputs_refresh(inputs_t* inputs) {
+    if (inputs->kind == TEST_DEC_CT)
+        for (size_t i = 1; i <= POOL_SIZE; i++)
+            prng_fill(inputs->ct[i], inputs->kem->ciphertext_bytes);
+}
+
+static void inputs_free(inputs_t* inputs) {
+    for (size_t i = 0; i <= POOL_SIZE; i++) {
+        if (i == 0 || inputs->kind == TEST_DEC_SK)
+            free(inputs->sk[i]);
+        free(inputs->ct[i]);
+    }
+    free(inputs->sk_work);
+    free(inputs->ct_work);
+    free(inputs->ss);
+}
+
+/**
+ * @brief Times one batch of decapsulations with randomly interleaved classes.
+ *
+ * The class and input of every measurement are drawn before timing starts, so
+ * the only work between the two counter reads is the decapsulation itself.
+ * Both classes are copied into the same buffers first, otherwise the fixed
+ * input would simply be hotter in the cache than the pool's.
+ */
+static void measure_batch(inputs_t* inputs, int* classes, size_t* picks, uint64_t* timings, size_t batch_len) {
+    for (size_t i = 0; i < batch_len; i++) {
+        classes[i] = next_random(&prng_state) & 1;
+        picks[i] = classes[i] ? 1 + next_random(&prng_state) % POOL_SIZE : 0;
+    }
+
+    for (size_t i = 0; i < batch_len; i++) {
+        memcpy(inputs->sk_work, inputs->sk[picks[i]], inputs->kem->secret_key_bytes);
+        memcpy(inputs->ct_work, inputs->ct[picks[i]], inputs->kem->ciphertext_bytes);
+        uint64_t start = cycles();
+        inputs->kem->dec(inputs->ss, inputs->ct_work, inputs->sk_work);
+        timings[i] = cycles() - start;
+    }
+}
+
+/**
+ * @brief Runs one leakage test, printing the largest |t| after every batch.
+ *
+ * @return The largest |t| at the end of the run.
+ */
+static double run_test(const kem_t* kem, test_kind_t kind, size_t measurements) {
+    inputs_t inputs;
+    inputs_init(&inputs, kem, kind);
+
+    int* classes = malloc(BATCH_MEASUREMENTS * sizeof(int));
+    size_t* picks = malloc(BATCH_MEASUREMENTS * sizeof(size_t));
+    uint64_t* timings = malloc(BATCH_MEASUREMENTS * sizeof(uint64_t));
+    uint64_t* sorted = malloc(BATCH_MEASUREMENTS * sizeof(uint64_t));
+    welch_t tests[T_TESTS] = { 0 };
+    uint64_t thresholds[CROPS];
+
+    for (size_t i = 0; i < WARMUP_ITERATIONS; i++)
+        kem->dec(inputs.ss, inputs.ct[i % (POOL_SIZE + 1)], inputs.sk[i % (POOL_SIZE + 1)]);
+
+    printf("\n%s, %s\n", kem->name, test_names[kind]);
+    printf("%12s %10s %8s %10s %10s\n", "Measurements", "max |t|", "Test", "Mean 0", "Mean 1");
+
+    double max_t = 0;
+    for (size_t done = 0; done < measurements; done += BATCH_MEASUREMENTS) {
+        inputs_refresh(&inputs);
+        measure_batch(&inputs, classes, picks, timings, BATCH_MEASUREMENTS);
+
+        // Crop thresholds come from the first batch, mixing both classes
+        if (done == 0) {
+            memcpy(sorted, timings, BATCH_MEASUREMENTS * sizeof(uint64_t));
+            remove_outliers(sorted, BATCH_MEASUREMENTS, 0);
+            for (size_t c = 0; c < CROPS; c++)
+                thresholds[c] = sorted[(size_t)(BATCH_MEASUREMENTS * crop_percentiles[c])];
+        }
+
+        for (size_t i = 0; i < BATCH_MEASUREMENTS; i++) {
+            welch_push(&tests[0], classes[i], timings[i]);
+            for (size_t c = 0; c < CROPS; c++)
+                if (timings[i] < thresholds[c])
+                    welch_push(&tests[c + 1], classes[i], timings[i]);
+        }
+
+        // Report the test with the largest |t| so far
+        size_t worst = 0;
+        max_t = 0;
+        for (size_t t = 0; t < T_TESTS; t++) {
+            if (fabs(welch_statistic(&tests[t])) > max_t) {
+                max_t = fabs(welch_statistic(&tests[t]));
+                worst = t;
+            }
+        }
+
+        char label[16];
+        if (worst == 0)
+            snprintf(label, sizeof(label), "raw");
+        else
+            snprintf(label, sizeof(label), "p%.0f", crop_percentiles[worst - 1] * 100);
+        printf("%12zu %10.2f %8s %10.0f %10.0f\n", done + BATCH_MEASUREMENTS, max_t, label,
+            tests[worst].mean[0], tests[worst].mean[1]);
+
+        // CSV output to stderr for collection
+        fprintf(stderr, "%s,%s,%zu,%.4f,%s\n", kem->name, test_names[kind], done + BATCH_MEASUREMENTS, max_t, label);
+    }
+
+    if (max_t > T_THRESHOLD_DEFINITE)
+        printf("Result: timing leak (|t| > %.1f)\n", T_THRESHOLD_DEFINITE);
+    else if (max_t > T_THRESHOLD)
+        printf("Result: possible timing leak (|t| > %.1f), rerun with more measurements\n", T_THRESHOLD);
+    else
+        printf("Result: no leak detected (|t| <= %.1f)\n", T_THRESHOLD);
+
+    inputs_free(&inputs);
+    free(classes);
+    free(picks);
+    free(timings);
+    free(sorted);
+    return max_t;
+}
+
+/**
+ * @brief dudect-style timing leakage detection (Reparaz, Balasch & Verbauwhede, 2017).
+ *
+ * For every selected KEM and test, decapsulations with a fixed input and with
+ * random inputs are timed in random order with the cycle counter, and Welch's
+ * t-test compares the two timing distributions, raw and cropped at several
+ * percentiles. |t| above 4.5 suggests the timing depends on the input, and
+ * grows with the number of measurements if it really does.
+ *
+ * Usage: ./leakage [-n measurements] [-t dec-ct|dec-sk|all] [name ...]
+ */
+int main(int argc, char** argv) {
+    size_t measurements = DEFAULT_MEASUREMENTS;
+    const char* test_arg = "all";
+
+    int opt;
+    while ((opt = getopt(argc, argv, "n:t:")) != -1) {
+        switch (opt) {
+        case 'n': measurements = atol(optarg); break;
+        case 't': test_arg = optarg; break;
+        default:
+            fprintf(stderr, "Usage: %s [-n measurements] [-t dec-ct|dec-sk|all] [name ...]\n", argv[0]);
+            return -1;
+        }
+    }
+    if (measurements < BATCH_MEASUREMENTS)
+        measurements = BATCH_MEASUREMENTS;
+
+    int test_known = strcmp(test_arg, "all") == 0;
+    for (size_t kind = 0; kind < TEST_KINDS; kind++)
+        test_known |= strcmp(test_arg, test_names[kind]) == 0;
+    if (!test_known) {
+        fprintf(stderr, "Unknown test '%s', expected dec-ct, dec-sk or all\n", test_arg);
+        return -1;
+    }
+
+    // Select KEMs by name, or all of them
+    const kem_t* selected[kem_registry_len];
+    size_t selected_len = kem_select(argc - optind, argv + optind, selected);
+    if (selected_len == 0)
+        return -1;
+
+    // Header and static data
+    printf("=====================================\n");
+    printf("PQC KEM Timing Leakage Test\n");
+    printf("Following Reparaz et al. (2017), dudect\n");
+    printf("=====================================\n");
+    printf("Measurements: %7zu per test\n", measurements);
+    printf("Batch:        %7d measurements\n", BATCH_MEASUREMENTS);
+    printf("Threshold:    |t| > %.1f\n", T_THRESHOLD);
+    printf("=====================================\n");
+
+    int leaks = 0;
+    for (size_t i = 0; i < selected_len; i++)
+        for (size_t kind = 0; kind < TEST_KINDS; kind++)
+            if (strcmp(test_arg, "all") == 0 || strcmp(test_arg, test_names[kind]) == 0)
+                leaks += run_test(selected[i], kind, measurements) > T_THRESHOLD;
+
+    return leaks;
+}
@@ -0,0 +1,350 @@
+#include "benchmark.h"
+#include "kem.h"
+#include <inttypes.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// Test configuration
+#define DEFAULT_DURATION_MS 1000
+#define CALIBRATION_ITERATIONS 200
+#define DEFAULT_LOADS "0.1,0.2,0.3,0.4,0.5,0.6,0.7,0.8,0.85,0.9,0.95,1.0,1.1,1.2"
+#define MAX_LEVELS 32
+#define KNEE_FACTOR 5
+#define SATURATED_PERCENTAGE 90
+#define SPIN_NS 50000
+
+typedef enum { OP_KEYGEN, OP_ENC, OP_DEC, OP_HANDSHAKE } operation_t;
+static const char* operation_names[] = { "keygen", "enc", "dec", "handshake" };
+
+// Per-worker buffers, so workers never share a key
+typedef struct {
+    const kem_t* kem;
+    unsigned char* pk;
+    unsigned char* sk;
+    unsigned char* ct;
+    unsigned char* ss;
+} kem_state_t;
+
+// One run at a fixed arrival rate
+typedef struct {
+    const kem_t* kem;
+    operation_t operation;
+    const uint64_t* intended; // absolute CLOCK_MONOTONIC start times, ns
+    size_t requests_len;
+    atomic_size_t next;
+    pthread_barrier_t ready; // passed twice: keys set up, then schedule written
+    uint64_t* latencies; // from intended start, the coordinated-omission corrected latency
+    uint64_t* service; // from actual start
+    uint64_t* completed;
+} run_t;
+
+// Sleeps until an absolute time, spinning through the last SPIN_NS for accuracy
+static void wait_until(uint64_t deadline) {
+    uint64_t now = now_ns();
+    if (now + SPIN_NS < deadline) {
+        uint64_t sleep_until = deadline - SPIN_NS;
+        struct timespec t = { .tv_sec = sleep_until / NS_PER_SEC, .tv_nsec = sleep_until % NS_PER_SEC };
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &t, NULL) != 0)
+            ;
+    }
+    while (now_ns() < deadline)
+        ;
+}
+
+static void kem_state_init(kem_state_t* state, const kem_t* kem) {
+    state->kem = kem;
+    state->pk = malloc(kem->public_key_bytes);
+    state->sk = malloc(kem->secret_key_bytes);
+    state->ct = malloc(kem->ciphertext_bytes);
+    state->ss = malloc(kem->shared_secret_bytes);
+    kem->keypair(state->pk, state->sk);
+    kem->enc(state->ct, state->ss, state->pk);
+}
+
+static void kem_state_free(kem_state_t* state) {
+    free(state->pk);
+    free(state->sk);
+    free(state->ct);
+    free(state->ss);
+}
+
+static void run_operation(kem_state_t* state, operation_t operation) {
+    const kem_t* kem = state->kem;
+    switch (operation) {
+    case OP_KEYGEN:
+        kem->keypair(state->pk, state->sk);
+        break;
+    case OP_ENC:
+        kem->enc(state->ct, state->ss, state->pk);
+        break;
+    case OP_DEC:
+        kem->dec(state->ss, state->ct, state->sk);
+        break;
+    case OP_HANDSHAKE:
+        kem->keypair(state->pk, state->sk);
+        kem->enc(state->ct, state->ss, state->pk);
+        kem->dec(state->ss, state->ct, state->sk);
+        break;
+    }
+}
+
+/**
+ * @brief Worker: takes the next request, waits for its arrival time if it is early, and runs it.
+ *
+ * Taking requests in arrival order from a shared counter makes the pool a
+ * FIFO queue served by all workers. When every worker is busy, requests whose
+ * arrival time has passed wait in that queue, and the wait is part of their
+ * latency because it is measured from the arrival time, not from when a
+ * worker got to them.
+ */
+static void* worker_main(void* raw_run) {
+    run_t* run = raw_run;
+    kem_state_t state;
+    kem_state_init(&state, run->kem);
+    pthread_barrier_wait(&run->ready);
+    pthread_barrier_wait(&run->ready);
+
+    for (;;) {
+        size_t i = atomic_fetch_add(&run->next, 1);
+        if (i >= run->requests_len)
+            break;
+
+        wait_until(run->intended[i]);
+        uint64_t start = now_ns();
+        run_operation(&state, run->operation);
+        uint64_t end = now_ns();
+
+        run->latencies[i] = end - run->intended[i];
+        run->service[i] = end - start;
+        run->completed[i] = end;
+    }
+
+    kem_state_free(&state);
+    return NULL;
+}
+
+// Uniform in [0, 1), seeded per run so arrival schedules are reproducible
+static double uniform(uint64_t* seed) {
+    return (next_random(seed) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+typedef struct {
+    double offered;
+    double achieved;
+    uint64_t p50, p90, p99, p999, max, service_p99;
+} level_result_t;
+
+/**
+ * @brief Runs the workers against arrivals at rate per second for duration_ms.
+ */
+static level_result_t run_level(const kem_t* kem, operation_t operation, size_t workers, double rate, int poisson, long duration_ms) {
+    size_t requests_len = (size_t)(rate * duration_ms / MS_PER_SEC);
+    if (requests_len < 1)
+        requests_len = 1;
+
+    uint64_t* intended = malloc(requests_len * sizeof(uint64_t));
+    run_t run = {
+        .kem = kem,
+        .operation = operation,
+        .intended = intended,
+        .requests_len = requests_len,
+        .latencies = malloc(requests_len * sizeof(uint64_t)),
+        .service = malloc(requests_len * sizeof(uint64_t)),
+        .completed = malloc(requests_len * sizeof(uint64_t)),
+    };
+    atomic_init(&run.next, 0);
+
+    pthread_t* threads = malloc(workers * sizeof(pthread_t));
+    pthread_barrier_init(&run.ready, NULL, workers + 1);
+    for (size_t i = 0; i < workers; i++)
+        pthread_create(&threads[i], NULL, worker_main, &run);
+
+    // Arrival schedule, written once every worker has its keys
+    pthread_barrier_wait(&run.ready);
+    uint64_t seed = 0x9E3779B97F4A7C15ull ^ (uint64_t)(rate * 1000);
+    double interval = (double)NS_PER_SEC / rate;
+    uint64_t start = now_ns() + NS_PER_SEC / MS_PER_SEC;
+    double offset = 0;
+    for (size_t i = 0; i < requests_len; i++) {
+        intended[i] = start + (uint64_t)offset;
+        offset += poisson ? -log(1.0 - uniform(&seed)) * interval : interval;
+    }
+
+    pthread_barrier_wait(&run.ready);
+    for (size_t i = 0; i < workers; i++)
+        pthread_join(threads[i], NULL);
+    pthread_barrier_destroy(&run.ready);
+
+    uint64_t last = 0;
+    for (size_t i = 0; i < requests_len; i++)
+        if (run.completed[i] > last)
+            last = run.completed[i];
+
+    // remove_outliers with 0% only sorts
+    remove_outliers(run.latencies, requests_len, 0);
+    remove_outliers(run.service, requests_len, 0);
+    level_result_t result = {
+        .offered = rate,
+        .achieved = requests_len * (double)NS_PER_SEC / (last - start),
+        .p50 = run.latencies[(size_t)(requests_len * 0.50)],
+        .p90 = run.latencies[(size_t)(requests_len * 0.90)],
+        .p99 = run.latencies[(size_t)(requests_len * 0.99)],
+        .p999 = run.latencies[(size_t)(requests_len * 0.999)],
+        .max = run.latencies[requests_len - 1],
+        .service_p99 = run.service[(size_t)(requests_len * 0.99)],
+    };
+
+    free(intended);
+    free(run.latencies);
+    free(run.service);
+    free(run.completed);
+    free(threads);
+    return result;
+}
+
+/**
+ * @brief Closed-loop median of one operation, used to scale the offered loads.
+ */
+static uint64_t calibrate(const kem_t* kem, operation_t operation) {
+    kem_state_t state;
+    uint64_t timings[CALIBRATION_ITERATIONS];
+    kem_state_init(&state, kem);
+    for (size_t i = 0; i < CALIBRATION_ITERATIONS; i++) {
+        uint64_t start = now_ns();
+        run_operation(&state, operation);
+        timings[i] = now_ns() - start;
+    }
+    kem_state_free(&state);
+    remove_outliers(timings, CALIBRATION_ITERATIONS, 0);
+    return timings[CALIBRATION_ITERATIONS / 2];
+}
+
+static size_t parse_list(const char* arg, double* values, size_t values_cap) {
+    size_t values_len = 0;
+    char* list = strdup(arg);
+    for (char* value = strtok(list, ","); value != NULL && values_len < values_cap; value = strtok(NULL, ","))
+        if (atof(value) > 0)
+            values[values_len++] = atof(value);
+    free(list);
+    return values_len;
+}
+
+/**
+ * @brief Open-loop load generator: latency under a target arrival rate.
+ *
+ * For every selected KEM and worker count, the closed-loop median of the
+ * operation gives the pool's capacity (workers / median). Requests then
+ * arrive at fractions of that capacity, spaced exponentially (Poisson) or
+ * evenly, and latency is measured from each request's arrival time, so time
+ * spent queued behind busy workers is included (coordinated omission
+ * corrected). The knee is the first load where p99 exceeds KNEE_FACTOR times
+ * the lowest p99 of the lighter loads (the lowest, so one noisy level does not
+ * hide it), or where the pool falls behind the arrivals.
+ *
+ * Usage: ./loadgen [-o keygen|enc|dec|handshake] [-w 1,2] [-l 0.1,0.5,...] [-d ms] [-c] [name ...]
+ */
+int main(int argc, char** argv) {
+    operation_t operation = OP_ENC;
+    const char* workers_arg = NULL;
+    const char* loads_arg = DEFAULT_LOADS;
+    long duration_ms = DEFAULT_DURATION_MS;
+    int poisson = 1;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "o:w:l:d:c")) != -1) {
+        switch (opt) {
+        case 'o':
+            for (size_t op = 0; op < sizeof(operation_names) / sizeof(*operation_names); op++)
+                if (strcmp(optarg, operation_names[op]) == 0)
+                    operation = op;
+            break;
+        case 'w': workers_arg = optarg; break;
+        case 'l': loads_arg = optarg; break;
+        case 'd': duration_ms = atol(optarg); break;
+        case 'c': poisson = 0; break;
+        default:
+            fprintf(stderr, "Usage: %s [-o keygen|enc|dec|handshake] [-w 1,2] [-l 0.1,0.5,...] [-d ms] [-c] [name ...]\n", argv[0]);
+            return -1;
+        }
+    }
+
+    // Worker counts default to 1, 2, 4, ... up to the number of cores
+    double workers[MAX_LEVELS];
+    size_t workers_len = 0;
+    if (workers_arg != NULL) {
+        workers_len = parse_list(workers_arg, workers, MAX_LEVELS);
+    } else {
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        for (long w = 1; w < cores && workers_len < MAX_LEVELS - 1; w *= 2)
+            workers[workers_len++] = w;
+        workers[workers_len++] = cores;
+    }
+    double loads[MAX_LEVELS];
+    size_t loads_len = parse_list(loads_arg, loads, MAX_LEVELS);
+
+    if (workers_len == 0 || loads_len == 0) {
+        fprintf(stderr, "Usage: %s [-o keygen|enc|dec|handshake] [-w 1,2] [-l 0.1,0.5,...] [-d ms] [-c] [name ...]\n", argv[0]);
+        return -1;
+    }
+
+    // Select KEMs by name, or all of them
+    const kem_t* selected[kem_registry_len];
+    size_t selected_len = kem_select(argc - optind, argv + optind, selected);
+    if (selected_len == 0)
+        return -1;
+
+    // Header and static data
+    printf("=====================================\n");
+    printf("PQC KEM Open-Loop Load Generator\n");
+    printf("=====================================\n");
+    printf("Operation:   %s\n", operation_names[operation]);
+    printf("Arrivals:    %s\n", poisson ? "Poisson" : "constant");
+    printf("Duration:    %7ld ms per load\n", duration_ms);
+    printf("Knee:        p99 > %dx lowest p99 so far, or < %d%% of arrivals served\n", KNEE_FACTOR, SATURATED_PERCENTAGE);
+    printf("=====================================\n");
+
+    for (size_t i = 0; i < selected_len; i++) {
+        const kem_t* kem = selected[i];
+        uint64_t median = calibrate(kem, operation);
+
+        for (size_t w = 0; w < workers_len; w++) {
+            size_t worker_count = (size_t)workers[w];
+            double capacity = worker_count * (double)NS_PER_SEC / median;
+
+            printf("\n%s, %zu worker%s (closed-loop median %" PRIu64 " ns, capacity ~%.0f ops/s)\n",
+                kem->name, worker_count, worker_count == 1 ? "" : "s", median, capacity);
+            printf("%6s %10s %10s %10s %10s %10s %10s %10s %11s\n",
+                "Load", "Offered/s", "Served/s", "p50 (us)", "p90 (us)", "p99 (us)", "p99.9 (us)", "max (us)", "svc p99 us");
+
+            uint64_t base_p99 = UINT64_MAX;
+            int knee_found = 0;
+            for (size_t l = 0; l < loads_len; l++) {
+                level_result_t r = run_level(kem, operation, worker_count, loads[l] * capacity, poisson, duration_ms);
+                int knee = !knee_found && l > 0
+                    && (r.p99 > KNEE_FACTOR * base_p99 || r.achieved * 100 < r.offered * SATURATED_PERCENTAGE);
+                knee_found |= knee;
+                if (r.p99 < base_p99)
+                    base_p99 = r.p99;
+
+                printf("%6.2f %10.0f %10.0f %10.1f %10.1f %10.1f %10.1f %10.1f %11.1f%s\n",
+                    loads[l], r.offered, r.achieved, r.p50 / 1e3, r.p90 / 1e3, r.p99 / 1e3, r.p999 / 1e3, r.max / 1e3,
+                    r.service_p99 / 1e3, knee ? "  <- knee" : "");
+
+                // CSV output to stderr for collection
+                fprintf(stderr, "%s,%s,%zu,%.2f,%.0f,%.0f,%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%d\n",
+                    kem->name, operation_names[operation], worker_count, loads[l], r.offered, r.achieved,
+                    r.p50, r.p90, r.p99, r.p999, r.max, knee);
+            }
+            if (!knee_found)
+                printf("No knee up to %.2fx the closed-loop capacity\n", loads[loads_len - 1]);
+        }
+    }
+
+    return 0;
+}
@@ -1,19 +1,35 @@
 #include "benchmark.h"
+#include "footprint.h"
 #include "api.h"
+#include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
-#include <math.h>
 
-// Test configuration
+// Name reported in the output, overridden by the Makefile when several builds
+// of the same algorithm would otherwise share a CRYPTO_ALGNAME
+#ifndef KEM_NAME
+#define KEM_NAME CRYPTO_ALGNAME
+#endif
+
+// Test configuration (the Makefile lowers the iteration counts for slow builds)
+#ifndef WARMUP_ITERATIONS
 #define WARMUP_ITERATIONS 1000
+#endif
+#ifndef MEASUREMENT_ITERATIONS
 #define MEASUREMENT_ITERATIONS 10000
+#endif
 #define OUTLIER_PERCENTAGE 10
+#define INVALID_CIPHERTEXTS 64
+
+// Global buffers, allocated in main so the binary's .data/.bss is the library's alone
+static unsigned char* sk;
+static unsigned char* pk;
+static unsigned char* ct;
+static unsigned char* ss;
 
-// Global buffers - define them here
-static unsigned char sk[CRYPTO_SECRETKEYBYTES];
-static unsigned char pk[CRYPTO_PUBLICKEYBYTES];
-static unsigned char ct[CRYPTO_CIPHERTEXTBYTES];
-static unsigned char ss[CRYPTO_BYTES];
+// Corrupted copies of ct, decapsulated in turn by dec_invalid
+static unsigned char* invalid_ct;
+static size_t invalid_index;
 
 /**
  * @brief Wrapper function for KEM key generation.
@@ -45,43 +61,57 @@ void dec() {
 }
 
 /**
- * @brief Calculates and prints comprehensive statistics for timing measurements.
- *
- * Computes mean, standard deviation, median, and various percentiles from the
- * timing data and displays them in a formatted output.
+ * @brief Wrapper function for KEM decapsulation of an invalid ciphertext.
  *
- * @param operation Name of the operation being measured (e.g., "KeyGen").
- * @param data Sorted array of timing measurements in microseconds.
- * @param n Number of elements in the data array.
+ * Decapsulates the next of the INVALID_CIPHERTEXTS in invalid_ct, so the
+ * rejection path is timed over many inputs rather than a single one.
+ */
+void dec_invalid() {
+    crypto_kem_dec(ss, invalid_ct + invalid_index++ % INVALID_CIPHERTEXTS * CRYPTO_CIPHERTEXTBYTES, sk);
+}
+
+// Ways a ciphertext arrives broken: a corrupted bit, garbage, or a short read padded back to size with zeros
+typedef enum { INVALID_BIT_FLIP, INVALID_RANDOM, INVALID_TRUNCATED, INVALID_KINDS } invalid_kind_t;
+static const char* invalid_labels[] = { "Decaps (Bit Flip)", "Decaps (Random)", "Decaps (Truncated)" };
+
+/**
+ * @brief Fills invalid_ct with INVALID_CIPHERTEXTS corrupted copies of the valid ct.
+ */
+void make_invalid(invalid_kind_t kind) {
+    for (size_t i = 0; i < INVALID_CIPHERTEXTS; i++) {
+        unsigned char* c = invalid_ct + i * CRYPTO_CIPHERTEXTBYTES;
+        memcpy(c, ct, CRYPTO_CIPHERTEXTBYTES);
+        if (kind == INVALID_BIT_FLIP) {
+            size_t bit = rand() % (CRYPTO_CIPHERTEXTBYTES * 8);
+            c[bit / 8] ^= 1 << (bit % 8);
+        } else if (kind == INVALID_RANDOM) {
+            for (size_t j = 0; j < CRYPTO_CIPHERTEXTBYTES; j++)
+                c[j] = rand();
+        } else {
+            size_t kept = rand() % CRYPTO_CIPHERTEXTBYTES;
+            memset(c + kept, 0, CRYPTO_CIPHERTEXTBYTES - kept);
+        }
+    }
+    invalid_index = 0;
+}
+
+/**
+ * @brief Prints the stack and heap used by one call of an operation.
  */
-void print_distribution(const char* label, uint64_t* data, size_t data_len) {
-
-    // Sum and calculate mean
-    double sum = 0;
-    for (size_t i = 0; i < data_len; i++)
-        sum += data[i];
-    double mean = sum / data_len;
-
-    // Calcular variance and stdev
-    double var = 0;
-    for (size_t i = 0; i < data_len; i++)
-        var += pow(data[i] - mean, 2);
-    double stdev = sqrt(var / data_len);
-
-    // Printing operations (couldn't be bothered thx chat)
-    printf("\n%s:\n", label);
-    printf("  Samples:    %7d (after outlier removal)\n", data_len);
-    printf("  Median:     %7d ns (%d ops/sec)\n", data[data_len / 2], NS_PER_SEC / data[data_len / 2]);
-    printf("  Mean:       %7d ns\n", (uint64_t)mean);
-    printf("  Std Dev:    %7d ns\n", (uint64_t)stdev);
-    printf("  10th %%ile:  %7d ns\n", data[(size_t)(data_len * 0.10)]);
-    printf("  25th %%ile:  %7d ns\n", data[(size_t)(data_len * 0.25)]);
-    printf("  75th %%ile:  %7d ns\n", data[(size_t)(data_len * 0.75)]);
-    printf("  90th %%ile:  %7d ns\n", data[(size_t)(data_len * 0.90)]);
-    printf("  95th %%ile:  %7d ns\n", data[(size_t)(data_len * 0.95)]);
+void print_footprint(const char* label, const footprint_t* footprint) {
+    printf("%-15s %7zu B stack", label, footprint->stack_bytes);
+    if (footprint_heap_supported())
+        printf(", %5zu allocations, %7zu B allocated, %7zu B peak heap", footprint->heap_allocations, footprint->heap_bytes, footprint->heap_peak_bytes);
+    printf("\n");
 }
 
 int main(int argc, char** argv) {
+    sk = malloc(CRYPTO_SECRETKEYBYTES);
+    pk = malloc(CRYPTO_PUBLICKEYBYTES);
+    ct = malloc(CRYPTO_CIPHERTEXTBYTES);
+    ss = malloc(CRYPTO_BYTES);
+    invalid_ct = malloc(INVALID_CIPHERTEXTS * CRYPTO_CIPHERTEXTBYTES);
+
     // Validate the algos correctness
     unsigned char ss_check[CRYPTO_BYTES];
     crypto_kem_keypair(pk, sk);
@@ -97,7 +127,10 @@ int main(int argc, char** argv) {
     printf("PQC KEM Isolated Benchmark\n");
     printf("Following Paquin et al. (2020) & Becker et al. (2024)\n");
     printf("=====================================\n");
-    printf("Algorithm:   %s\n", CRYPTO_ALGNAME);
+    printf("Algorithm:   %s\n", KEM_NAME);
+#ifdef CRYPTO_BACKEND
+    printf("Backend:     %s\n", CRYPTO_BACKEND());
+#endif
     printf("Public Key:  %7d bytes\n", CRYPTO_PUBLICKEYBYTES);
     printf("Secret Key:  %7d bytes\n", CRYPTO_SECRETKEYBYTES);
     printf("Ciphertext:  %7d bytes\n", CRYPTO_CIPHERTEXTBYTES);
@@ -117,9 +150,12 @@ int main(int argc, char** argv) {
     print_distribution("KeyGen", timings, timings_len);
     uint64_t keygen_median = timings[timings_len / 2];
 
-    // Benchmark Encaps
+    // Benchmark Encaps. The tail percentiles for the CSV are read before the outliers are trimmed
     printf("\nPhase 2: Encapsulation:\n");
     benchmark(enc, timings, WARMUP_ITERATIONS, MEASUREMENT_ITERATIONS);
+    remove_outliers(timings, MEASUREMENT_ITERATIONS, 0);
+    uint64_t encaps_p90 = timings[MEASUREMENT_ITERATIONS * 90 / 100];
+    uint64_t encaps_p99 = timings[MEASUREMENT_ITERATIONS * 99 / 100];
     timings_len = remove_outliers(timings, MEASUREMENT_ITERATIONS, OUTLIER_PERCENTAGE);
     print_distribution("Encapsulation", timings, timings_len);
     uint64_t encaps_median = timings[timings_len / 2];
@@ -127,10 +163,39 @@ int main(int argc, char** argv) {
     // Benchmark Decaps
     printf("\nPhase 3: Decapsulation:\n");
     benchmark(dec, timings, WARMUP_ITERATIONS, MEASUREMENT_ITERATIONS);
+    remove_outliers(timings, MEASUREMENT_ITERATIONS, 0);
+    uint64_t decaps_p90 = timings[MEASUREMENT_ITERATIONS * 90 / 100];
+    uint64_t decaps_p99 = timings[MEASUREMENT_ITERATIONS * 99 / 100];
     timings_len = remove_outliers(timings, MEASUREMENT_ITERATIONS, OUTLIER_PERCENTAGE);
     print_distribution("Decapsulation", timings, timings_len);
     uint64_t decaps_median = timings[timings_len / 2];
 
+    // Benchmark Decaps of invalid ciphertexts, i.e. the rejection path an attacker or a bad link can force
+    printf("\nPhase 4: Invalid Decapsulation:\n");
+    uint64_t invalid_medians[INVALID_KINDS];
+    unsigned char ss_valid[CRYPTO_BYTES];
+    memcpy(ss_valid, ss, CRYPTO_BYTES);
+    for (invalid_kind_t kind = 0; kind < INVALID_KINDS; kind++) {
+        make_invalid(kind);
+
+        // KEMs with implicit rejection return a pseudorandom secret, the others fail outright.
+        // X25519 ignores the top bit of a point, so one of its bit flips keeps the valid secret.
+        int errors = 0, unchanged = 0;
+        for (size_t i = 0; i < INVALID_CIPHERTEXTS; i++) {
+            if (crypto_kem_dec(ss_check, invalid_ct + i * CRYPTO_CIPHERTEXTBYTES, sk) != 0)
+                errors++;
+            else
+                unchanged += memcmp(ss_valid, ss_check, CRYPTO_BYTES) == 0;
+        }
+
+        benchmark(dec_invalid, timings, WARMUP_ITERATIONS, MEASUREMENT_ITERATIONS);
+        timings_len = remove_outliers(timings, MEASUREMENT_ITERATIONS, OUTLIER_PERCENTAGE);
+        print_distribution(invalid_labels[kind], timings, timings_len);
+        printf("  Outcome:    %7d errors, %d valid secrets, %d other secrets (of %d)\n",
+            errors, unchanged, INVALID_CIPHERTEXTS - errors - unchanged, INVALID_CIPHERTEXTS);
+        invalid_medians[kind] = timings[timings_len / 2];
+    }
+
     // Summary
     printf("\n=====================================\n");
     printf("SUMMARY (Median Times)\n");
@@ -139,11 +204,31 @@ int main(int argc, char** argv) {
     printf("Encapsulation:    %7d ns\n", encaps_median);
     printf("Decapsulation:    %7d ns\n", decaps_median);
     printf("Total Handshake:  %7d ns (Encaps + Decaps)\n", encaps_median + decaps_median);
+    printf("Encaps p90/p99:   %7d / %d ns (untrimmed)\n", encaps_p90, encaps_p99);
+    printf("Decaps p90/p99:   %7d / %d ns (untrimmed)\n", decaps_p90, decaps_p99);
+    for (invalid_kind_t kind = 0; kind < INVALID_KINDS; kind++)
+        printf("%-18s%7d ns (%.2fx valid)\n", invalid_labels[kind], invalid_medians[kind], (double)invalid_medians[kind] / decaps_median);
+    printf("=====================================\n");
+
+    // Memory per call (peak stack by painting, heap through the malloc wrappers in footprint.c)
+    footprint_t keygen_footprint, encaps_footprint, decaps_footprint;
+    footprint_measure(keygen, &keygen_footprint);
+    footprint_measure(enc, &encaps_footprint);
+    footprint_measure(dec, &decaps_footprint);
+
+    printf("MEMORY (Per Call)\n");
+    printf("=====================================\n");
+    print_footprint("KeyGen:", &keygen_footprint);
+    print_footprint("Encapsulation:", &encaps_footprint);
+    print_footprint("Decapsulation:", &decaps_footprint);
+    printf("Static .data:   %7zu B\n", footprint_static_data());
+    printf("Static .bss:    %7zu B\n", footprint_static_bss());
+    printf("Thread-local:   %7zu B per thread\n", footprint_static_tls());
     printf("=====================================\n");
 
     // CSV output to stderr for collection
-    fprintf(stderr, "%s,%7d,%7d,%7d,%7d,%7d,%7d,%.2f\n",
-        CRYPTO_ALGNAME,
+    fprintf(stderr, "%s,%7d,%7d,%7d,%7d,%7d,%7d,%.2f",
+        KEM_NAME,
         CRYPTO_PUBLICKEYBYTES,
         CRYPTO_SECRETKEYBYTES,
         CRYPTO_CIPHERTEXTBYTES,
@@ -152,6 +237,18 @@ int main(int argc, char** argv) {
         encaps_median + decaps_median,
         1000000.f / (float)(encaps_median + decaps_median)
     );
+    const footprint_t* footprints[] = { &keygen_footprint, &encaps_footprint, &decaps_footprint };
+    for (size_t i = 0; i < sizeof(footprints) / sizeof(*footprints); i++)
+        fprintf(stderr, ",%7zu,%5zu,%7zu,%7zu",
+            footprints[i]->stack_bytes,
+            footprints[i]->heap_allocations,
+            footprints[i]->heap_bytes,
+            footprints[i]->heap_peak_bytes
+        );
+    fprintf(stderr, ",%7zu,%7zu,%7zu", footprint_static_data(), footprint_static_bss(), footprint_static_tls());
+    for (invalid_kind_t kind = 0; kind < INVALID_KINDS; kind++)
+        fprintf(stderr, ",%7d", invalid_medians[kind]);
+    fprintf(stderr, ",%7d,%7d,%7d,%7d\n", encaps_p90, encaps_p99, decaps_p90, decaps_p99);
 
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,377 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+
+// Model defaults
+#define DEFAULT_BANDWIDTH_MBPS 100.0
+#define DEFAULT_RTT_MS 50.0
+#define DEFAULT_MTU 1500
+#define DEFAULT_INITCWND 10
+#define DEFAULT_LOSS 0.0
+#define DEFAULT_RTO_MIN_MS 200.0
+#define DEFAULT_BASELINE "ECDH-256"
+#define DEFAULT_POINTS 25
+#define TCPIP_HEADER_BYTES 40
+#define FAST_RETRANSMIT_DUPACKS 3
+#define BISECT_STEPS 60
+#define MAX_ALGORITHMS 256
+#define MAX_COLUMNS 64
+
+// CPU time percentiles the model can use. The median is a fixed column, the tails
+// are looked up by name since only results.csv has them (interleaved.csv does not)
+typedef enum { PERCENTILE_P50, PERCENTILE_P90, PERCENTILE_P99, PERCENTILES } percentile_t;
+static const int percentile_values[] = { 50, 90, 99 };
+static const char* percentile_columns[][2] = {
+    { NULL, NULL },
+    { "Encapsulation p90 (ns)", "Decapsulation p90 (ns)" },
+    { "Encapsulation p99 (ns)", "Decapsulation p99 (ns)" },
+};
+
+// One results.csv row: sizes in bytes, CPU times in ns
+typedef struct {
+    char name[64];
+    size_t public_key_bytes;
+    size_t ciphertext_bytes;
+    double encaps_ns; // the percentile selected with -q, the median by default
+    double decaps_ns;
+} algorithm_t;
+
+typedef struct {
+    double bandwidth_mbps;
+    double rtt_ms;
+    size_t mtu;
+    size_t initcwnd;
+    double loss;
+    double rto_min_ms;
+} link_t;
+
+// Breakdown of one modelled handshake, in ms
+typedef struct {
+    double cpu;
+    double propagation;
+    double serialization;
+    double slow_start;
+    double loss;
+    double total;
+} handshake_t;
+
+typedef enum { SWEEP_BANDWIDTH, SWEEP_RTT, SWEEP_LOSS } sweep_t;
+static const char* sweep_labels[] = { "Bandwidth (Mbit/s)", "RTT (ms)", "Loss" };
+
+/**
+ * @brief Models one direction of the handshake, a single message of the given size.
+ *
+ * The message is cut into MSS-sized segments. The first flight carries
+ * initcwnd of them and the window doubles every round trip (slow start), so
+ * each extra flight costs one RTT. Losses are taken one at a time: a lost
+ * segment followed by at least FAST_RETRANSMIT_DUPACKS others is recovered by
+ * fast retransmit after about one RTT, a lost tail segment waits for the
+ * retransmission timeout. The expected cost is summed over segments, which
+ * holds for loss rates well below 1/segments.
+ */
+static void model_flight(const link_t* link, size_t bytes, handshake_t* handshake) {
+    size_t mss = link->mtu - TCPIP_HEADER_BYTES;
+    size_t segments = (bytes + mss - 1) / mss;
+
+    // Extra round trips before the window covers every segment
+    size_t rounds = 0;
+    for (size_t sent = link->initcwnd, window = link->initcwnd; sent < segments; rounds++) {
+        window *= 2;
+        sent += window;
+    }
+
+    double wire_bits = 8.0 * (bytes + segments * TCPIP_HEADER_BYTES);
+    double rto_ms = link->rto_min_ms + link->rtt_ms;
+    double loss_ms = 0;
+    for (size_t i = 0; i < segments; i++)
+        loss_ms += link->loss * (segments - 1 - i >= FAST_RETRANSMIT_DUPACKS ? link->rtt_ms : rto_ms);
+
+    handshake->propagation += link->rtt_ms / 2;
+    handshake->serialization += wire_bits / (link->bandwidth_mbps * 1000.0);
+    handshake->slow_start += rounds * link->rtt_ms;
+    handshake->loss += loss_ms;
+}
+
+/**
+ * @brief Models a 1-RTT KEM handshake: pk to the server, encapsulation, ct back, decapsulation.
+ *
+ * Key generation is left out, as in the Handshake column of results.csv,
+ * because ephemeral keys can be generated ahead of time.
+ */
+static handshake_t model_handshake(const link_t* link, const algorithm_t* alg) {
+    handshake_t handshake = { .cpu = (alg->encaps_ns + alg->decaps_ns) / 1e6 };
+    model_flight(link, alg->public_key_bytes, &handshake);
+    model_flight(link, alg->ciphertext_bytes, &handshake);
+    handshake.total = handshake.cpu + handshake.propagation + handshake.serialization + handshake.slow_start + handshake.loss;
+    return handshake;
+}
+
+static void link_set(link_t* link, sweep_t sweep, double value) {
+    switch (sweep) {
+    case SWEEP_BANDWIDTH: link->bandwidth_mbps = value; break;
+    case SWEEP_RTT: link->rtt_ms = value; break;
+    case SWEEP_LOSS: link->loss = value; break;
+    }
+}
+
+// Bandwidth and loss span decades, so they are swept on a log scale
+static double sweep_point(sweep_t sweep, double from, double to, size_t i, size_t points) {
+    double t = points > 1 ? (double)i / (points - 1) : 0;
+    if (sweep == SWEEP_RTT)
+        return from + t * (to - from);
+    return exp(log(from) + t * (log(to) - log(from)));
+}
+
+static double handshake_delta(link_t link, sweep_t sweep, double value, const algorithm_t* alg, const algorithm_t* baseline) {
+    link_set(&link, sweep, value);
+    return model_handshake(&link, alg).total - model_handshake(&link, baseline).total;
+}
+
+/**
+ * @brief Splits a CSV line in place at commas, dropping quotes and the line ending.
+ *
+ * @return Number of fields.
+ */
+static size_t split_csv(char* line, char** fields, size_t fields_cap) {
+    line[strcspn(line, "\r\n")] = '\0';
+    size_t fields_len = 0;
+    for (char* field = line; field != NULL && fields_len < fields_cap; ) {
+        char* next = strchr(field, ',');
+        if (next != NULL)
+            *next++ = '\0';
+        if (field[0] == '"' && field[strlen(field) - 1] == '"') {
+            field[strlen(field) - 1] = '\0';
+            field++;
+        }
+        fields[fields_len++] = field;
+        field = next;
+    }
+    return fields_len;
+}
+
+/**
+ * @brief Reads results.csv (or interleaved.csv), taking encapsulation and decapsulation
+ * times at the given percentile.
+ *
+ * @return Number of algorithms read, -1 if the file cannot be opened, or -2 if it has
+ * no columns for that percentile.
+ */
+static int read_results(const char* path, percentile_t percentile, algorithm_t* algorithms, size_t algorithms_cap) {
+    FILE* file = fopen(path, "r");
+    if (file == NULL)
+        return -1;
+
+    // Header, for the tail columns
+    char line[1024];
+    char* fields[MAX_COLUMNS];
+    size_t encaps_column = 4, decaps_column = 5;
+    if (percentile != PERCENTILE_P50) {
+        encaps_column = decaps_column = 0;
+        size_t fields_len = fgets(line, sizeof(line), file) != NULL ? split_csv(line, fields, MAX_COLUMNS) : 0;
+        for (size_t i = 0; i < fields_len; i++) {
+            if (strcmp(fields[i], percentile_columns[percentile][0]) == 0)
+                encaps_column = i;
+            if (strcmp(fields[i], percentile_columns[percentile][1]) == 0)
+                decaps_column = i;
+        }
+        if (encaps_column == 0 || decaps_column == 0) {
+            fclose(file);
+            return -2;
+        }
+    }
+
+    size_t algorithms_len = 0;
+    while (algorithms_len < algorithms_cap && fgets(line, sizeof(line), file) != NULL) {
+        algorithm_t* alg = &algorithms[algorithms_len];
+        size_t fields_len = split_csv(line, fields, MAX_COLUMNS);
+        char* end;
+        if (fields_len <= encaps_column || fields_len <= decaps_column)
+            continue;
+        snprintf(alg->name, sizeof(alg->name), "%s", fields[0]);
+        alg->public_key_bytes = strtoul(fields[1], &end, 10);
+        if (end == fields[1])
+            continue; // the header, when it was not read above
+        alg->ciphertext_bytes = strtoul(fields[3], NULL, 10);
+        alg->encaps_ns = strtod(fields[encaps_column], NULL);
+        alg->decaps_ns = strtod(fields[decaps_column], NULL);
+        algorithms_len++;
+    }
+
+    fclose(file);
+    return algorithms_len;
+}
+
+/**
+ * @brief Turns measured CPU times and wire sizes into modelled handshake latency.
+ *
+ * Prints the latency breakdown of every algorithm at the given link, then
+ * sweeps one link parameter, printing the latency curves (CSV on stderr) and
+ * where each algorithm breaks even with the baseline, i.e. where its curve
+ * crosses the baseline's.
+ *
+ * -q 90 or -q 99 models the CPU time at that percentile instead of the median,
+ * from the untrimmed tail columns of results.csv.
+ *
+ * Usage: ./netmodel [-b Mbit/s] [-r RTT ms] [-m MTU] [-i initcwnd] [-l loss] [-o min RTO ms] [-q 50|90|99]
+ *                   [-e baseline] [-s bandwidth|rtt|loss] [-f from] [-t to] [-n points] [results.csv]
+ */
+int main(int argc, char** argv) {
+    link_t link = { DEFAULT_BANDWIDTH_MBPS, DEFAULT_RTT_MS, DEFAULT_MTU, DEFAULT_INITCWND, DEFAULT_LOSS, DEFAULT_RTO_MIN_MS };
+    const char* baseline_name = DEFAULT_BASELINE;
+    sweep_t sweep = SWEEP_BANDWIDTH;
+    percentile_t percentile = PERCENTILE_P50;
+    double from = NAN, to = NAN;
+    size_t points = DEFAULT_POINTS;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "b:r:m:i:l:o:q:e:s:f:t:n:")) != -1) {
+        switch (opt) {
+        case 'b': link.bandwidth_mbps = atof(optarg); break;
+        case 'r': link.rtt_ms = atof(optarg); break;
+        case 'm': link.mtu = atol(optarg); break;
+        case 'i': link.initcwnd = atol(optarg); break;
+        case 'l': link.loss = atof(optarg); break;
+        case 'o': link.rto_min_ms = atof(optarg); break;
+        case 'q':
+            for (percentile = 0; percentile < PERCENTILES && percentile_values[percentile] != atoi(optarg); percentile++)
+                ;
+            if (percentile == PERCENTILES) {
+                fprintf(stderr, "-q must be 50, 90 or 99\n");
+                return -1;
+            }
+            break;
+        case 'e': baseline_name = optarg; break;
+        case 's': sweep = strcmp(optarg, "rtt") == 0 ? SWEEP_RTT : strcmp(optarg, "loss") == 0 ? SWEEP_LOSS : SWEEP_BANDWIDTH; break;
+        case 'f': from = atof(optarg); break;
+        case 't': to = atof(optarg); break;
+        case 'n': points = atol(optarg); break;
+        default:
+            fprintf(stderr, "Usage: %s [-b Mbit/s] [-r RTT ms] [-m MTU] [-i initcwnd] [-l loss] [-o min RTO ms] [-q 50|90|99] "
+                "[-e baseline] [-s bandwidth|rtt|loss] [-f from] [-t to] [-n points] [results.csv]\n", argv[0]);
+            return -1;
+        }
+    }
+    if (link.mtu <= TCPIP_HEADER_BYTES || link.initcwnd == 0 || link.bandwidth_mbps <= 0 || points == 0) {
+        fprintf(stderr, "MTU must exceed %d bytes, initcwnd, bandwidth and points must be positive\n", TCPIP_HEADER_BYTES);
+        return -1;
+    }
+
+    // Default sweep ranges, for whichever end was not given
+    static const double default_from[] = { 0.1, 1, 0.0001 };
+    static const double default_to[] = { 10000, 300, 0.1 };
+    if (isnan(from))
+        from = default_from[sweep];
+    if (isnan(to))
+        to = default_to[sweep];
+
+    // Bandwidth and loss are swept on a log scale, which has no 0. A bandwidth of 0
+    // would also never deliver the message, and RTT can't be negative
+    if (sweep != SWEEP_RTT && (from <= 0 || to <= 0)) {
+        fprintf(stderr, "%s sweeps are on a log scale, -f and -t must be positive\n", sweep_labels[sweep]);
+        return -1;
+    }
+    if (sweep == SWEEP_RTT && (from < 0 || to < 0)) {
+        fprintf(stderr, "RTT sweeps need -f and -t of at least 0\n");
+        return -1;
+    }
+
+    static algorithm_t algorithms[MAX_ALGORITHMS];
+    const char* path = optind < argc ? argv[optind] : "output/results.csv";
+    int algorithms_len = read_results(path, percentile, algorithms, MAX_ALGORITHMS);
+    if (algorithms_len == -2) {
+        fprintf(stderr, "%s has no p%d columns (only results.csv has them)\n", path, percentile_values[percentile]);
+        return -1;
+    }
+    if (algorithms_len <= 0) {
+        fprintf(stderr, "No results in %s, run make test first\n", path);
+        return -1;
+    }
+
+    const algorithm_t* baseline = NULL;
+    for (int i = 0; i < algorithms_len; i++)
+        if (strcasecmp(algorithms[i].name, baseline_name) == 0)
+            baseline = &algorithms[i];
+    if (baseline == NULL) {
+        fprintf(stderr, "Baseline %s not found in %s\n", baseline_name, path);
+        return -1;
+    }
+
+    // Header and static data
+    printf("=====================================\n");
+    printf("PQC KEM Handshake Network Model\n");
+    printf("=====================================\n");
+    printf("Results:     %s\n", path);
+    printf("Bandwidth:   %10.2f Mbit/s\n", link.bandwidth_mbps);
+    printf("RTT:         %10.2f ms\n", link.rtt_ms);
+    printf("MTU:         %10zu bytes\n", link.mtu);
+    printf("initcwnd:    %10zu segments\n", link.initcwnd);
+    printf("Loss:        %10.4f%%\n", link.loss * 100);
+    printf("Min RTO:     %10.2f ms\n", link.rto_min_ms);
+    char percentile_label[8];
+    snprintf(percentile_label, sizeof(percentile_label), "p%d", percentile_values[percentile]);
+    printf("CPU time:    %10s\n", percentile_label);
+    printf("Baseline:    %s\n", baseline->name);
+    printf("=====================================\n\n");
+
+    // Breakdown at the given link
+    printf("%-24s %9s %9s %9s %9s %9s %9s %9s %10s\n",
+        "Algorithm (ms)", "CPU", "Prop", "Serial", "SlowStrt", "Loss", "Total", "vs base", "Segs pk/ct");
+    size_t mss = link.mtu - TCPIP_HEADER_BYTES;
+    double baseline_total = model_handshake(&link, baseline).total;
+    for (int i = 0; i < algorithms_len; i++) {
+        handshake_t h = model_handshake(&link, &algorithms[i]);
+        printf("%-24s %9.3f %9.3f %9.3f %9.3f %9.3f %9.3f %+9.3f %5zu/%-4zu\n",
+            algorithms[i].name, h.cpu, h.propagation, h.serialization, h.slow_start, h.loss, h.total,
+            h.total - baseline_total,
+            (algorithms[i].public_key_bytes + mss - 1) / mss, (algorithms[i].ciphertext_bytes + mss - 1) / mss);
+    }
+
+    // Latency curves, CSV to stderr for plotting
+    fprintf(stderr, "Algorithm,\"%s\",\"Handshake (ms)\"\n", sweep_labels[sweep]);
+    for (int i = 0; i < algorithms_len; i++) {
+        for (size_t p = 0; p < points; p++) {
+            link_t point = link;
+            double value = sweep_point(sweep, from, to, p, points);
+            link_set(&point, sweep, value);
+            fprintf(stderr, "%s,%g,%.4f\n", algorithms[i].name, value, model_handshake(&point, &algorithms[i]).total);
+        }
+    }
+
+    // Break-even points: sign changes of (algorithm - baseline) along the sweep, refined by bisection
+    printf("\nBreak-even with %s over %s %g..%g:\n", baseline->name, sweep_labels[sweep], from, to);
+    for (int i = 0; i < algorithms_len; i++) {
+        if (&algorithms[i] == baseline)
+            continue;
+
+        printf("  %-24s", algorithms[i].name);
+        int crossings = 0;
+        double previous = sweep_point(sweep, from, to, 0, points);
+        double previous_delta = handshake_delta(link, sweep, previous, &algorithms[i], baseline);
+        for (size_t p = 1; p < points; p++) {
+            double value = sweep_point(sweep, from, to, p, points);
+            double delta = handshake_delta(link, sweep, value, &algorithms[i], baseline);
+            if ((previous_delta < 0) != (delta < 0)) {
+                double low = previous, high = value;
+                for (int step = 0; step < BISECT_STEPS; step++) {
+                    double mid = (low + high) / 2;
+                    if ((handshake_delta(link, sweep, mid, &algorithms[i], baseline) < 0) == (previous_delta < 0))
+                        low = mid;
+                    else
+                        high = mid;
+                }
+                printf(" %s above %g", delta < 0 ? "faster" : "slower", high);
+                crossings++;
+            }
+            previous = value;
+            previous_delta = delta;
+        }
+        if (crossings == 0)
+            printf(" %s over the whole range", previous_delta < 0 ? "faster" : "slower");
+        printf("\n");
+    }
+
+    return 0;
+}